@@ -0,0 +1,26 @@
+/**
+* PaletteSpritePS.hlsl
+*
+* t0: 8rbg̃CfbNXeNX`(R8_UNORM).
+* t1: pbgeNX`. 256ŁA1s1̃pbgɑΉ.
+*/
+Texture2D<float> t0 : register(t0);
+Texture2D<float4> t1 : register(t1);
+
+struct PSInput
+{
+	float4 position : SV_POSITION;
+	float4 color : COLOR;
+	float2 texcoord : TEXCOORD;
+	nointerpolation uint palette : PALETTE;
+};
+
+float4 main(PSInput input) : SV_TARGET
+{
+	// CfbNX͕ԂłȂ̂ŁAł߂eNZ𒼐ړǂݍ.
+	uint width, height;
+	t0.GetDimensions(width, height);
+	const int2 texel = int2(input.texcoord * float2(width, height));
+	const uint index = (uint)(t0.Load(int3(texel, 0)) * 255.0f + 0.5f);
+	return t1.Load(int3(index, input.palette, 0)) * input.color;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+/**
+* PaletteSpriteVS.hlsl
+*/
+
+struct PSInput
+{
+	float4 position : SV_POSITION;
+	float4 color : COLOR;
+	float2 texcoord : TEXCOORD;
+	nointerpolation uint palette : PALETTE;
+};
+
+cbuffer RootConstants : register(b0)
+{
+	float4x4 matViewProjection;
+};
+
+PSInput main(float3 pos : POSITION, float4 color : COLOR, float2 texcoord : TEXCOORD)
+{
+	// texcoord.x̐ɂ́Apbgԍ2{ZĂ(Sprite::EncodePaletteTexcoordQ).
+	const float palette = floor(texcoord.x * 0.5f);
+
+	PSInput input;
+	input.position = mul(float4(pos, 1.0f), matViewProjection);
+	input.color = color;
+	input.texcoord = float2(texcoord.x - palette * 2.0f, texcoord.y);
+	input.palette = (uint)palette;
+	return input;
+}
\ No newline at end of file
@@ -8,9 +8,15 @@
 */
 #include "Action.h"
 #include "Json.h"
-#include "Sprite.h"
+#include "File.h"
+#include "Platform.h"
+#include "SpriteCore.h"
 #include "DXMathHelper.h"
+#include "DebugHelper.h"
 #include <algorithm>
+#include <functional>
+#include <math.h>
+#include <stdio.h>
 
 using namespace DirectX;
 
@@ -18,10 +24,10 @@ namespace Action {
 
 namespace B {
 
-#ifndef ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON
+/// Le[u쐬́A1Ԃ̒̌v.
 const size_t separationCount = 10;
+/// Le[u쐬́AȐ̋ԕ.
 const size_t sectionCount = 32;
-#endif ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON
 
 /**
 * 3xWFȐ.
@@ -178,6 +184,7 @@ float XM_CALLCONV CalcBezierLengthSimpson(Bezier3 bezier, float t0, float t1, si
 }
 #endif // ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON
 
+#ifdef ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON
 /**
 * ɑΉt̒l߂.
 *
@@ -227,11 +234,149 @@ std::vector<BezierSection> XM_CALLCONV CreateSectionList(Bezier3 bezier, size_t
 	buf.push_back({ 1, 0 });
 	return buf;
 }
+#endif // ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON
+
+/**
+* xWFȐ𓙕AeԂ̎n_tƋԂ̒PtvZ.
+*
+* @param bezier 3xWFȐ.
+* @param count  .
+* @param n      1Ԃ̒̌v.
+* @param length Ȑ̒i[ϐ.
+*
+* @return tƒPʋɑ΂t̑̃Xg.
+*
+* Ȑcount * n̐ŋߎݐϒe[uAtĊeԂ̎n_t߂.
+* j[g@̂悤ɒJԂvƂ͂Ȃ߁AvZʂcount * nɔႷ.
+*/
+std::vector<BezierSection> XM_CALLCONV CreateSectionListFromLengthTable(Bezier3 bezier, size_t count, size_t n, float& length)
+{
+	const size_t sampleCount = count * n;
+	std::vector<float> lengthTable;
+	lengthTable.reserve(sampleCount + 1);
+	lengthTable.push_back(0);
+	XMVECTOR current = CalcBezier(bezier, 0);
+	for (size_t i = 1; i <= sampleCount; ++i) {
+		const XMVECTOR next = CalcBezier(bezier, static_cast<float>(i) / static_cast<float>(sampleCount));
+		lengthTable.push_back(lengthTable.back() + XMVectorGetX(XMVector2Length(next - current)));
+		current = next;
+	}
+	length = lengthTable.back();
+
+	std::vector<BezierSection> buf;
+	buf.reserve(count + 1);
+	buf.push_back({ 0, 0 });
+	const float section = length / static_cast<float>(count);
+	size_t j = 0;
+	for (size_t i = 1; i < count; ++i) {
+		const float d = static_cast<float>(i) * section;
+		while (j + 1 < sampleCount && lengthTable[j + 1] < d) {
+			++j;
+		}
+		const float segment = lengthTable[j + 1] - lengthTable[j];
+		const float ratio = segment > 0 ? (d - lengthTable[j]) / segment : 0.0f;
+		const float t = (static_cast<float>(j) + ratio) / static_cast<float>(sampleCount);
+		buf.back().unitT = (t - buf.back().t) / section;
+		buf.push_back({ t, 0 });
+	}
+	buf.back().unitT = (1 - buf.back().t) / section;
+	buf.push_back({ 1, 0 });
+	return buf;
+}
+
+/**
+* ړp^[Ɋ܂܂xWFȐ̌ʒe[u쐬.
+*
+* @param pattern e[u쐬ړp^[.
+*
+* Ȑ̌`́Ap^[̊W猩n_̈ʒu3̐_Ō܂.
+* n_̈ʒu͒O̖߂̖ڕWWȂ̂ŁAp^[擪HΎsOɋ߂.
+* 쐬e[upattern.arcTableListɁABezier߂̏oɊi[.
+*/
+void BuildBezierArcTable(Pattern& pattern)
+{
+	pattern.arcTableList.clear();
+	XMFLOAT2 offset(0, 0);
+	for (size_t i = 0; i < pattern.data.size();) {
+		const Code* pCode = pattern.data.data() + i;
+		switch (pCode[0].opcode) {
+		case Type::Move:
+			offset = XMFLOAT2(pCode[1].operand, pCode[2].operand);
+			i += 4;
+			break;
+		case Type::Stop:
+			i += 2;
+			break;
+		case Type::Bezier: {
+			const Bezier3 bezier = {
+				XMVectorSet(offset.x, offset.y, 0, 0),
+				XMVectorSet(pCode[1].operand, pCode[2].operand, 0, 0),
+				XMVectorSet(pCode[3].operand, pCode[4].operand, 0, 0),
+				XMVectorSet(pCode[5].operand, pCode[6].operand, 0, 0)
+			};
+			BezierArcTable table;
+			table.startOffset = offset;
+			table.sectionList = CreateSectionListFromLengthTable(bezier, sectionCount, separationCount, table.totalLength);
+			pattern.arcTableList.push_back(std::move(table));
+			offset = XMFLOAT2(pCode[5].operand, pCode[6].operand);
+			i += 8;
+			break;
+		}
+		default:
+			return;
+		}
+	}
+}
+
+/**
+* Ľʒe[u擾.
+*
+* @param pattern ړp^[.
+* @param index   擾e[ũCfbNX.
+* @param offset  W猩Aۂ̎n_̈ʒu.
+*
+* @return indexԖڂ̃e[uւ̃|C^.
+*         e[u݂ȂA܂͎n_̈ʒuvȂꍇnullptr.
+*
+* Restart()ōĎsꍇȂǁAn_̈ʒu쐬̑zƈقȂꍇ͋Ȑ̌`قȂ邽߁A
+* e[ugƂ͂łȂ.
+*/
+const BezierArcTable* XM_CALLCONV FindBezierArcTable(const Pattern& pattern, size_t index, FXMVECTOR offset)
+{
+	if (index >= pattern.arcTableList.size()) {
+		return nullptr;
+	}
+	const BezierArcTable& table = pattern.arcTableList[index];
+	const XMVECTOR epsilon = XMVectorReplicate(0.01f);
+	if (!XMVector2NearEqual(XMLoadFloat2(&table.startOffset), offset, epsilon)) {
+		return nullptr;
+	}
+	return &table;
+}
+
+/**
+* ԃXggāAn_̋̔䗦ɑΉWvZ.
+*
+* @param bezier   3xWFȐ.
+* @param sections ԃXg.
+* @param length   Ȑ̒.
+* @param ratio    n_̋̔䗦(0ȏ1).
+*
+* @return ratioɑΉW.
+*/
+XMVECTOR XM_CALLCONV CalcBezierBySection(Bezier3 bezier, const std::vector<BezierSection>& sections, float length, float ratio)
+{
+	const size_t count = sections.size() - 1;
+	const size_t index = static_cast<size_t>(ratio * count);
+	const float d = ratio * length;
+	const float rd = d - static_cast<float>(index) * length * (1.0f / count);
+	return CalcBezier(bezier, sections[index].t + rd * sections[index].unitT);
+}
 
 /**
 * RXgN^.
 */
-Controller::Controller() : pattern(nullptr)
+Controller::Controller() : pattern(nullptr), arcTable(nullptr)
 {
 }
 
@@ -245,6 +390,20 @@ void Controller::SetPattern(const Pattern* p)
 	pattern = p;
 	codeCounter = 0;
 	time = 0;
+	arcTableIndex = 0;
+	arcTable = nullptr;
+	sectionList.clear();
+}
+
+/**
+* ړp^[ŏĎs.
+*/
+void Controller::Restart()
+{
+	codeCounter = 0;
+	arcTableIndex = 0;
+	arcTable = nullptr;
+	sectionList.clear();
 }
 
 /**
@@ -299,20 +458,26 @@ void Controller::Update(Sprite::Sprite& sprite, double delta)
 		if (time < totalTime) {
 #if 1
 			const Bezier3 bezier = { startPos, pos1, pos2, pos3 };
-			if (sectionList.empty()) {
+			if (!arcTable && sectionList.empty()) {
 #ifdef ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON
-				const LengthFuncType lengthFunc = useSimpsonsRule ? CalcBezierLengthSimpson : CalcBezierLengthLinear;
+				if (useSharedTable) {
+					arcTable = FindBezierArcTable(*pattern, arcTableIndex, XMVectorSubtract(startPos, basePos));
+				}
+				if (!arcTable) {
+					const LengthFuncType lengthFunc = useSimpsonsRule ? CalcBezierLengthSimpson : CalcBezierLengthLinear;
+					totalLength = lengthFunc(bezier, 0, 1, separationCount);
+					sectionList = CreateSectionList(bezier, sectionCount, separationCount, lengthFunc);
+				}
 #else
-				const LengthFuncType lengthFunc = CalcBezierLengthLinear;
+				arcTable = FindBezierArcTable(*pattern, arcTableIndex, XMVectorSubtract(startPos, basePos));
+				if (!arcTable) {
+					sectionList = CreateSectionListFromLengthTable(bezier, sectionCount, separationCount, totalLength);
+				}
 #endif // ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON
-				totalLength = lengthFunc(bezier, 0, 1, separationCount);
-				sectionList = CreateSectionList(bezier, sectionCount, separationCount, lengthFunc);
 			}
-			const float ratio = static_cast<float>(time) / totalTime;
-			const size_t index = static_cast<size_t>(ratio * sectionCount);
-			const float d = ratio * totalLength;
-			const float rd = d - static_cast<float>(index) * totalLength * (1.0f / sectionCount);
-			const XMVECTOR p = CalcBezier(bezier, sectionList[index].t + rd * sectionList[index].unitT);
+			const std::vector<BezierSection>& sections = arcTable ? arcTable->sectionList : sectionList;
+			const float length = arcTable ? arcTable->totalLength : totalLength;
+			const XMVECTOR p = CalcBezierBySection(bezier, sections, length, static_cast<float>(time) / totalTime);
 			XMStoreFloat3(&sprite.pos, p);
 #else
 //			const XMVECTOR p = CalcBezier(startPos, pos1, pos2, pos3, time / totalTime);
@@ -323,6 +488,8 @@ void Controller::Update(Sprite::Sprite& sprite, double delta)
 			startPos = pos3;
 			codeCounter += 8;
 			time = 0;
+			++arcTableIndex;
+			arcTable = nullptr;
 			sectionList.clear();
 		}
 		break;
@@ -457,9 +624,160 @@ PatternList CreateDefaultPatternList()
 	ptnList[5].data.push_back(Code(-100));
 	ptnList[5].data.push_back(Code(300));
 
+	for (Pattern& e : ptnList) {
+		BuildBezierArcTable(e);
+	}
 	return ptnList;
 }
 
+#if defined(ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON) && defined(ACTION_ENABLE_SECTIONING_BENCHMARK)
+/**
+* @̖O擾.
+*
+* @param method @.
+*
+* @return method̖O.
+*/
+const char* GetSectioningMethodName(SectioningMethod method)
+{
+	switch (method) {
+	case SectioningMethod::NewtonLinear: return "NewtonLinear";
+	case SectioningMethod::NewtonSimpson: return "NewtonSimpson";
+	case SectioningMethod::LengthTable: return "LengthTable";
+	default: return "Unknown";
+	}
+}
+
+/**
+* xWFȐ̕@Ƃ̏ԂƐxr.
+*
+* _ɐcurveCount̋Ȑɑ΂āASĂ̕@ƕ̑gݍ킹ŋԃXg쐬A
+* 1Ȑ̍쐬ԂƁA1Tv̍WvZԂv.
+* x́A̔䗦𓙊ԊusampleCountςčWvZAׂ荇W̋
+* ̏ꍇ̋(\ׂċ߂Ȑ̒ / sampleCount)ǂꂾĂ邩ŕ].
+*
+* Vv\@͕łȂ΂ȂȂ߁AseparationCount͌vȂ.
+* ܂Aj[g@ԃXgꂽȐ́AxƍWvZԂ̏Wv珜A̐L^.
+*
+* @param sectionCounts    vԕ̃Xg.
+* @param separationCounts v钷̌ṽXg.
+* @param curveCount       Ȑ̐.
+* @param sampleCount      1Ȑ̍W̌vZ.
+* @param result           rʂi[ϐ.
+*/
+void CompareSectioningMethods(const std::vector<size_t>& sectionCounts, const std::vector<size_t>& separationCounts,
+	size_t curveCount, size_t sampleCount, std::vector<SectioningReport>& result)
+{
+	result.clear();
+	if (curveCount == 0 || sampleCount < 2) {
+		return;
+	}
+
+	std::vector<Bezier3> curveList(curveCount);
+	std::vector<float> referenceLength(curveCount);
+	DebugHelper::Random random;
+	for (size_t i = 0; i < curveCount; ++i) {
+		XMFLOAT2 points[4];
+		for (XMFLOAT2& p : points) {
+			p.x = random(0, 800);
+			p.y = random(0, 600);
+		}
+		curveList[i] = { XMLoadFloat2(&points[0]), XMLoadFloat2(&points[1]), XMLoadFloat2(&points[2]), XMLoadFloat2(&points[3]) };
+		referenceLength[i] = CalcBezierLengthLinear(curveList[i], 0, 1, 4096);
+	}
+
+	const SectioningMethod methodList[] = {
+		SectioningMethod::NewtonLinear, SectioningMethod::NewtonSimpson, SectioningMethod::LengthTable
+	};
+	std::vector<std::vector<BezierSection>> sectionLists(curveCount);
+	std::vector<float> lengthList(curveCount);
+	std::vector<XMFLOAT2> posList(sampleCount + 1);
+	for (SectioningMethod method : methodList) {
+		for (size_t sectionCount : sectionCounts) {
+			for (size_t separationCount : separationCounts) {
+				if (sectionCount == 0 || separationCount == 0) {
+					continue;
+				}
+				if (method == SectioningMethod::NewtonSimpson && (separationCount % 2)) {
+					continue;
+				}
+
+				const double buildTime = DebugHelper::Measure(1, [&]() {
+					for (size_t i = 0; i < curveCount; ++i) {
+						switch (method) {
+						case SectioningMethod::NewtonLinear:
+							lengthList[i] = CalcBezierLengthLinear(curveList[i], 0, 1, separationCount);
+							sectionLists[i] = CreateSectionList(curveList[i], sectionCount, separationCount, CalcBezierLengthLinear);
+							break;
+						case SectioningMethod::NewtonSimpson:
+							lengthList[i] = CalcBezierLengthSimpson(curveList[i], 0, 1, separationCount);
+							sectionLists[i] = CreateSectionList(curveList[i], sectionCount, separationCount, CalcBezierLengthSimpson);
+							break;
+						case SectioningMethod::LengthTable:
+							sectionLists[i] = CreateSectionListFromLengthTable(curveList[i], sectionCount, separationCount, lengthList[i]);
+							break;
+						}
+					}
+				});
+
+				SectioningReport report;
+				report.method = method;
+				report.sectionCount = sectionCount;
+				report.separationCount = separationCount;
+				report.buildTime = buildTime * 1000.0 / curveCount;
+				report.sampleTime = 0;
+				report.maxSpeedError = 0;
+				report.meanSpeedError = 0;
+				report.failedCurveCount = 0;
+				double totalError = 0;
+				for (size_t i = 0; i < curveCount; ++i) {
+					// j[g@UꍇAt͈͊O񐔂ɂȂ̂ŁA̋Ȑ͕]珜.
+					bool isValid = true;
+					for (size_t n = 1; n < sectionLists[i].size(); ++n) {
+						if (!(sectionLists[i][n].t >= sectionLists[i][n - 1].t && sectionLists[i][n].t <= 1.0f)) {
+							isValid = false;
+							break;
+						}
+					}
+					if (!isValid) {
+						++report.failedCurveCount;
+						continue;
+					}
+					report.sampleTime += DebugHelper::Measure(1, [&]() {
+						for (size_t n = 0; n < sampleCount; ++n) {
+							const float ratio = static_cast<float>(n) / static_cast<float>(sampleCount);
+							XMStoreFloat2(&posList[n], CalcBezierBySection(curveList[i], sectionLists[i], lengthList[i], ratio));
+						}
+					});
+					XMStoreFloat2(&posList[sampleCount], curveList[i].b3);
+
+					const float idealDistance = referenceLength[i] / static_cast<float>(sampleCount);
+					for (size_t n = 0; n < sampleCount; ++n) {
+						const XMVECTOR v = XMVectorSubtract(XMLoadFloat2(&posList[n + 1]), XMLoadFloat2(&posList[n]));
+						const float error = fabsf(XMVectorGetX(XMVector2Length(v)) / idealDistance - 1.0f);
+						report.maxSpeedError = std::max(report.maxSpeedError, error);
+						totalError += error;
+					}
+				}
+				const size_t validCount = curveCount - report.failedCurveCount;
+				if (validCount) {
+					report.sampleTime *= 1000000.0 / (validCount * sampleCount);
+					report.meanSpeedError = static_cast<float>(totalError / (validCount * sampleCount));
+				}
+				result.push_back(report);
+
+				char text[256];
+				snprintf(text, _countof(text), "%s section=%u separation=%u: build=%.2fus sample=%.1fns speed error max=%.4f mean=%.4f failed=%u\n",
+					GetSectioningMethodName(method), static_cast<uint32_t>(sectionCount), static_cast<uint32_t>(separationCount),
+					report.buildTime, report.sampleTime, report.maxSpeedError, report.meanSpeedError,
+					static_cast<uint32_t>(report.failedCurveCount));
+				Platform::DebugOutput(text);
+			}
+		}
+	}
+}
+#endif // ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON && ACTION_ENABLE_SECTIONING_BENCHMARK
+
 } // namespcee B
 
 /**
@@ -483,7 +801,7 @@ enum class Type
 *
 * ݖ.
 */
-enum InterporationType
+enum InterporationType : int
 {
 	InterporationType_Step,
 	InterporationType_Linear,
@@ -552,55 +870,226 @@ struct Data
 */
 typedef std::vector<Data> Sequence;
 
+/**
+* RpCς݂̃ANV.
+*
+* ANVf[^11ɑΉAsɕKvȒlOɌvZĂ.
+*/
+struct Instruction
+{
+	Type type; ///< ANV̎.
+	uint32_t next; ///< Path̏ꍇARg[|CgǂݏIʒu. ȊO͎g̈ʒu.
+	float time; ///< Wait, Path̓쎞.
+	XMFLOAT2 vec; ///< MovȇxAAccel̉x. Generationł(x, ).
+	int32_t index; ///< AnimatioñV[PXԍ. Path̃pXԍ.
+};
+
+/**
+* ANVV[PX̎ԋ.
+*
+* Wω(WaitPath)ƁA~̋(VanishingƃV[PXDatȁI[)Ƃɍ.
+* Ԃ̊Jn̏ԂێĂ̂ŁAԓ̔Cӂ̎̍WvZŋ߂邱Ƃł.
+*/
+struct Segment
+{
+	Type type; ///< Wait, Path, Vanishinĝꂩ. V[PX̏I[duration0Waitŕ\.
+	uint32_t pc; ///< Ԃ̖߂sController::dataIndex̒l.
+	float startTime; ///< V[PXJn̋Ԃ̊Jn.
+	float duration; ///< Ԃ̒.
+	bool isAbsolute; ///< pos΍WȂtrue. falseȂV[PXJn̍W̑΍W.
+	XMFLOAT2 pos; ///< ԊJn̍W.
+	XMFLOAT2 move; ///< ԊJn̑x.
+	XMFLOAT2 accel; ///< ԊJn̉x.
+	int32_t pathPc; ///< Path̏ꍇAPath߂̈ʒu. ȊO-1.
+	int32_t animationId; ///< ԊJn܂łɍŌɎw肳ꂽAj[Vԍ. w肪Ȃ-1.
+	int32_t generationPc; ///< ԊJn܂łɍŌɎsꂽGeneration߂̈ʒu. Ȃ-1.
+	bool operator<(float t) const { return startTime < t; }
+};
+bool operator<(float t, const Segment& s) { return t < s.startTime; }
+
+/**
+* OՂ̃L[t[.
+*/
+struct Keyframe
+{
+	float t; ///< V[PXJn̎.
+	XMFLOAT2 pos; ///< W.
+	float originWeight; ///< Jn̍WɊ|W. ΍WȂ1, ΍WȂ0.
+};
+
+/**
+* OՏ̃Cxg.
+*/
+struct TrackEvent
+{
+	float t; ///< V[PXJn̎.
+	Type type; ///< AnimationGeneration.
+	int32_t index; ///< AnimationȂAj[Vԍ. GenerationȂ疽߂̈ʒu.
+};
+
+/**
+* Oɍ쐬O.
+*
+* Controller::UseTrack()LɂRg[[́AANVsɂ̃f[^QƂ.
+* ړƃpX̓L[t[Ԃ̐`ԂŐmɍČł̂ŁAԂ̗[ƃpX̓_i[.
+* x̂ړtrackSampleRate̊ԊuŃTvO.
+* uԈړʒuł͓̃L[t[2uAԂŐԂ܂Ȃ悤ɂ.
+*/
+struct Track
+{
+	std::vector<Keyframe> keyList; ///< ̃L[t[̔z.
+	std::vector<TrackEvent> eventList; ///< ̃Cxg̔z.
+	float vanishTime; ///< ł鎞. łȂΕ.
+};
+
+/// OՂ쐬ۂ́Ax̂ړ̃TvOg(Hz).
+const float trackSampleRate = 60.0f;
+
+/**
+* RpCς݂̃ANVV[PX.
+*/
+struct Program
+{
+	std::vector<Instruction> code; ///< ߂̔z.
+	std::vector<std::vector<Point>> pathList; ///< Path߂QƂpX̔z. (Xg, V[PX, )Ƃ1.
+	std::vector<Segment> timeline; ///< ̋Ԃ̔z. Controller::Seek()ȂǂŎg.
+	Track track; ///< timeline쐬O.
+};
+
+/**
+* pX́Aoߎt܂ދԂ̏I_߂.
+*
+* oߎԂ͒ʏ푝Ȃ̂ŁAȌI_珇ɐi߂邾ōς.
+* oߎԂO߂Ăꍇ͓񕪒Tŋߒ.
+*
+* @param cp     pX.
+* @param t      pX̎n_̌oߎ.
+* @param cursor ŐԂ̏I_̃CfbNX. ̏I_̃CfbNXi[.
+*               I_Ȃ(tpX̏I[ȍ~)̏ꍇcp.size()ɂȂ.
+*/
+template<typename T>
+void FindPathSection(const std::vector<Point>& cp, float t, T& cursor)
+{
+	if (cursor > cp.size() || (cursor > 0 && cp[cursor - 1].t > t)) {
+		cursor = static_cast<T>(std::upper_bound(cp.begin(), cp.end(), Point{ {}, t }) - cp.begin());
+		return;
+	}
+	while (cursor < cp.size() && cp[cursor].t <= t) {
+		++cursor;
+	}
+}
+
 /**
 * ANVV[PX̃Xg.
 */
 struct List {
 	std::string name; ///< Xg.
 	std::vector<Sequence> list; ///< V[PX̔z.
+	std::vector<Program> programList; ///< listƓт̃RpCς݃V[PX.
 };
 bool operator<(const List& lhs, const List& rhs) { return lhs.name < rhs.name; }
 bool operator<(const List& lhs, const char* rhs) { return lhs.name.compare(rhs) < 0; }
 bool operator<(const char* lhs, const List& rhs) { return rhs.name.compare(lhs) > 0; }
 
+/// BSplineňő̎.
+const int bsplineMaxDegree = 7;
+
 /**
 * hEu[ÃASYɂBXvCW̐.
 *
-* @param k      ċAĂяo̐[x. degreeŊJnAċAďoɃfNg. 0ɂȂƂċA͏I.
-* @param degree .
-* @param i      WɎgpŏ̃Rg[|Cg̃CfbNX.
+* ċAg킸A+1̃Rg[|Cg珇ɒԓ_vZ.
+* ͈̔͂͌Ȃ̂ŁAĂяo0`bsplineMaxDegreeɎ܂Ă邱Ƃۏ؂邱.
+*
+* @param degree (0`bsplineMaxDegree).
 * @param x      Ẅʒu. ŏ̃Rg[|Cg0AŌ̃Rg[|CgNƂƂA
 *               0`N̒l.
 * @param points Rg[|Cg̔z.
 *
 * @return xɑΉBXvCJ[u̍W.
 */
-XMVECTOR DeBoorI(int k, int degree, int i, float x, const std::vector<XMFLOAT2>& points) {
-	if (k == 0) {
-		return XMLoadFloat2(&points[std::max(0, std::min<int>(i, points.size() - 1))]);
+XMVECTOR DeBoor(int degree, float x, const std::vector<XMFLOAT2>& points) {
+	const int i = static_cast<int>(x);
+	const int last = static_cast<int>(points.size()) - 1;
+	XMVECTOR d[bsplineMaxDegree + 1];
+	for (int j = 0; j <= degree; ++j) {
+		d[j] = XMLoadFloat2(&points[std::max(0, std::min(i - degree + j, last))]);
 	}
-	const float alpha = (x - static_cast<float>(i)) / static_cast<float>(degree + 1 - k);
-	const XMVECTOR a = DeBoorI(k - 1, degree, i - 1, x, points);
-	const XMVECTOR b = DeBoorI(k - 1, degree, i, x, points);
-	const XMVECTORF32 t{ alpha, (1.0f - alpha), 0.0f, 0.0f };
-	return XMVectorAdd(
-		XMVectorMultiply(a, XMVectorSwizzle(t, 1, 1, 1, 1)),
-		XMVectorMultiply(b, XMVectorSwizzle(t, 0, 0, 0, 0)));
+	for (int k = 1; k <= degree; ++k) {
+		for (int j = degree; j >= k; --j) {
+			const float alpha = (x - static_cast<float>(i - degree + j)) / static_cast<float>(degree + 1 - k);
+			const XMVECTORF32 t{ alpha, (1.0f - alpha), 0.0f, 0.0f };
+			d[j] = XMVectorAdd(
+				XMVectorMultiply(d[j - 1], XMVectorSwizzle(t, 1, 1, 1, 1)),
+				XMVectorMultiply(d[j], XMVectorSwizzle(t, 0, 0, 0, 0)));
+		}
+	}
+	return d[degree];
 }
 
 /**
-*hEu[ÃASYɂBXvCW̐.
+* hEu[ÃASYɂāÄʒuBXvCW܂Ƃ߂Đ.
 *
-* @param degree .
-* @param x      Ẅʒu. ŏ̃Rg[|Cg0AŌ̃Rg[|CgNƂƂA
-*               0`N̒l.
+* 4̈ʒu1gƂāAXWYWꂼ1̃xNgɂ܂Ƃ߂SIMDŌvZ.
+* 4ɖȂcDeBoor()ŌvZ.
+*
+* @param degree (0`bsplineMaxDegree).
+* @param xList  Ẅʒu̔z.
+* @param count  xList̗vf.
 * @param points Rg[|Cg̔z.
+* @param out    Wi[z. countȏ̗vfi[łȂ΂ȂȂ.
 *
-* @return xɑΉBXvCJ[u̍W.
+* @retval true  .
+* @retval false ͈͊O. out͕ύXȂ.
 */
-XMVECTOR DeBoor(int degree, float x, const std::vector<XMFLOAT2>& points) {
-	const int i = static_cast<int>(x);
-	return DeBoorI(degree, degree, i, x, points);
+bool DeBoorN(int degree, const float* xList, size_t count, const std::vector<XMFLOAT2>& points, XMFLOAT2* out) {
+	if (degree < 0 || degree > bsplineMaxDegree) {
+		char text[128];
+		snprintf(text, _countof(text), "BSpline: %d͈܂(ő%d)\n", degree, bsplineMaxDegree);
+		Platform::DebugOutput(text);
+		return false;
+	}
+	const int last = static_cast<int>(points.size()) - 1;
+	const XMVECTOR one = XMVectorReplicate(1.0f);
+	size_t n = 0;
+	for (; n + 4 <= count; n += 4) {
+		const int i[4] = {
+			static_cast<int>(xList[n]), static_cast<int>(xList[n + 1]), static_cast<int>(xList[n + 2]), static_cast<int>(xList[n + 3])
+		};
+		const XMVECTOR x = XMVectorSet(xList[n], xList[n + 1], xList[n + 2], xList[n + 3]);
+		XMVECTOR dx[bsplineMaxDegree + 1];
+		XMVECTOR dy[bsplineMaxDegree + 1];
+		for (int j = 0; j <= degree; ++j) {
+			const XMFLOAT2* p[4];
+			for (int lane = 0; lane < 4; ++lane) {
+				p[lane] = &points[std::max(0, std::min(i[lane] - degree + j, last))];
+			}
+			dx[j] = XMVectorSet(p[0]->x, p[1]->x, p[2]->x, p[3]->x);
+			dy[j] = XMVectorSet(p[0]->y, p[1]->y, p[2]->y, p[3]->y);
+		}
+		for (int k = 1; k <= degree; ++k) {
+			const XMVECTOR divisor = XMVectorReplicate(static_cast<float>(degree + 1 - k));
+			for (int j = degree; j >= k; --j) {
+				const int r = j - degree;
+				const XMVECTOR knot = XMVectorSet(
+					static_cast<float>(i[0] + r), static_cast<float>(i[1] + r), static_cast<float>(i[2] + r), static_cast<float>(i[3] + r));
+				const XMVECTOR alpha = XMVectorDivide(XMVectorSubtract(x, knot), divisor);
+				const XMVECTOR beta = XMVectorSubtract(one, alpha);
+				dx[j] = XMVectorAdd(XMVectorMultiply(dx[j - 1], beta), XMVectorMultiply(dx[j], alpha));
+				dy[j] = XMVectorAdd(XMVectorMultiply(dy[j - 1], beta), XMVectorMultiply(dy[j], alpha));
+			}
+		}
+		XMFLOAT4 rx, ry;
+		XMStoreFloat4(&rx, dx[degree]);
+		XMStoreFloat4(&ry, dy[degree]);
+		out[n] = XMFLOAT2(rx.x, ry.x);
+		out[n + 1] = XMFLOAT2(rx.y, ry.y);
+		out[n + 2] = XMFLOAT2(rx.z, ry.z);
+		out[n + 3] = XMFLOAT2(rx.w, ry.w);
+	}
+	for (; n < count; ++n) {
+		XMStoreFloat2(&out[n], DeBoor(degree, xList[n], points));
+	}
+	return true;
 }
 
 /**
@@ -609,20 +1098,20 @@ XMVECTOR DeBoor(int degree, float x, const std::vector<XMFLOAT2>& points) {
 * @param points        Rg[|Cg̔z. ȂƂ3̃Rg[|Cg܂łȂ΂ȂȂ.
 * @param numOfSegments 钆ԓ_̐. points̐ȏ̒lłȂ΂ȂȂ.
 *
-* @return ꂽԓ_̔z.
+* @return ꂽԓ_̔z. Ɏsꍇpointŝ܂ܕԂ.
 */
 std::vector<XMFLOAT2> CreateBSpline(const std::vector<XMFLOAT2>& points, int numOfSegments) {
-	std::vector<XMFLOAT2> v;
-	v.reserve(numOfSegments);
 	const float n = static_cast<float>(points.size() + 1);
+	std::vector<float> xList(numOfSegments - 1);
 	for (int i = 0; i < numOfSegments - 1; ++i) {
 		const float ratio = static_cast<float>(i) / static_cast<float>(numOfSegments - 1);
-		const float x = ratio * n + 1;
-		XMVECTORF32 pos;
-		pos.v = DeBoor(3, x, points);
-		v.emplace_back(pos.f[0], pos.f[1]);
+		xList[i] = ratio * n + 1;
 	}
-	v.push_back(points.back());
+	std::vector<XMFLOAT2> v(numOfSegments);
+	if (!DeBoorN(3, xList.data(), xList.size(), points, v.data())) {
+		return points;
+	}
+	v.back() = points.back();
 
 	// xNgԂ𓝍.
 	std::vector<XMVECTOR> vectorList;
@@ -649,6 +1138,88 @@ std::vector<XMFLOAT2> CreateBSpline(const std::vector<XMFLOAT2>& points, int num
 	return ret;
 }
 
+#ifdef ACTION_ENABLE_BSPLINE_COMPARISON
+/**
+* hEu[ÃASYɂBXvCW̐(ċA).
+*
+* DeBoor()DeBoorN()̔rp.
+*
+* @param k      ċAĂяo̐[x. degreeŊJnAċAďoɃfNg. 0ɂȂƂċA͏I.
+* @param degree .
+* @param i      WɎgpŏ̃Rg[|Cg̃CfbNX.
+* @param x      Ẅʒu. ŏ̃Rg[|Cg0AŌ̃Rg[|CgNƂƂA
+*               0`N̒l.
+* @param points Rg[|Cg̔z.
+*
+* @return xɑΉBXvCJ[u̍W.
+*/
+XMVECTOR DeBoorI(int k, int degree, int i, float x, const std::vector<XMFLOAT2>& points) {
+	if (k == 0) {
+		return XMLoadFloat2(&points[std::max(0, std::min<int>(i, points.size() - 1))]);
+	}
+	const float alpha = (x - static_cast<float>(i)) / static_cast<float>(degree + 1 - k);
+	const XMVECTOR a = DeBoorI(k - 1, degree, i - 1, x, points);
+	const XMVECTOR b = DeBoorI(k - 1, degree, i, x, points);
+	const XMVECTORF32 t{ alpha, (1.0f - alpha), 0.0f, 0.0f };
+	return XMVectorAdd(
+		XMVectorMultiply(a, XMVectorSwizzle(t, 1, 1, 1, 1)),
+		XMVectorMultiply(b, XMVectorSwizzle(t, 0, 0, 0, 0)));
+}
+
+/**
+* BXvCW̐@Ƃ̏Ԃƌ덷r.
+*
+* _ȃRg[|Cg3BXvC𐶐AċAłƂ
+* (DeBoor)SIMD(DeBoorN)̏Ԃƍő덷߂.
+*
+* @param pointCount Rg[|Cg̐.
+* @param repeat     JԂ.
+* @param result     rʂi[ϐ.
+*/
+void CompareBSplineEvaluation(size_t pointCount, int repeat, BSplineComparisonResult& result)
+{
+	std::vector<XMFLOAT2> points(std::max<size_t>(3, pointCount));
+	DebugHelper::Random random;
+	for (XMFLOAT2& p : points) {
+		p.x = random(0, 800);
+		p.y = random(0, 600);
+	}
+	const size_t sampleCount = points.size() * 16;
+	const float n = static_cast<float>(points.size() + 1);
+	std::vector<float> xList(sampleCount);
+	for (size_t i = 0; i < sampleCount; ++i) {
+		xList[i] = static_cast<float>(i) / static_cast<float>(sampleCount) * n + 1;
+	}
+	std::vector<XMFLOAT2> recursive(sampleCount), iterative(sampleCount), simd(sampleCount);
+
+	result.recursiveTime = DebugHelper::Measure(repeat, [&]() {
+		for (size_t i = 0; i < sampleCount; ++i) {
+			XMStoreFloat2(&recursive[i], DeBoorI(3, 3, static_cast<int>(xList[i]), xList[i], points));
+		}
+	});
+	result.iterativeTime = DebugHelper::Measure(repeat, [&]() {
+		for (size_t i = 0; i < sampleCount; ++i) {
+			XMStoreFloat2(&iterative[i], DeBoor(3, xList[i], points));
+		}
+	});
+	result.simdTime = DebugHelper::Measure(repeat, [&]() {
+		DeBoorN(3, xList.data(), sampleCount, points, simd.data());
+	});
+	result.maxIterativeError = 0;
+	result.maxSimdError = 0;
+	for (size_t i = 0; i < sampleCount; ++i) {
+		result.maxIterativeError = std::max(result.maxIterativeError, DebugHelper::GetError(iterative[i], recursive[i]));
+		result.maxSimdError = std::max(result.maxSimdError, DebugHelper::GetError(simd[i], recursive[i]));
+	}
+
+	char text[256];
+	snprintf(text, _countof(text), "BSpline(%u points): recursive=%.3fms iterative=%.3fms(err=%g) simd=%.3fms(err=%g)\n",
+		static_cast<uint32_t>(points.size()), result.recursiveTime, result.iterativeTime, result.maxIterativeError,
+		result.simdTime, result.maxSimdError);
+	Platform::DebugOutput(text);
+}
+#endif // ACTION_ENABLE_BSPLINE_COMPARISON
+
 /**
 * x@̒lʓx@ɕϊ.
 *
@@ -678,41 +1249,413 @@ XMVECTOR RadianToVector(float rad, float mag)
 }
 
 /**
-* RXgN^.
+* Rg[|CgpX쐬.
+*
+* @param controlPoints Rg[|Cg̔z.
+* @param totalTime     pẌړɂ鎞.
+* @param cp            쐬pXi[ϐ.
+*                      controlPoints̏ꍇ͋̔zɂȂ.
 */
-Controller::Controller()
+void BuildPath(const std::vector<XMFLOAT2>& controlPoints, float totalTime, std::vector<Point>& cp)
 {
-	SetList(nullptr);
+	if (controlPoints.empty()) {
+		cp.clear();
+		return;
+	}
+	std::vector<XMFLOAT2> tmpPoints = CreateBSpline(controlPoints, controlPoints.size() * 16);
+	cp.resize(tmpPoints.size());
+	for (size_t i = 0; i < tmpPoints.size(); ++i) {
+		cp[i].pos = tmpPoints[i];
+	}
+	cp[0].t = 0.0f;
+	for (size_t i = 0; i < tmpPoints.size() - 1; ++i) {
+		const XMVECTOR vec = XMVector2Length(XMVectorSubtract(XMLoadFloat2(&tmpPoints[i]), XMLoadFloat2(&tmpPoints[i + 1])));
+		XMStoreFloat(&cp[i + 1].t, vec);
+		cp[i + 1].t += cp[i].t;
+	}
+	// SẴRg[|CgʒuɂꍇApX̒0ɂȂ.
+	if (cp.back().t <= 0.0f) {
+		return;
+	}
+	const float factor = totalTime / cp.back().t;
+	for (auto& e : cp) {
+		e.t *= factor;
+	}
 }
 
 /**
-* RXgN^.
+* ߂̔z񂩂Ԃ̔z쐬.
 *
-* @param p  ݒ肷ANVXgւ̃|C^.
-* @param no ĐANVԍ.
+* MoveŐݒ肵xAccelŐݒ肵x́AWait̋Ԃœx^ƂĐϕ.
+* Path̋Ԃ̏ÍApX̏I_΍WƂĈp.
+*
+* @param program Ԃ쐬RpCς݃V[PX. code, pathList͍쐬ς݂łȂ΂ȂȂ.
 */
-Controller::Controller(const List* p, uint32_t no)
+void BuildTimeline(Program& program)
 {
-	SetList(p, no);
+	program.timeline.clear();
+	Segment seg = {};
+	seg.type = Type::Wait;
+	seg.isAbsolute = false;
+	seg.pos = seg.move = seg.accel = XMFLOAT2(0, 0);
+	seg.pathPc = -1;
+	seg.animationId = -1;
+	seg.generationPc = -1;
+	for (uint32_t i = 0; i < program.code.size(); ++i) {
+		const Instruction& inst = program.code[i];
+		switch (inst.type) {
+		case Type::Move:
+			seg.move = inst.vec;
+			break;
+		case Type::Accel:
+			seg.accel = inst.vec;
+			break;
+		case Type::Wait: {
+			seg.type = Type::Wait;
+			seg.pc = i;
+			seg.duration = inst.time;
+			program.timeline.push_back(seg);
+			const float t = inst.time;
+			seg.pos.x += seg.move.x * t + seg.accel.x * t * t * 0.5f;
+			seg.pos.y += seg.move.y * t + seg.accel.y * t * t * 0.5f;
+			seg.move.x += seg.accel.x * t;
+			seg.move.y += seg.accel.y * t;
+			seg.startTime += t;
+			break;
+		}
+		case Type::Path:
+			seg.type = Type::Path;
+			seg.pc = inst.next;
+			seg.duration = inst.time;
+			seg.pathPc = static_cast<int32_t>(i);
+			program.timeline.push_back(seg);
+			seg.isAbsolute = true;
+			seg.pos = program.pathList[inst.index].back().pos;
+			seg.pathPc = -1;
+			seg.startTime += inst.time;
+			i = inst.next;
+			break;
+		case Type::Vanishing:
+			seg.type = Type::Vanishing;
+			seg.pc = i;
+			seg.duration = 0;
+			program.timeline.push_back(seg);
+			return;
+		case Type::Animation:
+			if (inst.index >= 0) {
+				seg.animationId = inst.index;
+			}
+			break;
+		case Type::Generation:
+			seg.generationPc = static_cast<int32_t>(i);
+			break;
+		default:
+			break;
+		}
+	}
+	seg.type = Type::Wait;
+	seg.pc = static_cast<uint32_t>(program.code.size());
+	seg.duration = 0;
+	program.timeline.push_back(seg);
 }
 
 /**
-* ANVXgݒ肷.
+* ԓ̍WvZ.
 *
-* @param p  ݒ肷ANVXgւ̃|C^.
-* @param no ĐANVԍ.
+* @param program RpCς݃V[PX.
+* @param seg     .
+* @param t       Ԃ̊Jňoߎ. 0`seg.durationɐ؂l߂.
+* @param origin  V[PXJn̍W.
+* @param cursor  Path̏ꍇɎgApX̋Ԃ̏I_̃CfbNX. Vli[.
+*
+* @return W.
 */
-void Controller::SetList(const List* p, uint32_t no)
+XMFLOAT2 EvaluateSegment(const Program& program, const Segment& seg, float t, const XMFLOAT2& origin, size_t& cursor)
 {
-	list = p;
-	seqIndex = 0;
-	dataIndex = 0;
-	currentTime = 0;
+	t = std::min(std::max(0.0f, t), seg.duration);
+	if (seg.type == Type::Path) {
+		const std::vector<Point>& cp = program.pathList[program.code[seg.pathPc].index];
+		if (t >= seg.duration) {
+			return cp.back().pos;
+		}
+		FindPathSection(cp, t, cursor);
+		if (cursor == 0 || cursor >= cp.size()) {
+			return cp[std::min(cursor, cp.size() - 1)].pos;
+		}
+		const Point& p0 = cp[cursor - 1];
+		const Point& p1 = cp[cursor];
+		const float ratio = (t - p0.t) / (p1.t - p0.t);
+		return XMFLOAT2(p0.pos.x * (1.0f - ratio) + p1.pos.x * ratio, p0.pos.y * (1.0f - ratio) + p1.pos.y * ratio);
+	}
+	XMFLOAT2 pos(
+		seg.pos.x + seg.move.x * t + seg.accel.x * t * t * 0.5f,
+		seg.pos.y + seg.move.y * t + seg.accel.y * t * t * 0.5f);
+	if (!seg.isAbsolute) {
+		pos.x += origin.x;
+		pos.y += origin.y;
+	}
+	return pos;
+}
+
+/**
+* ɑΉԂ߂.
+*
+* @param program RpCς݃V[PX.
+* @param t       V[PXJňoߎ.
+*
+* @return t܂ދ. ԂȂnullptr.
+*/
+const Segment* FindSegment(const Program& program, float t)
+{
+	if (program.timeline.empty()) {
+		return nullptr;
+	}
+	auto itr = std::upper_bound(program.timeline.begin(), program.timeline.end(), t);
+	if (itr != program.timeline.begin()) {
+		--itr;
+	}
+	return &*itr;
+}
+
+/**
+* L[t[ǉ.
+*
+* ÕL[t[ƑSꍇ͒ǉȂ.
+*
+* @param keyList L[t[̔z.
+* @param key     ǉL[t[.
+*/
+void PushKeyframe(std::vector<Keyframe>& keyList, const Keyframe& key)
+{
+	if (!keyList.empty()) {
+		const Keyframe& back = keyList.back();
+		if (back.t == key.t && back.pos.x == key.pos.x && back.pos.y == key.pos.y && back.originWeight == key.originWeight) {
+			return;
+		}
+	}
+	keyList.push_back(key);
+}
+
+/**
+* Ԃ̔z񂩂OՂ쐬.
+*
+* ŏ̋ԂOɂAnimationGeneratiońAControllerłXvCgȂŏĖ邽߁A
+* CxgɂȂ.
+*
+* @param program OՂ쐬RpCς݃V[PX. timeline͍쐬ς݂łȂ΂ȂȂ.
+*/
+void BuildTrack(Program& program)
+{
+	Track& track = program.track;
+	track.keyList.clear();
+	track.eventList.clear();
+	track.vanishTime = -1.0f;
+	if (program.timeline.empty()) {
+		return;
+	}
+	float time = 0;
+	bool isStarted = false;
+	for (uint32_t i = 0; i < program.code.size(); ++i) {
+		const Instruction& inst = program.code[i];
+		if (inst.type == Type::Vanishing) {
+			break;
+		}
+		switch (inst.type) {
+		case Type::Wait:
+			time += inst.time;
+			isStarted = true;
+			break;
+		case Type::Path:
+			time += inst.time;
+			isStarted = true;
+			i = inst.next;
+			break;
+		case Type::Animation:
+			if (isStarted && inst.index >= 0) {
+				track.eventList.push_back({ time, Type::Animation, inst.index });
+			}
+			break;
+		case Type::Generation:
+			if (isStarted) {
+				track.eventList.push_back({ time, Type::Generation, static_cast<int32_t>(i) });
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	const XMFLOAT2 zero(0, 0);
+	for (const Segment& seg : program.timeline) {
+		size_t cursor = 0;
+		if (seg.type == Type::Path) {
+			for (const Point& p : program.pathList[program.code[seg.pathPc].index]) {
+				PushKeyframe(track.keyList, { seg.startTime + p.t, p.pos, 0.0f });
+			}
+			continue;
+		}
+		const float weight = seg.isAbsolute ? 0.0f : 1.0f;
+		PushKeyframe(track.keyList, { seg.startTime, EvaluateSegment(program, seg, 0, zero, cursor), weight });
+		if (seg.duration <= 0) {
+			if (seg.type == Type::Vanishing) {
+				track.vanishTime = seg.startTime;
+			}
+			continue;
+		}
+		if (seg.accel.x != 0 || seg.accel.y != 0) {
+			const int count = static_cast<int>(seg.duration * trackSampleRate);
+			for (int i = 1; i < count; ++i) {
+				const float t = static_cast<float>(i) / trackSampleRate;
+				PushKeyframe(track.keyList, { seg.startTime + t, EvaluateSegment(program, seg, t, zero, cursor), weight });
+			}
+		}
+		PushKeyframe(track.keyList, { seg.startTime + seg.duration, EvaluateSegment(program, seg, seg.duration, zero, cursor), weight });
+	}
+}
+
+/**
+* OՏ̍WvZ.
+*
+* @param track  O.
+* @param t      V[PXJn̎.
+* @param origin V[PXJn̍W.
+* @param cursor ŐԂ̎n_̃L[t[̃CfbNX. ̒li[.
+*               ͑ł邱ƂOɁAÖʒu珇ɒT.
+*
+* @return W.
+*/
+XMFLOAT2 EvaluateTrack(const Track& track, float t, const XMFLOAT2& origin, size_t& cursor)
+{
+	const std::vector<Keyframe>& keyList = track.keyList;
+	if (cursor >= keyList.size() || keyList[cursor].t > t) {
+		cursor = 0;
+	}
+	while (cursor + 1 < keyList.size() && keyList[cursor + 1].t <= t) {
+		++cursor;
+	}
+	const Keyframe& k0 = keyList[cursor];
+	if (cursor + 1 >= keyList.size() || t <= k0.t) {
+		return XMFLOAT2(k0.pos.x + origin.x * k0.originWeight, k0.pos.y + origin.y * k0.originWeight);
+	}
+	const Keyframe& k1 = keyList[cursor + 1];
+	const float ratio = (t - k0.t) / (k1.t - k0.t);
+	const float weight = k0.originWeight * (1.0f - ratio) + k1.originWeight * ratio;
+	return XMFLOAT2(
+		k0.pos.x * (1.0f - ratio) + k1.pos.x * ratio + origin.x * weight,
+		k0.pos.y * (1.0f - ratio) + k1.pos.y * ratio + origin.y * weight);
+}
+
+/**
+* ANVV[PX𖽗߂̔zɃRpC.
+*
+* Ƒ̈ړxNǧvZARg[|Cg̃pX̍쐬́Aōς܂Ă.
+*
+* @param seq     RpCANVV[PX.
+* @param program RpCʂi[ϐ.
+*/
+void Compile(const Sequence& seq, Program& program)
+{
+	program.code.resize(seq.size());
+	program.pathList.clear();
+	for (size_t i = 0; i < seq.size(); ++i) {
+		const Data& data = seq[i];
+		Instruction& inst = program.code[i];
+		inst.type = data.type;
+		inst.next = static_cast<uint32_t>(i);
+		inst.time = 0.0f;
+		inst.vec = XMFLOAT2(0, 0);
+		inst.index = -1;
+		switch (data.type) {
+		case Type::Move:
+			XMStoreFloat2(&inst.vec, RadianToVector(DegreeToRadian(data.param[MoveParamId_DirectionDegree]), data.param[MoveParamId_Speed]));
+			break;
+		case Type::Accel:
+			XMStoreFloat2(&inst.vec, RadianToVector(DegreeToRadian(data.param[AccelParamId_DirectionDegree]), data.param[AccelParamId_Accel]));
+			break;
+		case Type::Wait:
+			inst.time = data.param[WaitParamId_Time];
+			break;
+		case Type::Path: {
+			inst.time = data.param[PathParamId_Time];
+			std::vector<XMFLOAT2> controlPoints;
+			controlPoints.reserve(static_cast<size_t>(data.param[PathParamId_Count]));
+			size_t next = i;
+			for (int n = 0; n < data.param[PathParamId_Count]; ++n) {
+				if (++next >= seq.size()) {
+					break;
+				}
+				const Data& cp = seq[next];
+				if (cp.type != Type::ControlPoint) {
+					break;
+				}
+				controlPoints.emplace_back(cp.param[ControlPointId_X], cp.param[ControlPointId_Y]);
+			}
+			inst.next = static_cast<uint32_t>(next);
+			if (controlPoints.empty()) {
+				// Rg[|CgȂ΃pXȂ̂ŁAԂҋ@.
+				inst.type = Type::Wait;
+				break;
+			}
+			inst.index = static_cast<int32_t>(program.pathList.size());
+			program.pathList.emplace_back();
+			BuildPath(controlPoints, inst.time, program.pathList.back());
+			break;
+		}
+		case Type::Animation:
+			if (data.param[AnimeParamId_Id] >= 0) {
+				inst.index = static_cast<int32_t>(static_cast<uint32_t>(data.param[AnimeParamId_Id]));
+			}
+			break;
+		case Type::Generation:
+			inst.vec = XMFLOAT2(data.param[GenParamId_Speed], data.param[GenParamId_DirectionDegree]);
+			break;
+		default:
+			break;
+		}
+	}
+	BuildTimeline(program);
+	BuildTrack(program);
+}
+
+/**
+* RXgN^.
+*/
+Controller::Controller() : useTrack(false)
+{
+	SetList(nullptr);
+}
+
+/**
+* RXgN^.
+*
+* @param p  ݒ肷ANVXgւ̃|C^.
+* @param no ĐANVԍ.
+*/
+Controller::Controller(const List* p, uint32_t no) : useTrack(false)
+{
+	SetList(p, no);
+}
+
+/**
+* ANVXgݒ肷.
+*
+* @param p  ݒ肷ANVXgւ̃|C^.
+* @param no ĐANVԍ.
+*/
+void Controller::SetList(const List* p, uint32_t no)
+{
+	list = p;
+	seqIndex = 0;
+	dataIndex = 0;
+	currentTime = 0;
 	totalTime = 0;
 	isGeneratorActive = false;
 	type = Type::ManualControl;
 	move = XMFLOAT2(0, 0);
 	accel = XMFLOAT2(0, 0);
+	path.cp = nullptr;
+	path.cursor = 0;
+	ResetTrack();
 	if (!list || no >= list->list.size() || dataIndex >= list->list[no].size()) {
 		return;
 	}
@@ -744,37 +1687,21 @@ void Controller::Init(Sprite::Sprite* pSprite)
 			totalTime = data.param[WaitParamId_Time];
 			return;
 		case Type::Path: {
+			// pX̓RpCɍ쐬ς݂Ȃ̂ŁALĂ̂QƂ邾ł悢.
+			const Program& program = list->programList[seqIndex];
+			const Instruction& inst = program.code[dataIndex];
+			if (inst.type != Type::Path) {
+				// Rg[|CgȂpX́ACompile()őҋ@ɒuĂ.
+				type = Type::Move;
+				totalTime = inst.time;
+				return;
+			}
 			type = Type::Path;
-			totalTime = data.param[PathParamId_Time];
+			totalTime = inst.time;
 			path.type = static_cast<InterporationType>(static_cast<int>(data.param[PathParamId_Interporation]));
-			std::vector<XMFLOAT2> controlPoints;
-			controlPoints.reserve(static_cast<size_t>(data.param[PathParamId_Count]));
-			for (int i = 0; i < data.param[PathParamId_Count]; ++i) {
-				if (++dataIndex >= list->list[seqIndex].size()) {
-					break;
-				}
-				const Data& cp = list->list[seqIndex][dataIndex];
-				if (cp.type != Type::ControlPoint) {
-					break;
-				}
-				controlPoints.emplace_back(cp.param[ControlPointId_X], cp.param[ControlPointId_Y]);
-			}
-			std::vector<XMFLOAT2> tmpPoints = CreateBSpline(controlPoints, controlPoints.size() * 16);
-			std::vector<float> distances;
-			path.cp.resize(tmpPoints.size());
-			for (size_t i = 0; i < tmpPoints.size(); ++i) {
-				path.cp[i].pos = tmpPoints[i];
-			}
-			path.cp[0].t = 0.0f;
-			for (size_t i = 0; i < tmpPoints.size() - 1; ++i) {
-				const XMVECTOR vec = XMVector2Length(XMVectorSubtract(XMLoadFloat2(&tmpPoints[i]), XMLoadFloat2(&tmpPoints[i + 1])));
-				XMStoreFloat(&path.cp[i + 1].t, vec);
-				path.cp[i + 1].t += path.cp[i].t;
-			}
-			const float factor = totalTime / path.cp.back().t;
-			for (auto& e : path.cp) {
-				e.t *= factor;
-			}
+			path.cp = &program.pathList[inst.index];
+			path.cursor = 0;
+			dataIndex = inst.next;
 			return;
 		}
 		case Type::Vanishing:
@@ -813,15 +1740,16 @@ void Controller::UpdateSub(float delta, Sprite::Sprite* pSprite)
 		break;
 	}
 	case Type::Path: {
+		const std::vector<Point>& cp = *path.cp;
 		const float t = currentTime + delta;
 		if (t >= totalTime) {
-			pSprite->pos.x = path.cp.back().pos.x;
-			pSprite->pos.y = path.cp.back().pos.y;
+			pSprite->pos.x = cp.back().pos.x;
+			pSprite->pos.y = cp.back().pos.y;
 		} else {
-			const auto itr = std::upper_bound(path.cp.begin(), path.cp.end(), Point{ {}, t });
-			if (itr != path.cp.end()) {
-				const Point& p0 = *(itr - 1);
-				const Point& p1 = *itr;
+			FindPathSection(cp, t, path.cursor);
+			if (path.cursor < cp.size()) {
+				const Point& p0 = cp[path.cursor - 1];
+				const Point& p1 = cp[path.cursor];
 				const float length = p1.t - p0.t;
 				const float distance = t - p0.t;
 				const float ratio = distance / length;
@@ -856,6 +1784,10 @@ void Controller::Update(float delta, Sprite::Sprite* pSprite)
 		}
 		return;
 	}
+	if (useTrack && list && seqIndex < list->programList.size()) {
+		UpdateTrack(delta, pSprite);
+		return;
+	}
 	if (!list || seqIndex >= list->list.size() || dataIndex >= list->list[seqIndex].size() || type == Type::Vanishing) {
 		return;
 	}
@@ -874,6 +1806,150 @@ void Controller::Update(float delta, Sprite::Sprite* pSprite)
 	}
 }
 
+/**
+* Oɍ쐬OՂgāAANV̏ԂXVAXvCgɔf.
+*
+* ŏ̌ĂяõXvCg̍WAV[PXJn̍WƂ.
+*
+* @param delta XV(b).
+* @param pSprite ANV𔽉fXvCgւ̃|C^.
+*/
+void Controller::UpdateTrack(float delta, Sprite::Sprite* pSprite)
+{
+	const Program& program = list->programList[seqIndex];
+	const Track& track = program.track;
+	if (type == Type::Vanishing || track.keyList.empty()) {
+		return;
+	}
+	if (!trackState.isOriginSet) {
+		trackState.origin = XMFLOAT2(pSprite->pos.x, pSprite->pos.y);
+		trackState.isOriginSet = true;
+	}
+	trackState.time += delta;
+	for (; trackState.eventCursor < track.eventList.size(); ++trackState.eventCursor) {
+		const TrackEvent& e = track.eventList[trackState.eventCursor];
+		if (e.t > trackState.time) {
+			break;
+		}
+		if (e.type == Type::Animation) {
+			pSprite->SetSeqIndex(static_cast<uint32_t>(e.index));
+		} else if (e.type == Type::Generation && generator) {
+			const Instruction& inst = program.code[e.index];
+			isGeneratorActive = true;
+			generator(0.0f, pSprite, inst.vec.x, inst.vec.y);
+		}
+	}
+	float t = trackState.time;
+	if (track.vanishTime >= 0 && t >= track.vanishTime) {
+		t = track.vanishTime;
+		type = Type::Vanishing;
+	}
+	const XMFLOAT2 pos = EvaluateTrack(track, t, trackState.origin, trackState.keyCursor);
+	pSprite->pos.x = pos.x;
+	pSprite->pos.y = pos.y;
+}
+
+/**
+* OՂ̍ĐԂ.
+*/
+void Controller::ResetTrack()
+{
+	trackState.time = 0;
+	trackState.keyCursor = 0;
+	trackState.eventCursor = 0;
+	trackState.isOriginSet = false;
+}
+
+/**
+* w肵̍WvZ.
+*
+* V[PX̐擪玞t܂Update()JԂꍇ̍WAt[H炸ɒڋ߂.
+* Waiẗړ͓x^̎ŌvZ邽߁AxꍇAUpdate()1t[ϕWƂ
+* XVԊuɔႵ킸ȍ.
+*
+* @param t      V[PXJňoߎ(b).
+* @param origin V[PXJñXvCg̍W.
+* @param pos    vZWi[ϐ.
+*
+* @retval true  vZ.
+* @retval false ANVXgݒ肳ĂȂ.
+*/
+bool Controller::GetPositionAt(float t, const XMFLOAT2& origin, XMFLOAT2& pos) const
+{
+	if (!list || seqIndex >= list->programList.size()) {
+		return false;
+	}
+	const Program& program = list->programList[seqIndex];
+	const Segment* seg = FindSegment(program, t);
+	if (!seg) {
+		return false;
+	}
+	size_t cursor = 0;
+	pos = EvaluateSegment(program, *seg, t - seg->startTime, origin, cursor);
+	return true;
+}
+
+/**
+* w肵̏ԂɈړ.
+*
+* V[PX̐擪玞t܂Update()JԂꍇƓԂAt[H炸ɒڍ.
+* ȌUpdate()͎tĐ𑱂.
+* Aj[V͎t܂łɍŌɎw肳ꂽ̂ݒ肵A֐͍ŌGeneration߂
+* p[^1xĂяo. OGeneration߂̌Ăяo͍ČȂ.
+*
+* @param t       V[PXJňoߎ(b).
+* @param origin  V[PXJñXvCg̍W.
+* @param pSprite Ԃ𔽉fXvCgւ̃|C^. nullptȑꍇ͍W̐ݒȂǂsȂ.
+*/
+void Controller::Seek(float t, const XMFLOAT2& origin, Sprite::Sprite* pSprite)
+{
+	if (!list || seqIndex >= list->programList.size()) {
+		return;
+	}
+	const Program& program = list->programList[seqIndex];
+	const Segment* seg = FindSegment(program, t);
+	if (!seg) {
+		return;
+	}
+	const float localTime = std::min(std::max(0.0f, t - seg->startTime), seg->duration);
+	dataIndex = seg->pc;
+	currentTime = localTime;
+	totalTime = seg->duration;
+	path.cp = nullptr;
+	path.cursor = 0;
+	move = XMFLOAT2(seg->move.x + seg->accel.x * localTime, seg->move.y + seg->accel.y * localTime);
+	accel = seg->accel;
+	switch (seg->type) {
+	case Type::Wait:
+		type = Type::Move;
+		break;
+	case Type::Path:
+		type = Type::Path;
+		move = seg->move;
+		path.type = static_cast<InterporationType>(static_cast<int>(list->list[seqIndex][seg->pathPc].param[PathParamId_Interporation]));
+		path.cp = &program.pathList[program.code[seg->pathPc].index];
+		break;
+	default:
+		type = seg->type;
+		break;
+	}
+	isGeneratorActive = false;
+	if (!pSprite) {
+		return;
+	}
+	const XMFLOAT2 pos = EvaluateSegment(program, *seg, localTime, origin, path.cursor);
+	pSprite->pos.x = pos.x;
+	pSprite->pos.y = pos.y;
+	if (seg->animationId >= 0) {
+		pSprite->SetSeqIndex(static_cast<uint32_t>(seg->animationId));
+	}
+	if (seg->generationPc >= 0 && generator) {
+		const Instruction& inst = program.code[seg->generationPc];
+		isGeneratorActive = true;
+		generator(0.0f, pSprite, inst.vec.x, inst.vec.y);
+	}
+}
+
 /**
 * ĐANVV[PXw肷.
 *
@@ -891,6 +1967,7 @@ void Controller::SetSeqIndex(uint32_t no)
 	type = data.type;
 	currentTime = 0.0f;
 	totalTime = 0.0f;
+	ResetTrack();
 	Init();
 }
 
@@ -943,6 +2020,512 @@ bool Controller::IsDeletable() const
 	return type == Type::Vanishing;
 }
 
+/**
+* Xbg\񂷂.
+*
+* @param slotCount \񂷂Xbg. ̐l܂ł͒ǉ̃mۂNȂ.
+*/
+void Batch::Reserve(size_t slotCount)
+{
+	const size_t paddedCount = (slotCount + 3) & ~static_cast<size_t>(3);
+	spriteArray.reserve(slotCount);
+	programArray.reserve(slotCount);
+	pcArray.reserve(slotCount);
+	typeArray.reserve(slotCount);
+	currentTimeArray.reserve(paddedCount);
+	totalTimeArray.reserve(paddedCount);
+	moveXArray.reserve(paddedCount);
+	moveYArray.reserve(paddedCount);
+	accelXArray.reserve(paddedCount);
+	accelYArray.reserve(paddedCount);
+	posXArray.reserve(paddedCount);
+	posYArray.reserve(paddedCount);
+	moveMaskArray.reserve(paddedCount);
+	manualMaskArray.reserve(paddedCount);
+	pathArray.reserve(slotCount);
+	pathCursorArray.reserve(slotCount);
+	generatorActiveArray.reserve(slotCount);
+	generatorArray.reserve(slotCount);
+	freeList.reserve(slotCount);
+	moveList.reserve(slotCount);
+	otherList.reserve(slotCount);
+	generatorList.reserve(slotCount);
+}
+
+/**
+* Xbgǉ.
+*
+* Controller::SetList()ƓAV[PX擪̃Aj[VύXƐ͍sȂ.
+* Xbg̍W̓XvCǧ݂̍Wŏ.
+* 󂫃XbgȂ΁AXbgԍ͒ǉ0犄蓖Ă.
+*
+* @param l      sANVXg. nullptrȂ}jAɂȂ.
+* @param no     sANVԍ.
+* @param sprite 䂷XvCg.
+*
+* @return ǉXbg̔ԍ.
+*/
+uint32_t Batch::Add(const List* l, uint32_t no, Sprite::Sprite* sprite)
+{
+	uint32_t slot;
+	if (freeList.empty()) {
+		slot = static_cast<uint32_t>(spriteArray.size());
+		Resize(slot + 1);
+	} else {
+		slot = freeList.back();
+		freeList.pop_back();
+	}
+	spriteArray[slot] = sprite;
+	programArray[slot] = nullptr;
+	pcArray[slot] = 0;
+	typeArray[slot] = Type::ManualControl;
+	currentTimeArray[slot] = 0;
+	totalTimeArray[slot] = 0;
+	moveXArray[slot] = 0;
+	moveYArray[slot] = 0;
+	accelXArray[slot] = 0;
+	accelYArray[slot] = 0;
+	posXArray[slot] = sprite->pos.x;
+	posYArray[slot] = sprite->pos.y;
+	pathArray[slot] = nullptr;
+	pathCursorArray[slot] = 0;
+	generatorActiveArray[slot] = 0;
+	generatorArray[slot] = nullptr;
+	if (l && no < l->programList.size() && !l->programList[no].code.empty()) {
+		programArray[slot] = &l->programList[no];
+		Init(slot, nullptr);
+	}
+	return slot;
+}
+
+/**
+* Xbg폜.
+*
+* @param slot 폜Xbgԍ.
+*/
+void Batch::Remove(uint32_t slot)
+{
+	if (slot >= spriteArray.size() || !spriteArray[slot]) {
+		return;
+	}
+	spriteArray[slot] = nullptr;
+	programArray[slot] = nullptr;
+	generatorArray[slot] = nullptr;
+	freeList.push_back(slot);
+}
+
+/**
+* Xbg̍Wݒ肷.
+*
+* XvCg̍WɍXV.
+*
+* @param slot Xbgԍ.
+* @param pos  ݒ肷W.
+*/
+void Batch::SetPosition(uint32_t slot, const XMFLOAT2& pos)
+{
+	posXArray[slot] = pos.x;
+	posYArray[slot] = pos.y;
+	spriteArray[slot]->pos.x = pos.x;
+	spriteArray[slot]->pos.y = pos.y;
+}
+
+/**
+* Xbg}jAɂāAړxݒ肷.
+*
+* Controller::SetManualMove()ɑΉ.
+*
+* @param slot   Xbgԍ.
+* @param degree ړ(0-360).
+* @param speed  ړx(pixels/s).
+*/
+void Batch::SetManualMove(uint32_t slot, float degree, float speed)
+{
+	typeArray[slot] = Type::ManualControl;
+	XMFLOAT2 m;
+	XMStoreFloat2(&m, RadianToVector(DegreeToRadian(degree), speed));
+	moveXArray[slot] = m.x;
+	moveYArray[slot] = m.y;
+}
+
+/**
+* SẴXbg̃ANVXVAXvCgɔf.
+*
+* 1. ֐ނƂɂ܂Ƃ߂ČĂяoAXbgړA}jA쒆AȊOɕ.
+* 2. ړƃ}jA쒆̃XbgAz̐擪4܂Ƃ߂Ĉړ.
+* 3. 쎞Ԃg؂Xbg̃ANVɐi߁AȊÕXbgʂɍXV.
+* 4. WXvCgɏ.
+*
+* @param delta XV(b).
+*/
+void Batch::Update(float delta)
+{
+	moveList.clear();
+	otherList.clear();
+	generatorList.clear();
+	const uint32_t slotCount = static_cast<uint32_t>(spriteArray.size());
+	for (uint32_t slot = 0; slot < slotCount; ++slot) {
+		if (spriteArray[slot] && typeArray[slot] != Type::Vanishing && generatorActiveArray[slot] && generatorArray[slot]) {
+			generatorList.push_back(slot);
+		}
+	}
+	// ނ̐֐ČĂ΂悤ɕבւ.
+	std::sort(generatorList.begin(), generatorList.end(), [this](uint32_t lhs, uint32_t rhs) {
+		const Generator::InvokeFunc l = generatorArray[lhs].GetKind();
+		const Generator::InvokeFunc r = generatorArray[rhs].GetKind();
+		if (l != r) {
+			return std::less<Generator::InvokeFunc>()(l, r);
+		}
+		return lhs < rhs;
+	});
+	for (uint32_t slot : generatorList) {
+		generatorArray[slot](delta, spriteArray[slot], 0, 0);
+	}
+
+	for (uint32_t slot = 0; slot < slotCount; ++slot) {
+		moveMaskArray[slot] = 0;
+		manualMaskArray[slot] = 0;
+		if (!spriteArray[slot]) {
+			continue;
+		}
+		const Program* program = programArray[slot];
+		if (typeArray[slot] == Type::ManualControl) {
+			manualMaskArray[slot] = 0xffffffff;
+		} else if (typeArray[slot] == Type::Move && program && pcArray[slot] < program->code.size()) {
+			moveMaskArray[slot] = 0xffffffff;
+			moveList.push_back(slot);
+		} else {
+			otherList.push_back(slot);
+		}
+	}
+
+	const XMVECTOR vdelta = XMVectorReplicate(delta);
+	const XMVECTOR vzero = XMVectorZero();
+	for (size_t i = 0; i < posXArray.size(); i += 4) {
+		const XMVECTOR isMove = XMLoadInt4(&moveMaskArray[i]);
+		const XMVECTOR isManual = XMLoadInt4(&manualMaskArray[i]);
+		const XMVECTOR isActive = XMVectorOrInt(isMove, isManual);
+		if (XMVector4EqualInt(isActive, XMVectorFalseInt())) {
+			continue;
+		}
+		XMFLOAT4* const pCurrent = reinterpret_cast<XMFLOAT4*>(&currentTimeArray[i]);
+		XMFLOAT4* const pMoveX = reinterpret_cast<XMFLOAT4*>(&moveXArray[i]);
+		XMFLOAT4* const pMoveY = reinterpret_cast<XMFLOAT4*>(&moveYArray[i]);
+		XMFLOAT4* const pPosX = reinterpret_cast<XMFLOAT4*>(&posXArray[i]);
+		XMFLOAT4* const pPosY = reinterpret_cast<XMFLOAT4*>(&posYArray[i]);
+		const XMVECTOR current = XMLoadFloat4(pCurrent);
+		const XMVECTOR total = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&totalTimeArray[i]));
+		const XMVECTOR ax = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&accelXArray[i]));
+		const XMVECTOR ay = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&accelYArray[i]));
+		const XMVECTOR mx = XMLoadFloat4(pMoveX);
+		const XMVECTOR my = XMLoadFloat4(pMoveY);
+		const XMVECTOR px = XMLoadFloat4(pPosX);
+		const XMVECTOR py = XMLoadFloat4(pPosY);
+
+		// ړ͎c̓쎞ԂA}jA쒆͏ɍXVԂړ.
+		// }jA쒆̌oߎԂ́A쎞ԂɒB܂łi߂Ȃ.
+		const XMVECTOR dt = XMVectorSelect(XMVectorMin(XMVectorMax(vzero, XMVectorSubtract(total, current)), vdelta), vdelta, isManual);
+		const XMVECTOR isTimeAdvanced = XMVectorOrInt(isMove, XMVectorAndInt(isManual, XMVectorLess(current, total)));
+		XMStoreFloat4(pPosX, XMVectorSelect(px, XMVectorAdd(px, XMVectorMultiply(mx, dt)), isActive));
+		XMStoreFloat4(pPosY, XMVectorSelect(py, XMVectorAdd(py, XMVectorMultiply(my, dt)), isActive));
+		XMStoreFloat4(pMoveX, XMVectorSelect(mx, XMVectorAdd(mx, XMVectorMultiply(ax, dt)), isActive));
+		XMStoreFloat4(pMoveY, XMVectorSelect(my, XMVectorAdd(my, XMVectorMultiply(ay, dt)), isActive));
+		XMStoreFloat4(pCurrent, XMVectorSelect(current, XMVectorAdd(current, vdelta), isTimeAdvanced));
+	}
+
+	for (const uint32_t slot : moveList) {
+		if (currentTimeArray[slot] >= totalTimeArray[slot]) {
+			AdvanceStep(slot);
+		}
+	}
+	for (const uint32_t slot : otherList) {
+		UpdateSlot(slot, delta);
+	}
+
+	for (uint32_t slot = 0; slot < slotCount; ++slot) {
+		if (Sprite::Sprite* pSprite = spriteArray[slot]) {
+			pSprite->pos.x = posXArray[slot];
+			pSprite->pos.y = posYArray[slot];
+		}
+	}
+}
+
+/**
+* ŏԂɂȂĂ邩ǂ.
+*
+* @param slot Xbgԍ.
+*
+* @retval true  ŏԂɂȂĂ.
+* @retval false ŏԂɂȂĂȂ.
+*/
+bool Batch::IsDeletable(uint32_t slot) const
+{
+	return typeArray[slot] == Type::Vanishing;
+}
+
+/**
+* Xbǧ݂̖߂A쎞Ԃ߂܂łs.
+*
+* Controller::Init()ɑΉ.
+*
+* @param slot    Xbgԍ.
+* @param pSprite Aj[VύXƐ̑ΏۂƂȂXvCg. nullptȑꍇ͂ǂsȂ.
+*/
+void Batch::Init(uint32_t slot, Sprite::Sprite* pSprite)
+{
+	const Program* program = programArray[slot];
+	if (!program || typeArray[slot] == Type::Vanishing) {
+		return;
+	}
+	uint32_t& pc = pcArray[slot];
+	for (; pc < program->code.size(); ++pc) {
+		const Instruction& inst = program->code[pc];
+		switch (inst.type) {
+		case Type::Move:
+			typeArray[slot] = Type::Move;
+			moveXArray[slot] = inst.vec.x;
+			moveYArray[slot] = inst.vec.y;
+			break;
+		case Type::Accel:
+			typeArray[slot] = Type::Move;
+			accelXArray[slot] = inst.vec.x;
+			accelYArray[slot] = inst.vec.y;
+			break;
+		case Type::Wait:
+			typeArray[slot] = Type::Move;
+			totalTimeArray[slot] = inst.time;
+			return;
+		case Type::Path:
+			typeArray[slot] = Type::Path;
+			totalTimeArray[slot] = inst.time;
+			pathArray[slot] = &program->pathList[inst.index];
+			pathCursorArray[slot] = 0;
+			pc = inst.next;
+			return;
+		case Type::Vanishing:
+			typeArray[slot] = Type::Vanishing;
+			return;
+		case Type::Animation:
+			if (pSprite && inst.index >= 0) {
+				pSprite->SetSeqIndex(static_cast<uint32_t>(inst.index));
+			}
+			break;
+		case Type::Generation:
+			if (pSprite && generatorArray[slot]) {
+				// ֐̓XvCg̍WQƂ̂ŁA܂ł̈ړ𔽉fĂ.
+				pSprite->pos.x = posXArray[slot];
+				pSprite->pos.y = posYArray[slot];
+				generatorActiveArray[slot] = 1;
+				generatorArray[slot](0.0f, pSprite, inst.vec.x, inst.vec.y);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/**
+* Xbg̃ANVWɔf.
+*
+* Controller::UpdateSub()ɑΉ.
+*
+* @param slot  Xbgԍ.
+* @param delta XV(b).
+*/
+void Batch::UpdateSub(uint32_t slot, float delta)
+{
+	switch (typeArray[slot]) {
+	case Type::Move:
+		posXArray[slot] += moveXArray[slot] * delta;
+		posYArray[slot] += moveYArray[slot] * delta;
+		moveXArray[slot] += accelXArray[slot] * delta;
+		moveYArray[slot] += accelYArray[slot] * delta;
+		break;
+	case Type::Path: {
+		const std::vector<Point>& cp = *pathArray[slot];
+		const float t = currentTimeArray[slot] + delta;
+		if (t >= totalTimeArray[slot]) {
+			posXArray[slot] = cp.back().pos.x;
+			posYArray[slot] = cp.back().pos.y;
+		} else {
+			uint32_t& cursor = pathCursorArray[slot];
+			FindPathSection(cp, t, cursor);
+			if (cursor < cp.size()) {
+				const Point& p0 = cp[cursor - 1];
+				const Point& p1 = cp[cursor];
+				const float length = p1.t - p0.t;
+				const float distance = t - p0.t;
+				const float ratio = distance / length;
+				posXArray[slot] = p0.pos.x * (1.0f - ratio) + p1.pos.x * ratio;
+				posYArray[slot] = p0.pos.y * (1.0f - ratio) + p1.pos.y * ratio;
+			}
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+/**
+* ړƃ}jA쒆ȊÕXbgXV.
+*
+* ֐̌ĂяoāAController::Update()ɑΉ.
+*
+* @param slot  Xbgԍ.
+* @param delta XV(b).
+*/
+void Batch::UpdateSlot(uint32_t slot, float delta)
+{
+	const Program* program = programArray[slot];
+	if (!program || pcArray[slot] >= program->code.size() || typeArray[slot] == Type::Vanishing) {
+		return;
+	}
+	UpdateSub(slot, std::min(std::max(0.0f, totalTimeArray[slot] - currentTimeArray[slot]), delta));
+	currentTimeArray[slot] += delta;
+	AdvanceStep(slot);
+}
+
+/**
+* 쎞Ԃg؂Xbg̖߂ɐi߂.
+*
+* @param slot Xbgԍ.
+*/
+void Batch::AdvanceStep(uint32_t slot)
+{
+	const Program* program = programArray[slot];
+	while (currentTimeArray[slot] >= totalTimeArray[slot]) {
+		currentTimeArray[slot] -= totalTimeArray[slot];
+		totalTimeArray[slot] = 0.0f;
+		const float delta = currentTimeArray[slot];
+		++pcArray[slot];
+		if (pcArray[slot] >= program->code.size()) {
+			return;
+		}
+		Init(slot, spriteArray[slot]);
+		UpdateSub(slot, std::min(std::max(0.0f, totalTimeArray[slot] - currentTimeArray[slot]), delta));
+	}
+}
+
+/**
+* XbgύX.
+*
+* ԁAxAxAW̔źASIMD4Xbgł悤4̔{ɐ؂グ.
+* ]ȗvf͈ړɂ}jA쒆ɂȂȂ̂ŁAl͕ωȂ.
+*
+* @param slotCount VXbg.
+*/
+void Batch::Resize(size_t slotCount)
+{
+	const size_t paddedCount = (slotCount + 3) & ~static_cast<size_t>(3);
+	spriteArray.resize(slotCount, nullptr);
+	programArray.resize(slotCount, nullptr);
+	pcArray.resize(slotCount, 0);
+	typeArray.resize(slotCount, Type::ManualControl);
+	currentTimeArray.resize(paddedCount, 0.0f);
+	totalTimeArray.resize(paddedCount, 0.0f);
+	moveXArray.resize(paddedCount, 0.0f);
+	moveYArray.resize(paddedCount, 0.0f);
+	accelXArray.resize(paddedCount, 0.0f);
+	accelYArray.resize(paddedCount, 0.0f);
+	posXArray.resize(paddedCount, 0.0f);
+	posYArray.resize(paddedCount, 0.0f);
+	moveMaskArray.resize(paddedCount, 0);
+	manualMaskArray.resize(paddedCount, 0);
+	pathArray.resize(slotCount, nullptr);
+	pathCursorArray.resize(slotCount, 0);
+	generatorActiveArray.resize(slotCount, 0);
+	generatorArray.resize(slotCount);
+}
+
+#ifdef ACTION_ENABLE_BATCH_COMPARISON
+/**
+* ControllerBatchœANVsAʂƏԂr.
+*
+* XvCgiɂlisti % V[PXԖڂ̃V[PX蓖Ă.
+* ŏɗ1t[݂ɍXVčWƏŔrA
+* ɂꂼPƂframeCountt[XVďԂv.
+*
+* @param list        sANVXg.
+* @param spriteCount XvCg̐.
+* @param frameCount  XVt[.
+* @param delta       1t[̍XV(b).
+* @param result      rʂi[ϐ.
+*/
+void CompareBatch(const List& list, size_t spriteCount, int frameCount, float delta, BatchComparisonResult& result)
+{
+	result = BatchComparisonResult{};
+	if (list.list.empty() || spriteCount == 0 || frameCount <= 0) {
+		return;
+	}
+	const uint32_t seqCount = static_cast<uint32_t>(list.list.size());
+	std::vector<Sprite::Sprite> initialSprites;
+	initialSprites.reserve(spriteCount);
+	for (size_t i = 0; i < spriteCount; ++i) {
+		initialSprites.push_back(Sprite::Sprite(XMFLOAT3(static_cast<float>(i % 800), static_cast<float>(i % 600), 0.5f)));
+	}
+
+	// ʂ̔r.
+	{
+		std::vector<Sprite::Sprite> spriteA = initialSprites;
+		std::vector<Sprite::Sprite> spriteB = initialSprites;
+		std::vector<Controller> controllerList(spriteCount);
+		Batch batch;
+		batch.Reserve(spriteCount);
+		for (size_t i = 0; i < spriteCount; ++i) {
+			const uint32_t no = static_cast<uint32_t>(i % seqCount);
+			controllerList[i].SetList(&list, no);
+			batch.Add(&list, no, &spriteB[i]);
+		}
+		for (int frame = 0; frame < frameCount; ++frame) {
+			for (size_t i = 0; i < spriteCount; ++i) {
+				controllerList[i].Update(delta, &spriteA[i]);
+			}
+			batch.Update(delta);
+			for (size_t i = 0; i < spriteCount; ++i) {
+				result.maxPositionError = std::max(result.maxPositionError, DebugHelper::GetError(
+					XMFLOAT2(spriteA[i].pos.x, spriteA[i].pos.y), XMFLOAT2(spriteB[i].pos.x, spriteB[i].pos.y)));
+			}
+		}
+		for (size_t i = 0; i < spriteCount; ++i) {
+			if (controllerList[i].IsDeletable() != batch.IsDeletable(static_cast<uint32_t>(i))) {
+				++result.deletableMismatchCount;
+			}
+		}
+	}
+
+	// Ԃ̌v.
+	{
+		std::vector<Sprite::Sprite> sprites = initialSprites;
+		std::vector<Controller> controllerList(spriteCount);
+		for (size_t i = 0; i < spriteCount; ++i) {
+			controllerList[i].SetList(&list, static_cast<uint32_t>(i % seqCount));
+		}
+		result.controllerTime = DebugHelper::Measure(frameCount, [&]() {
+			for (size_t i = 0; i < spriteCount; ++i) {
+				controllerList[i].Update(delta, &sprites[i]);
+			}
+		});
+	}
+	{
+		std::vector<Sprite::Sprite> sprites = initialSprites;
+		Batch batch;
+		batch.Reserve(spriteCount);
+		for (size_t i = 0; i < spriteCount; ++i) {
+			batch.Add(&list, static_cast<uint32_t>(i % seqCount), &sprites[i]);
+		}
+		result.batchTime = DebugHelper::Measure(frameCount, [&]() { batch.Update(delta); });
+	}
+
+	char text[256];
+	snprintf(text, _countof(text), "Batch(%s, %u sprites, %d frames): controller=%.3fms batch=%.3fms err=%g deletable mismatch=%u\n",
+		list.name.c_str(), static_cast<uint32_t>(spriteCount), frameCount, result.controllerTime, result.batchTime,
+		result.maxPositionError, static_cast<uint32_t>(result.deletableMismatchCount));
+	Platform::DebugOutput(text);
+}
+#endif // ACTION_ENABLE_BATCH_COMPARISON
+
 /**
 * FileC^[tFCX̎NX.
 */
@@ -990,39 +2573,21 @@ public:
 *   ...
 * ]
 * </pre>
+*
+* "Path"(args: ړ, Rg[|Cg, ԕ@)̌ɂ́ARg[|Cg
+* "ControlPoint"(args: XW, YW)𑱂.
 */
 FilePtr LoadFromJsonFile(const wchar_t* filename)
 {
-	struct HandleHolder {
-		explicit HandleHolder(HANDLE h) : handle(h) {}
-		~HandleHolder() { if (handle != INVALID_HANDLE_VALUE) { CloseHandle(handle); } }
-		HANDLE handle;
-		operator HANDLE() { return handle; }
-		operator HANDLE() const { return handle; }
-	};
-
 	std::shared_ptr<FileImpl> af(new FileImpl);
 
-	HandleHolder h(CreateFileW(filename, GENERIC_READ, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
-	if (h == INVALID_HANDLE_VALUE) {
-		return af;
-	}
-	LARGE_INTEGER size;
-	if (!GetFileSizeEx(h, &size)) {
-		return af;
-	}
-	if (size.QuadPart > std::numeric_limits<size_t>::max()) {
-		return af;
-	}
-	std::vector<char> buffer;
-	buffer.resize(static_cast<size_t>(size.QuadPart));
-	DWORD readBytes;
-	if (!ReadFile(h, &buffer[0], buffer.size(), &readBytes, nullptr)) {
+	::File::BufferType buffer;
+	if (!::File::Read(filename, buffer)) {
 		return af;
 	}
 	const Json::Result result = Json::Parse(buffer.data(), buffer.data() + buffer.size());
 	if (!result.error.empty()) {
-		OutputDebugStringA(result.error.c_str());
+		Platform::DebugOutput(result.error.c_str());
 		return af;
 	}
 	const Json::Array& json = result.value.AsArray();
@@ -1056,6 +2621,8 @@ FilePtr LoadFromJsonFile(const wchar_t* filename)
 					{ "Generate", Type::Generation },
 					{ "Animation", Type::Animation },
 					{ "Delete", Type::Vanishing },
+					{ "Path", Type::Path },
+					{ "ControlPoint", Type::ControlPoint },
 				};
 				const auto itrTypePair = std::find(typeMap, typeMap + _countof(typeMap), obj.find("type")->second.AsString());
 				if (itrTypePair == typeMap + _countof(typeMap)) {
@@ -1070,6 +2637,10 @@ FilePtr LoadFromJsonFile(const wchar_t* filename)
 			}
 			al.list.push_back(as);
 		}
+		al.programList.resize(al.list.size());
+		for (size_t i = 0; i < al.list.size(); ++i) {
+			Compile(al.list[i], al.programList[i]);
+		}
 		af->actList.push_back(al);
 	}
 
@@ -8,9 +8,14 @@
 #include <vector>
 #include <string>
 #include <memory>
-#include <functional>
+#include <type_traits>
+#include <cstddef>
+#include <string.h>
 
 #define ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON
+//#define ACTION_ENABLE_SECTIONING_BENCHMARK // ACTIION_ENABLE_SECTIONING_METHOD_COMPARISONKv.
+//#define ACTION_ENABLE_BSPLINE_COMPARISON
+//#define ACTION_ENABLE_BATCH_COMPARISON
 
 namespace Sprite {
 struct Sprite;
@@ -49,25 +54,37 @@ union Code
 	float operand;
 };
 
+/**
+* xWFȐ̕ԏ.
+*/
+struct BezierSection {
+	float t; ///< Ԃ̎n_tl.
+	float unitT; ///< ԓ̒PʋɑΉt̑.
+};
+
+/**
+* xWFȐ̌ʒe[u.
+*
+* Ȑ𓙋̋Ԃɕ. p^[gSẴRg[[ŋL.
+*/
+struct BezierArcTable {
+	DirectX::XMFLOAT2 startOffset; ///< p^[̊W猩Ȑ̎n_.
+	float totalLength; ///< Ȑ̒.
+	std::vector<BezierSection> sectionList; ///< Ԃ̃Xg.
+};
+
 /**
 * ړp^[.
 */
 struct Pattern {
 	std::string name; ///< ړp^[.
 	std::vector<Code> data; ///< ړf[^z.
+	std::vector<BezierArcTable> arcTableList; ///< Bezier߂Ƃ̌ʒe[u. BuildBezierArcTable()ō쐬.
 };
 
 /// ړp^[Xg.
 typedef std::vector<Pattern> PatternList;
 
-/**
-* xWFȐ̕ԏ.
-*/
-struct BezierSection {
-	float t; ///< Ԃ̎n_tl.
-	float unitT; ///< ԓ̒PʋɑΉt̑.
-};
-
 /**
 * ړNX.
 */
@@ -83,9 +100,9 @@ public:
 	void Update(Sprite::Sprite& sprite, double delta);
 
 #ifdef ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON
-	void UseSimpsonsRule(bool b) { useSimpsonsRule = b; }
-	void SetSeparationCount(int n) { separationCount = n; }
-	void SetSectionCount(size_t n) { sectionCount = n; }
+	void UseSimpsonsRule(bool b) { useSimpsonsRule = b; useSharedTable = false; }
+	void SetSeparationCount(int n) { separationCount = n; useSharedTable = false; }
+	void SetSectionCount(size_t n) { sectionCount = n; useSharedTable = false; }
 #else
 	void UseSimpsonsRule(bool) {}
 	void SetSeparationCount(int) {}
@@ -93,7 +110,7 @@ public:
 #endif // ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON
 
 	bool IsFinished() const;
-	void Restart() { codeCounter = 0; }
+	void Restart();
 
 private:
 	const Pattern* pattern;
@@ -102,27 +119,106 @@ private:
 	DirectX::XMVECTOR startPos;
 	double time;
 
-	std::vector<BezierSection> sectionList;
+	size_t arcTableIndex; ///< ɎgLʒe[ũCfbNX.
+	const BezierArcTable* arcTable; ///< gp̋Lʒe[u. nullptrȂsectionListg.
+	std::vector<BezierSection> sectionList; ///< Le[ugȂꍇɍ쐬ԃXg.
 	float totalLength;
 #ifdef ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON
+	bool useSharedTable = true; ///< @ύXꍇfalseɂȂALe[ugȂȂ.
 	bool useSimpsonsRule = false;
 	size_t separationCount = 20;
 	size_t sectionCount = 32;
 #endif ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON
 };
 
+void BuildBezierArcTable(Pattern& pattern);
 PatternList CreateDefaultPatternList();
 
+#if defined(ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON) && defined(ACTION_ENABLE_SECTIONING_BENCHMARK)
+/**
+* xWFȐ̕@.
+*/
+enum class SectioningMethod
+{
+	NewtonLinear, ///< `Ԗ@Œ𑪂Aj[g@t߂.
+	NewtonSimpson, ///< Vv\@Œ𑪂Aj[g@t߂.
+	LengthTable, ///< ݐϒe[utt߂.
+};
+
+/**
+* xWFȐ̕@̔r.
+*/
+struct SectioningReport
+{
+	SectioningMethod method; ///< @.
+	size_t sectionCount; ///< ԕ.
+	size_t separationCount; ///< ̌v.
+	double buildTime; ///< 1Ȑ̋ԃXg쐬(}CNb).
+	double sampleTime; ///< 1Tv̍WvZ(imb).
+	float maxSpeedError; ///< ɑ΂鑬x̂̍ől(䗦).
+	float meanSpeedError; ///< ɑ΂鑬x̂̕ϒl(䗦).
+	size_t failedCurveCount; ///< ԃXg̍쐬ɎsȐ̐.
+};
+const char* GetSectioningMethodName(SectioningMethod method);
+void CompareSectioningMethods(const std::vector<size_t>& sectionCounts, const std::vector<size_t>& separationCounts,
+	size_t curveCount, size_t sampleCount, std::vector<SectioningReport>& result);
+#endif // ACTIION_ENABLE_SECTIONING_METHOD_COMPARISON && ACTION_ENABLE_SECTIONING_BENCHMARK
+
 } // namespace B
 
 struct List;
+struct Program;
 enum class Type;
-enum InterporationType;
+enum InterporationType : int;
 
 /**
-* IuWFNg֐^.
+* IuWFNg֐ێNX.
+*
+* ֐IuWFNgŒTCY̓obt@ɃRs[ĕێ.
+* std::functionƈăq[vmۂȂ̂ŁAG̏oƂɐ֐ݒ肵Ămۂ͋NȂ.
+* ێł̂capacityoCgȉ́AgrAɃRs[\Ȋ֐IuWFNgɌ.
+*
+* ^̊֐IuWFNgGetKind()lԂ̂ŁAނƂɂ܂Ƃ߂ČĂяoƂł.
 */
-typedef std::function<void(float, Sprite::Sprite*, float, float)> GeneratorType;
+class Generator
+{
+public:
+	static const size_t capacity = 64; ///< ێł֐IuWFNg̍őoCg.
+
+	/// ێĂ֐IuWFNgĂяo֐̌^.
+	typedef void(*InvokeFunc)(void*, float, Sprite::Sprite*, float, float);
+
+	Generator() : invoke(nullptr) {}
+	Generator(std::nullptr_t) : invoke(nullptr) {}
+	template<typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Generator>::value>::type>
+	Generator(const F& f) : invoke(&Invoke<F>)
+	{
+		static_assert(sizeof(F) <= capacity, "F is too large to store in Generator.");
+		static_assert(std::alignment_of<F>::value <= std::alignment_of<double>::value, "F is over-aligned.");
+		static_assert(std::is_trivially_copyable<F>::value, "F should be trivially copyable.");
+		memcpy(storage, &f, sizeof(F));
+	}
+
+	void operator()(float delta, Sprite::Sprite* sprite, float speed, float dir) { invoke(storage, delta, sprite, speed, dir); }
+	explicit operator bool() const { return invoke != nullptr; }
+	InvokeFunc GetKind() const { return invoke; }
+
+private:
+	template<typename F>
+	static void Invoke(void* p, float delta, Sprite::Sprite* sprite, float speed, float dir)
+	{
+		(*static_cast<F*>(p))(delta, sprite, speed, dir);
+	}
+
+	InvokeFunc invoke;
+	union {
+		double align;
+		uint8_t storage[capacity];
+	};
+};
+
+/// IuWFNg֐^.
+typedef Generator GeneratorType;
 
 /**
 * pX̂߂̃Rg[|Cg^.
@@ -143,12 +239,15 @@ public:
 	Controller(const List* l, uint32_t no = 0);
 	void SetList(const List*, uint32_t no = 0);
 	void SetGenerator(GeneratorType gen) { generator = gen; }
+	void UseTrack(bool b) { useTrack = b; }
 	void Update(float delta, Sprite::Sprite*);
 	void SetSeqIndex(uint32_t no);
 	void SetManualMove(float degree, float speed);
 	void SetManualMove(const DirectX::XMFLOAT2& m) { move = m; }
 	void SetManualAccel(float degree, float accel);
 	void SetTime(float time);
+	void Seek(float t, const DirectX::XMFLOAT2& origin, Sprite::Sprite* pSprite);
+	bool GetPositionAt(float t, const DirectX::XMFLOAT2& origin, DirectX::XMFLOAT2& pos) const;
 	const DirectX::XMFLOAT2& GetMove() const { return move; }
 	const DirectX::XMFLOAT2& GetAccel() const { return accel; }
 	float GetCurrentTime() const { return currentTime; }
@@ -159,6 +258,8 @@ public:
 private:
 	void Init(Sprite::Sprite* = nullptr);
 	void UpdateSub(float delta, Sprite::Sprite*);
+	void UpdateTrack(float delta, Sprite::Sprite*);
+	void ResetTrack();
 
 private:
 	const List* list;
@@ -172,13 +273,117 @@ private:
 	DirectX::XMFLOAT2 move;
 	DirectX::XMFLOAT2 accel;
 	struct PathParam {
-		std::vector<Point> cp;
+		const std::vector<Point>* cp; ///< RpCɍ쐬ASẴRg[[ŋLpX.
+		size_t cursor; ///< ݂̋Ԃ̏I_̃CfbNX.
 		InterporationType type;
 	} path;
 
 	bool isGeneratorActive;
 	GeneratorType generator;
+
+	bool useTrack; ///< trueȂAANVsɎOɍ쐬OՂĐ.
+	struct TrackState {
+		float time; ///< V[PXJňoߎ.
+		size_t keyCursor; ///< ݂̃L[t[̃CfbNX.
+		size_t eventCursor; ///< ɏCxg̃CfbNX.
+		DirectX::XMFLOAT2 origin; ///< V[PXJn̍W.
+		bool isOriginSet; ///< originݒς݂Ȃtrue.
+	} trackState;
+};
+
+/**
+* ̃ANV܂Ƃ߂ĎsNX.
+*
+* RpCς݂̃ANVV[PX(Program)gAControllerƓʂɂȂ悤ɓ삷.
+* W܂ފeXbg̏Ԃ͎ނƂ̘AzɊi[.
+* XV͈ړƃ}jA쒆̃Xbg4܂Ƃ߂ďA
+* pXړ⎟̃ANVւ̐؂ւȂǁAȊȌXbgƂɍs.
+* ŌɍWXvCg֏ނ̂ŁAXvCg̍W𒼐ڕύXASetPosition()g.
+*
+* Update()̓rŃXbgǉꍇÃXbg͎Update()XV.
+* ֐̓Xbgԍł͂ȂAGenerator::GetKind()̂܂Ƃ߂ŌĂяo.
+* OՂ̍Đ(Controller::UseTrack())ɂ͑ΉȂ.
+*/
+class Batch
+{
+public:
+	Batch() = default;
+	~Batch() = default;
+	Batch(const Batch&) = delete;
+	Batch& operator=(const Batch&) = delete;
+
+	void Reserve(size_t slotCount);
+	uint32_t Add(const List* l, uint32_t no, Sprite::Sprite* sprite);
+	void Remove(uint32_t slot);
+	void SetGenerator(uint32_t slot, GeneratorType gen) { generatorArray[slot] = gen; }
+	void SetPosition(uint32_t slot, const DirectX::XMFLOAT2& pos);
+	void SetManualMove(uint32_t slot, float degree, float speed);
+	void SetManualMove(uint32_t slot, const DirectX::XMFLOAT2& m) { moveXArray[slot] = m.x; moveYArray[slot] = m.y; }
+	void Update(float delta);
+	Sprite::Sprite* GetSprite(uint32_t slot) const { return spriteArray[slot]; }
+	DirectX::XMFLOAT2 GetPosition(uint32_t slot) const { return DirectX::XMFLOAT2(posXArray[slot], posYArray[slot]); }
+	DirectX::XMFLOAT2 GetMove(uint32_t slot) const { return DirectX::XMFLOAT2(moveXArray[slot], moveYArray[slot]); }
+	bool IsDeletable(uint32_t slot) const;
+
+private:
+	void Resize(size_t slotCount);
+	void Init(uint32_t slot, Sprite::Sprite* pSprite);
+	void UpdateSub(uint32_t slot, float delta);
+	void UpdateSlot(uint32_t slot, float delta);
+	void AdvanceStep(uint32_t slot);
+
+	std::vector<Sprite::Sprite*> spriteArray; ///< 䂷XvCg. nullptrȂ疢gp.
+	std::vector<const Program*> programArray; ///< svO.
+	std::vector<uint32_t> pcArray; ///< s̖߂̈ʒu.
+	std::vector<Type> typeArray; ///< ̎.
+	std::vector<float> currentTimeArray; ///< ̌oߎ.
+	std::vector<float> totalTimeArray; ///< ̎.
+	std::vector<float> moveXArray; ///< ړxX.
+	std::vector<float> moveYArray; ///< ړxY.
+	std::vector<float> accelXArray; ///< xX.
+	std::vector<float> accelYArray; ///< xY.
+	std::vector<float> posXArray; ///< WX.
+	std::vector<float> posYArray; ///< WY.
+	std::vector<uint32_t> moveMaskArray; ///< XVɎgAړ̃XbgȂ0xffffffff.
+	std::vector<uint32_t> manualMaskArray; ///< XVɎgA}jA쒆̃XbgȂ0xffffffff.
+	std::vector<const std::vector<Point>*> pathArray; ///< pXړŎgpX.
+	std::vector<uint32_t> pathCursorArray; ///< pX݂̌̋Ԃ̏I_̃CfbNX.
+	std::vector<uint8_t> generatorActiveArray; ///< ֐LȂ1.
+	std::vector<GeneratorType> generatorArray; ///< ֐.
+	std::vector<uint32_t> freeList; ///< gp̃Xbgԍ.
+	std::vector<uint32_t> moveList; ///< XVɎgAړ̃Xbgԍ.
+	std::vector<uint32_t> otherList; ///< XVɎgAȊÕXbgԍ.
+	std::vector<uint32_t> generatorList; ///< XVɎgA֐ĂяoXbgԍ.
+};
+
+#ifdef ACTION_ENABLE_BSPLINE_COMPARISON
+/**
+* BXvCW̐@̔r.
+*/
+struct BSplineComparisonResult
+{
+	double recursiveTime; ///< ċAł̏(~b).
+	double iterativeTime; ///< ł̏(~b).
+	double simdTime; ///< SIMDł̏(~b).
+	float maxIterativeError; ///< ċAłɑ΂锽ł̍ő덷.
+	float maxSimdError; ///< ċAłɑ΂SIMDł̍ő덷.
+};
+void CompareBSplineEvaluation(size_t pointCount, int repeat, BSplineComparisonResult& result);
+#endif // ACTION_ENABLE_BSPLINE_COMPARISON
+
+#ifdef ACTION_ENABLE_BATCH_COMPARISON
+/**
+* ControllerBatch̔r.
+*/
+struct BatchComparisonResult
+{
+	double controllerTime; ///< ControllerőSXvCg1t[XV鏈(~b).
+	double batchTime; ///< BatchőSXvCg1t[XV鏈(~b).
+	float maxPositionError; ///< Controlleřʂɑ΂ABatch̍W̍ő덷.
+	size_t deletableMismatchCount; ///< IsDeletable()̌ʂvȂXvCg̐.
 };
+void CompareBatch(const List& list, size_t spriteCount, int frameCount, float delta, BatchComparisonResult& result);
+#endif // ACTION_ENABLE_BATCH_COMPARISON
 
 /**
 * ̃ANVXg܂Ƃ߂IuWFNg𑀍삷邽߂̃C^[tFCXNX.
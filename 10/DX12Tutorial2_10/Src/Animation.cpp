@@ -3,11 +3,194 @@
 */
 #include "Animation.h"
 #include "Json.h"
-#include <windows.h>
+#include "File.h"
+#include "Platform.h"
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
 #include <map>
 #include <vector>
 #include <string>
 
+using namespace DirectX;
+
+namespace /* unnamed */ {
+
+/// LȃV[PXȂꍇɕԂAj[Vf[^.
+const AnimationData emptyData{};
+
+/**
+* V[PXɑΉݐώԕ\擾.
+*
+* @param list     Aj[VXg.
+* @param seqIndex V[PXCfbNX.
+*
+* @return seqIndexɑΉݐώԕ\. 쐬ĂȂnullptr.
+*/
+const AnimationTimeTable* FindTimeTable(const AnimationList& list, uint32_t seqIndex)
+{
+	if (seqIndex >= list.timeTableList.size() || list.timeTableList[seqIndex].startTime.empty()) {
+		return nullptr;
+	}
+	return &list.timeTableList[seqIndex];
+}
+
+/**
+* ݐώԕ\gāAV[PX擪̌oߎԂɑΉt[߂.
+*
+* @param table ݐώԕ\.
+* @param t     V[PX擪̌oߎ.
+* @param frame t[̃CfbNXi[ϐ.
+* @param time  t[̌oߎԂi[ϐ.
+*/
+void SeekFrame(const AnimationTimeTable& table, double t, uint32_t& frame, double& time)
+{
+	const std::vector<double>& startTime = table.startTime;
+	const size_t last = startTime.size() - 1;
+	t = std::max(0.0, t);
+	if (t >= startTime[last]) {
+		if (!table.isLoop) {
+			frame = table.stopIndex;
+			time = t - startTime[last];
+			return;
+		}
+		t = fmod(t, startTime[last]);
+	}
+	const std::vector<double>::const_iterator itr = std::upper_bound(startTime.begin(), startTime.end() - 1, t);
+	frame = static_cast<uint32_t>(itr - startTime.begin()) - 1;
+	time = t - startTime[frame];
+}
+
+/**
+* oߎԂ\Ԃ𒴂t[i߂.
+*
+* ʏ1t[i߂邾ōςނ߁A܂̃t[𒲂ׂ.
+* łȂꍇ́Aݐώԕ\Γ񕪒TŁAȂ1t[i߂.
+*
+* @param seq   Aj[VV[PX.
+* @param table seq̗ݐώԕ\. nullptȑꍇ1t[i߂.
+* @param frame ݂̃t[̃CfbNX. i߂̃CfbNXi[.
+* @param time  ݂̃t[̌oߎ. i߂̌oߎԂi[.
+*/
+void AdvanceFrame(const AnimationSequence& seq, const AnimationTimeTable* table, uint32_t& frame, double& time)
+{
+	for (int step = 0;; ++step) {
+		const float targetTime = seq[frame].time;
+		if (targetTime <= 0.0f || time < targetTime) {
+			return;
+		}
+		if (step > 0 && table && frame < table->stopIndex) {
+			SeekFrame(*table, table->startTime[frame] + time, frame, time);
+			return;
+		}
+		time -= targetTime;
+		++frame;
+		if (frame >= seq.size()) {
+			frame = 0;
+		}
+	}
+}
+
+/**
+* oߎԂɑΉTvOς݂̃Aj[Vf[^擾.
+*
+* @param list     Aj[VXg.
+* @param seqIndex V[PXCfbNX.
+* @param frame    ݂̃t[̃CfbNX.
+* @param time     ݂̃t[̌oߎ.
+*
+* @return oߎԂɑΉAj[Vf[^.
+*         TvO\ȂꍇA~t[ɓBĂꍇnullptr.
+*/
+const AnimationData* FindBakedSample(const AnimationList& list, uint32_t seqIndex, uint32_t frame, double time)
+{
+	if (seqIndex >= list.bakedCurveList.size() || list.bakedCurveList[seqIndex].sample.empty()) {
+		return nullptr;
+	}
+	const AnimationTimeTable* table = FindTimeTable(list, seqIndex);
+	if (!table || frame >= table->stopIndex) {
+		return nullptr;
+	}
+	const AnimationBakedCurve& curve = list.bakedCurveList[seqIndex];
+	const double t = table->startTime[frame] + time;
+	const size_t index = std::min(curve.sample.size() - 1, static_cast<size_t>(t * curve.rate));
+	return &curve.sample[index];
+}
+
+/**
+* V[PX̐擪̌oߎԂɑΉAj[Vf[^AL[t[Ԃċ߂.
+*
+* [vV[PXł͖̎擪ɂȂ. [vȂV[PXł͒~t[͒~t[ƂĈ.
+*
+* @param seq   Aj[VV[PX.
+* @param table seq̗ݐώԕ\.
+* @param t     V[PX̐擪̌oߎ.
+*
+* @return ԂAj[Vf[^. Zƕ\Ԃ͒ÕL[t[̂.
+*/
+AnimationData EvaluateCurve(const AnimationSequence& seq, const AnimationTimeTable& table, double t)
+{
+	uint32_t frame;
+	double time;
+	SeekFrame(table, t, frame, time);
+	const AnimationData& k1 = seq[frame];
+	if (frame >= table.stopIndex || k1.interpolation == AnimationInterpolation_Step) {
+		return k1;
+	}
+	const int64_t keyCount = table.isLoop ? static_cast<int64_t>(seq.size()) : static_cast<int64_t>(table.stopIndex) + 1;
+	const auto getKey = [&](int64_t i) -> const AnimationData& {
+		if (table.isLoop) {
+			return seq[static_cast<size_t>((i % keyCount + keyCount) % keyCount)];
+		}
+		return seq[static_cast<size_t>(std::max<int64_t>(0, std::min(keyCount - 1, i)))];
+	};
+	const AnimationData& k0 = getKey(static_cast<int64_t>(frame) - 1);
+	const AnimationData& k2 = getKey(static_cast<int64_t>(frame) + 1);
+	const AnimationData& k3 = getKey(static_cast<int64_t>(frame) + 2);
+	const float u = static_cast<float>(time / k1.time);
+
+	// ]Ɗg嗦AFꂼ1̃xNgɂ܂Ƃ߂ĕԂ.
+	const XMVECTOR rs0 = XMVectorSet(k0.rotation, k0.scale.x, k0.scale.y, 0);
+	const XMVECTOR rs1 = XMVectorSet(k1.rotation, k1.scale.x, k1.scale.y, 0);
+	const XMVECTOR rs2 = XMVectorSet(k2.rotation, k2.scale.x, k2.scale.y, 0);
+	const XMVECTOR rs3 = XMVectorSet(k3.rotation, k3.scale.x, k3.scale.y, 0);
+	XMVECTOR rs, color;
+	if (k1.interpolation == AnimationInterpolation_Cubic) {
+		rs = XMVectorCatmullRom(rs0, rs1, rs2, rs3, u);
+		color = XMVectorCatmullRom(XMLoadFloat4(&k0.color), XMLoadFloat4(&k1.color), XMLoadFloat4(&k2.color), XMLoadFloat4(&k3.color), u);
+	} else {
+		rs = XMVectorLerp(rs1, rs2, u);
+		color = XMVectorLerp(XMLoadFloat4(&k1.color), XMLoadFloat4(&k2.color), u);
+	}
+	AnimationData data = k1;
+	data.rotation = XMVectorGetX(rs);
+	data.scale = XMFLOAT2(XMVectorGetY(rs), XMVectorGetZ(rs));
+	XMStoreFloat4(&data.color, color);
+	return data;
+}
+
+/**
+* 2̃Aj[Vf[^́A]Eg嗦EF̍̍ől߂.
+*
+* @param a rAj[Vf[^.
+* @param b rAj[Vf[^.
+*
+* @return evf̍̐Βl̍ől.
+*/
+float MaxDifference(const AnimationData& a, const AnimationData& b)
+{
+	float d = fabs(a.rotation - b.rotation);
+	d = std::max(d, fabs(a.scale.x - b.scale.x));
+	d = std::max(d, fabs(a.scale.y - b.scale.y));
+	d = std::max(d, fabs(a.color.x - b.color.x));
+	d = std::max(d, fabs(a.color.y - b.color.y));
+	d = std::max(d, fabs(a.color.z - b.color.z));
+	d = std::max(d, fabs(a.color.w - b.color.w));
+	return d;
+}
+
+} // unnamed namespace
+
 /**
 * RXgN^.
 *
@@ -21,6 +204,69 @@ AnimationController::AnimationController(const AnimationList* al)
 {
 }
 
+/**
+* Rs[RXgN^.
+*
+* Rs[AnimationSystemɓo^ĂĂARs[͓o^Ȃ.
+* Xbg2̃Rg[[QƂƁȂ삪ɉeĂ܂.
+*
+* @param src Rs[̃Rg[[.
+*/
+AnimationController::AnimationController(const AnimationController& src)
+  : list(src.list)
+  , seqIndex(src.seqIndex)
+  , cellIndex(src.cellIndex)
+  , time(src.time)
+{
+	if (src.system) {
+		seqIndex = src.system->GetSeqIndex(src.slot);
+		cellIndex = src.system->GetFrameIndex(src.slot);
+		time = src.system->GetTime(src.slot);
+	}
+}
+
+/**
+* fXgN^.
+*
+* AnimationSystemɓo^Ă΁Ao^ăXbg󂯂.
+*/
+AnimationController::~AnimationController()
+{
+	if (system) {
+		system->Detach(slot, *this);
+	}
+}
+
+/**
+* Zq.
+*
+* 悪AnimationSystemɓo^ĂꍇȀԂœXbgɓo^.
+* Aj[VXgȂꍇ́Ao^͉.
+*
+* @param src ̃Rg[[.
+*
+* @return ̃Rg[[.
+*/
+AnimationController& AnimationController::operator=(const AnimationController& src)
+{
+	if (this == &src) {
+		return *this;
+	}
+	const AnimationController tmp(src);
+	AnimationSystem* const s = system;
+	if (s) {
+		s->Detach(slot, *this);
+	}
+	list = tmp.list;
+	seqIndex = tmp.seqIndex;
+	cellIndex = tmp.cellIndex;
+	time = tmp.time;
+	if (s) {
+		s->Attach(slot, *this);
+	}
+	return *this;
+}
+
 /**
 * Aj[VV[PX̃CfbNXݒ肷.
 *
@@ -28,6 +274,10 @@ AnimationController::AnimationController(const AnimationList* al)
 */
 void AnimationController::SetSeqIndex(uint32_t idx)
 {
+	if (system) {
+		system->SetSeqIndex(slot, idx);
+		return;
+	}
 	if (!list || idx >= list->list.size()) {
 		return;
 	}
@@ -50,26 +300,58 @@ void AnimationController::SetCellIndex(uint32_t index)
 /**
 * Aj[V̏ԂXV.
 *
+* oߎԂZ邾ŁAt[͎QƂ܂ŋ߂Ȃ.
+*
 * @param delta oߎ.
 */
 void AnimationController::Update(double delta)
 {
+	if (system) {
+		return;
+	}
 	if (!list || seqIndex >= list->list.size() || list->list[seqIndex].empty()) {
 		return;
 	}
 
 	time += delta;
-	for (;;) {
-		const float targetTime = list->list[seqIndex][cellIndex].time;
-		if (targetTime <= 0.0f || time < targetTime) {
-			break;
-		}
-		time -= targetTime;
-		++cellIndex;
-		if (cellIndex >= list->list[seqIndex].size()) {
-			cellIndex = 0;
-		}
+}
+
+/**
+* oߎԂɑΉt[߂.
+*
+* O񋁂߂t[̕\ԓȂ牽Ȃ.
+*/
+void AnimationController::Resolve() const
+{
+	if (!list || seqIndex >= list->list.size() || list->list[seqIndex].empty()) {
+		return;
 	}
+	AdvanceFrame(list->list[seqIndex], FindTimeTable(*list, seqIndex), cellIndex, time);
+}
+
+/**
+* V[PX̐擪w肵Ԃo߂Ԃɂ.
+*
+* ݐώԕ\Γ񕪒TŃt[߂.
+* Ȃꍇ́AQƂꂽƂɐ擪1t[i߂.
+*
+* @param t V[PX̐擪̌oߎ.
+*/
+void AnimationController::Seek(double t)
+{
+	if (system) {
+		system->Seek(slot, t);
+		return;
+	}
+	if (!list || seqIndex >= list->list.size() || list->list[seqIndex].empty()) {
+		return;
+	}
+	if (const AnimationTimeTable* table = FindTimeTable(*list, seqIndex)) {
+		SeekFrame(*table, t, cellIndex, time);
+		return;
+	}
+	cellIndex = 0;
+	time = std::max(0.0, t);
 }
 
 /**
@@ -79,18 +361,34 @@ void AnimationController::Update(double delta)
 */
 const AnimationData& AnimationController::GetData() const
 {
+	if (system) {
+		return system->GetData(slot);
+	}
 	if (!list) {
 		static AnimationData dummy{ 0, 0, 0, DirectX::XMFLOAT2(1, 1), DirectX::XMFLOAT4(1, 1, 1, 1)};
 		dummy.cellIndex = cellIndex;
 		return dummy;
 	}
 	if (seqIndex >= list->list.size() || list->list[seqIndex].empty()) {
-		static const AnimationData dummy{};
-		return dummy;
+		return emptyData;
+	}
+	Resolve();
+	if (const AnimationData* sample = FindBakedSample(*list, seqIndex, cellIndex, time)) {
+		return *sample;
 	}
 	return list->list[seqIndex][cellIndex];
 }
 
+/**
+* Aj[VV[PX̃CfbNX擾.
+*
+* @return V[PXCfbNX.
+*/
+uint32_t AnimationController::GetSeqIndex() const
+{
+	return system ? system->GetSeqIndex(slot) : seqIndex;
+}
+
 /**
 * Xg̃Aj[VV[PX̐擾.
 *
@@ -109,12 +407,336 @@ size_t AnimationController::GetSeqCount() const
 */
 bool AnimationController::IsFinished() const
 {
+	if (system) {
+		return system->IsFinished(slot);
+	}
 	if (!list || seqIndex >= list->list.size() || list->list[seqIndex].empty()) {
 		return true;
 	}
+	Resolve();
 	return list->list[seqIndex][cellIndex].time < 0;
 }
 
+/**
+* Xbg\񂷂.
+*
+* @param slotCount \񂷂Xbg. ̐l܂ł͒ǉ̃mۂNȂ.
+*/
+void AnimationSystem::Reserve(size_t slotCount)
+{
+	const size_t paddedCount = (slotCount + 3) & ~static_cast<size_t>(3);
+	listArray.reserve(slotCount);
+	seqArray.reserve(slotCount);
+	frameArray.reserve(slotCount);
+	dataArray.reserve(slotCount);
+	timeArray.reserve(paddedCount);
+	durationArray.reserve(paddedCount);
+}
+
+/**
+* Rg[[Xbgɓo^.
+*
+* Rg[[݂̌̏ԂXbgɃRs[AȌ̓XbgŏԂǗ.
+* Aj[VXgȂRg[[͓o^Ȃ.
+*
+* @param slot       o^̃Xbgԍ.
+* @param controller o^Rg[[.
+*/
+void AnimationSystem::Attach(uint32_t slot, AnimationController& controller)
+{
+	if (!controller.list || controller.system) {
+		return;
+	}
+	controller.Resolve();
+	if (slot >= listArray.size()) {
+		Resize(slot + 1);
+	}
+	listArray[slot] = controller.list;
+	seqArray[slot] = controller.seqIndex;
+	frameArray[slot] = controller.cellIndex;
+	timeArray[slot] = static_cast<float>(controller.time);
+	if (controller.seqIndex < controller.list->list.size() && controller.cellIndex >= controller.list->list[controller.seqIndex].size()) {
+		frameArray[slot] = 0;
+	}
+	Resolve(slot);
+	controller.system = this;
+	controller.slot = slot;
+}
+
+/**
+* Rg[[XbgO.
+*
+* Xbg̏ԂRg[[ɏ߂AXbg𖢎gpɂ.
+*
+* @param slot       Rg[[o^ĂXbgԍ.
+* @param controller o^Rg[[.
+*/
+void AnimationSystem::Detach(uint32_t slot, AnimationController& controller)
+{
+	if (slot >= listArray.size()) {
+		return;
+	}
+	if (controller.system == this && controller.slot == slot) {
+		controller.seqIndex = seqArray[slot];
+		controller.cellIndex = frameArray[slot];
+		controller.time = timeArray[slot];
+		controller.system = nullptr;
+	}
+	listArray[slot] = nullptr;
+	timeArray[slot] = 0;
+	Resolve(slot);
+}
+
+/**
+* SẴXbg̃Aj[VXV.
+*
+* @param delta oߎ.
+*/
+void AnimationSystem::Update(double delta)
+{
+	const XMVECTOR vdelta = XMVectorReplicate(static_cast<float>(delta));
+	const XMVECTOR vzero = XMVectorZero();
+	for (size_t i = 0; i < timeArray.size(); i += 4) {
+		XMFLOAT4* pTime = reinterpret_cast<XMFLOAT4*>(&timeArray[i]);
+		const XMVECTOR t = XMVectorAdd(XMLoadFloat4(pTime), vdelta);
+		XMStoreFloat4(pTime, t);
+		const XMVECTOR d = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&durationArray[i]));
+		const XMVECTOR mask = XMVectorAndInt(XMVectorGreaterOrEqual(t, d), XMVectorGreater(d, vzero));
+		if (XMVector4EqualInt(mask, XMVectorFalseInt())) {
+			continue;
+		}
+		for (size_t n = i; n < i + 4; ++n) {
+			if (durationArray[n] > 0.0f && timeArray[n] >= durationArray[n]) {
+				Advance(static_cast<uint32_t>(n));
+			}
+		}
+	}
+}
+
+/**
+* Xbg̃Aj[VV[PXݒ肷.
+*
+* @param slot Xbgԍ.
+* @param idx  ݒ肷V[PXCfbNX.
+*/
+void AnimationSystem::SetSeqIndex(uint32_t slot, uint32_t idx)
+{
+	const AnimationList* list = listArray[slot];
+	if (!list || idx >= list->list.size()) {
+		return;
+	}
+	seqArray[slot] = idx;
+	frameArray[slot] = 0;
+	timeArray[slot] = 0;
+	Resolve(slot);
+}
+
+/**
+* Xbg̃Aj[VAV[PX̐擪w肵Ԃo߂Ԃɂ.
+*
+* @param slot Xbgԍ.
+* @param t    V[PX̐擪̌oߎ.
+*/
+void AnimationSystem::Seek(uint32_t slot, double t)
+{
+	const AnimationList* list = listArray[slot];
+	if (!list || seqArray[slot] >= list->list.size() || list->list[seqArray[slot]].empty()) {
+		return;
+	}
+	uint32_t frame = 0;
+	double time = std::max(0.0, t);
+	if (const AnimationTimeTable* table = FindTimeTable(*list, seqArray[slot])) {
+		SeekFrame(*table, t, frame, time);
+	} else {
+		AdvanceFrame(list->list[seqArray[slot]], nullptr, frame, time);
+	}
+	frameArray[slot] = frame;
+	timeArray[slot] = static_cast<float>(time);
+	Resolve(slot);
+}
+
+/**
+* Xbg̃Aj[Vf[^擾.
+*
+* @param slot Xbgԍ.
+*
+* @return Aj[Vf[^.
+*/
+const AnimationData& AnimationSystem::GetData(uint32_t slot) const
+{
+	if (listArray[slot]) {
+		if (const AnimationData* sample = FindBakedSample(*listArray[slot], seqArray[slot], frameArray[slot], timeArray[slot])) {
+			return *sample;
+		}
+	}
+	return *dataArray[slot];
+}
+
+/**
+* Xbg̃Aj[VIĂ邩ׂ.
+*
+* @param slot Xbgԍ.
+*
+* @retval true  IĂ.
+* @retval false Đ.
+*/
+bool AnimationSystem::IsFinished(uint32_t slot) const
+{
+	return dataArray[slot] == &emptyData || dataArray[slot]->time < 0;
+}
+
+/**
+* XbgύX.
+*
+* oߎԂƕ\Ԃ̔źASIMD4Xbgł悤4̔{ɐ؂グ.
+* ]ȗvf̕\Ԃ0Ȃ̂ŁAt[̐؂ւ͋NȂ.
+*
+* @param slotCount VXbg.
+*/
+void AnimationSystem::Resize(size_t slotCount)
+{
+	const size_t paddedCount = (slotCount + 3) & ~static_cast<size_t>(3);
+	listArray.resize(slotCount, nullptr);
+	seqArray.resize(slotCount, 0);
+	frameArray.resize(slotCount, 0);
+	dataArray.resize(slotCount, &emptyData);
+	timeArray.resize(paddedCount, 0.0f);
+	durationArray.resize(paddedCount, 0.0f);
+}
+
+/**
+* \Ԃ𒴂Xbg̃t[i߂.
+*
+* @param slot Xbgԍ.
+*/
+void AnimationSystem::Advance(uint32_t slot)
+{
+	const AnimationList& list = *listArray[slot];
+	uint32_t frame = frameArray[slot];
+	double time = timeArray[slot];
+	AdvanceFrame(list.list[seqArray[slot]], FindTimeTable(list, seqArray[slot]), frame, time);
+	frameArray[slot] = frame;
+	timeArray[slot] = static_cast<float>(time);
+	Resolve(slot);
+}
+
+/**
+* Xbǧ݂̃t[ɑΉAj[Vf[^ƕ\Ԃ߂.
+*
+* @param slot Xbgԍ.
+*/
+void AnimationSystem::Resolve(uint32_t slot)
+{
+	const AnimationList* list = listArray[slot];
+	if (!list || seqArray[slot] >= list->list.size() || list->list[seqArray[slot]].empty()) {
+		dataArray[slot] = &emptyData;
+		durationArray[slot] = 0;
+		return;
+	}
+	const AnimationData& data = list->list[seqArray[slot]][frameArray[slot]];
+	dataArray[slot] = &data;
+	durationArray[slot] = data.time;
+}
+
+/**
+* Aj[VXg̑SẴV[PXɂėݐώԕ\쐬.
+*
+* LoadAnimationFromJsonFile()œǂݍ񂾃Xgɂ͍쐬ς.
+* V[PX̓eύXꍇ́Å֐ō蒼.
+*
+* @param al ݐώԕ\쐬Aj[VXg.
+*/
+void BuildAnimationTimeTable(AnimationList& al)
+{
+	al.timeTableList.resize(al.list.size());
+	for (size_t i = 0; i < al.list.size(); ++i) {
+		const AnimationSequence& seq = al.list[i];
+		AnimationTimeTable& table = al.timeTableList[i];
+		table.startTime.clear();
+		table.stopIndex = static_cast<uint32_t>(seq.size());
+		table.isLoop = true;
+		if (seq.empty()) {
+			continue;
+		}
+		double t = 0;
+		table.startTime.reserve(seq.size() + 1);
+		table.startTime.push_back(t);
+		for (size_t frame = 0; frame < seq.size(); ++frame) {
+			if (seq[frame].time <= 0.0f) {
+				table.stopIndex = static_cast<uint32_t>(frame);
+				table.isLoop = false;
+				break;
+			}
+			t += seq[frame].time;
+			table.startTime.push_back(t);
+		}
+	}
+}
+
+/**
+* ԕt̃V[PXԊuŃTvO\쐬.
+*
+* ԕ@AnimationInterpolation_StepȊÕL[t[܂ރV[PXΏۂɂȂ.
+* ݐώԕ\쐬ĂȂ΁Aɍ쐬.
+*
+* eTvԂ̒ŐmȕԒlƔrA\̌덷ƁAԂȂꍇ̌덷߂.
+*
+* @param al   TvO\쐬Aj[VXg.
+* @param rate 1b̃Tv.
+*
+* @return xCN.
+*/
+AnimationBakeReport BakeAnimationCurve(AnimationList& al, float rate)
+{
+	AnimationBakeReport report = {};
+	if (al.timeTableList.size() < al.list.size()) {
+		BuildAnimationTimeTable(al);
+	}
+	al.bakedCurveList.resize(al.list.size());
+	for (size_t i = 0; i < al.list.size(); ++i) {
+		const AnimationSequence& seq = al.list[i];
+		const AnimationTimeTable& table = al.timeTableList[i];
+		AnimationBakedCurve& curve = al.bakedCurveList[i];
+		curve.rate = rate;
+		curve.sample.clear();
+		report.keyBytes += seq.size() * sizeof(AnimationData);
+		if (table.startTime.empty() || rate <= 0.0f) {
+			continue;
+		}
+		bool hasCurve = false;
+		for (uint32_t frame = 0; frame < table.stopIndex; ++frame) {
+			if (seq[frame].interpolation != AnimationInterpolation_Step) {
+				hasCurve = true;
+				break;
+			}
+		}
+		if (!hasCurve) {
+			continue;
+		}
+		const double duration = table.startTime.back();
+		const size_t sampleCount = std::max<size_t>(1, static_cast<size_t>(ceil(duration * rate)));
+		curve.sample.resize(sampleCount);
+		for (size_t n = 0; n < sampleCount; ++n) {
+			curve.sample[n] = EvaluateCurve(seq, table, static_cast<double>(n) / rate);
+		}
+		report.bakedBytes += sampleCount * sizeof(AnimationData);
+
+		for (size_t n = 0; n < sampleCount; ++n) {
+			const double t = (static_cast<double>(n) + 0.5) / rate;
+			if (t >= duration) {
+				break;
+			}
+			const AnimationData exact = EvaluateCurve(seq, table, t);
+			uint32_t frame;
+			double time;
+			SeekFrame(table, t, frame, time);
+			report.maxBakedError = std::max(report.maxBakedError, MaxDifference(exact, curve.sample[n]));
+			report.maxSteppedError = std::max(report.maxSteppedError, MaxDifference(exact, seq[frame]));
+		}
+	}
+	return report;
+}
+
 /**
 * t@CAj[VXgǂݍ.
 *
@@ -135,7 +757,8 @@ bool AnimationController::IsFinished() const
 *           "time" : duration time,
 *           "rotation" : rotation radian,
 *           "scale" : [x, y],
-*           "color" : [r, g, b, a]
+*           "color" : [r, g, b, a],
+*           "interpolation" : "step" or "linear" or "cubic" (ȗ"step")
 *         },
 *         ...
 *       ],
@@ -147,34 +770,13 @@ bool AnimationController::IsFinished() const
 */
 AnimationFile LoadAnimationFromJsonFile(const wchar_t* filename)
 {
-	struct HandleHolder {
-		explicit HandleHolder(HANDLE h) : handle(h) {}
-		~HandleHolder() { if (handle != INVALID_HANDLE_VALUE) { CloseHandle(handle); } }
-		HANDLE handle;
-		operator HANDLE() { return handle; }
-		operator HANDLE() const { return handle; }
-	};
-
-	HandleHolder h(CreateFileW(filename, GENERIC_READ, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
-	if (h == INVALID_HANDLE_VALUE) {
-		return {};
-	}
-	LARGE_INTEGER size;
-	if (!GetFileSizeEx(h, &size)) {
-		return {};
-	}
-	if (size.QuadPart > std::numeric_limits<size_t>::max()) {
-		return {};
-	}
-	std::vector<char> buffer;
-	buffer.resize(static_cast<size_t>(size.QuadPart));
-	DWORD readBytes;
-	if (!ReadFile(h, &buffer[0], buffer.size(), &readBytes, nullptr)) {
+	File::BufferType buffer;
+	if (!File::Read(filename, buffer)) {
 		return {};
 	}
 	const Json::Result result = Json::Parse(buffer.data(), buffer.data() + buffer.size());
 	if (!result.error.empty()) {
-		OutputDebugStringA(result.error.c_str());
+		Platform::DebugOutput(result.error.c_str());
 		return {};
 	}
 	AnimationFile af;
@@ -224,10 +826,31 @@ AnimationFile LoadAnimationFromJsonFile(const wchar_t* filename)
 					ad.color.z = static_cast<float>(color[2].AsNumber());
 					ad.color.w = static_cast<float>(color[3].AsNumber());
 				}
+				ad.interpolation = AnimationInterpolation_Step;
+				{
+					auto itr = obj.find("interpolation");
+					if (itr != obj.end()) {
+						const std::string& type = itr->second.AsString();
+						if (type == "linear") {
+							ad.interpolation = AnimationInterpolation_Linear;
+						} else if (type == "cubic") {
+							ad.interpolation = AnimationInterpolation_Cubic;
+						}
+					}
+				}
 				as.push_back(ad);
 			}
 			al.list.push_back(as);
 		}
+		BuildAnimationTimeTable(al);
+		const AnimationBakeReport report = BakeAnimationCurve(al);
+		if (report.bakedBytes) {
+			char text[256];
+			snprintf(text, _countof(text), "%s: keyframe=%uB baked=%uB error(baked/stepped)=%.4f/%.4f\n",
+				al.name.c_str(), static_cast<uint32_t>(report.keyBytes), static_cast<uint32_t>(report.bakedBytes),
+				report.maxBakedError, report.maxSteppedError);
+			Platform::DebugOutput(text);
+		}
 		af.push_back(al);
 	}
 
@@ -5,8 +5,19 @@
 #define DX12TUTORIAL_SRC_ANIMATION_H_
 #include <DirectXMath.h>
 #include <vector>
+#include <string>
 #include <stdint.h>
 
+/**
+* L[t[Ԃ̕ԕ@.
+*/
+enum AnimationInterpolation
+{
+	AnimationInterpolation_Step, ///< ̃L[t[܂ŒlςȂ.
+	AnimationInterpolation_Linear, ///< ̃L[t[܂ŒԂ.
+	AnimationInterpolation_Cubic, ///< ÕL[t[g3Ԃ(Catmull-Rom).
+};
+
 /**
 * Aj[Vf[^.
 */
@@ -17,6 +28,7 @@ struct AnimationData
 	float rotation; ///< 摜̉]p(WA).
 	DirectX::XMFLOAT2 scale; ///< 摜̊g嗦.
 	DirectX::XMFLOAT4 color; ///< 摜̐F.
+	uint32_t interpolation; ///< ̃L[t[܂ł̕ԕ@(AnimationInterpolation). Z͕ԂȂ.
 };
 
 /**
@@ -24,6 +36,44 @@ struct AnimationData
 */
 typedef std::vector<AnimationData> AnimationSequence;
 
+/**
+* Aj[VV[PX̗ݐώԕ\.
+*
+* et[̊JnێACӂ̎̃t[񕪒Tŋ߂悤ɂ.
+* \Ԃ0ȉ̃t[ɓBƃAj[V͂Œ~邽߁A
+* \͂̃t[܂łȂ.
+*/
+struct AnimationTimeTable
+{
+	std::vector<double> startTime; ///< et[̊Jn. vfstopIndex+1.
+	uint32_t stopIndex; ///< \Ԃ0ȉ̍ŏ̃t[. ݂Ȃ΃t[.
+	bool isLoop; ///< ~t[Ȃtrue. ̂Ƃ̊Jn1̎ԂɂȂ.
+};
+
+/**
+* ԕtV[PXԊuŃTvO\.
+*
+* s̓L[t[TԂ肹AoߎԂ狁߂Yŕ\ɂ.
+*/
+struct AnimationBakedCurve
+{
+	float rate; ///< 1b̃Tv.
+	std::vector<AnimationData> sample; ///< TvOAj[Vf[^. ȂԂL[t[̂܂܎g.
+};
+
+/**
+* Aj[VԂ̃xCN.
+*
+* ԂԂȂ̃L[t[ŕ\ꍇƔׂ邽߂̏.
+*/
+struct AnimationBakeReport
+{
+	size_t keyBytes; ///< L[t[̃oCg.
+	size_t bakedBytes; ///< TvO\̃oCg.
+	float maxBakedError; ///< mȕԒlɑ΂A\̒l̍ő덷.
+	float maxSteppedError; ///< mȕԒlɑ΂AԂȂL[t[̒l̍ő덷.
+};
+
 /**
 * Aj[VV[PX̃Xg.
 *
@@ -33,41 +83,114 @@ struct AnimationList
 {
 	std::string name;
 	std::vector<AnimationSequence> list;
+	std::vector<AnimationTimeTable> timeTableList; ///< listƓт̗ݐώԕ\. BuildAnimationTimeTable()ō쐬.
+	std::vector<AnimationBakedCurve> bakedCurveList; ///< listƓт̃TvO\. BakeAnimationCurve()ō쐬.
 };
 
+void BuildAnimationTimeTable(AnimationList& al);
+AnimationBakeReport BakeAnimationCurve(AnimationList& al, float rate = 60.0f);
+
 /**
 * Aj[VXg̃Xg.
 */
 typedef std::vector<AnimationList> AnimationFile;
 
+class AnimationSystem;
+
 /**
 * Aj[VNX.
+*
+* Update()͌oߎԂZ邾ŁAt[GetData()IsFinished()ŎQƂꂽƂɋ߂.
+* ̂߁AʊOȂǂŎQƂȂAj[V̓V[PXǂ鏈Ȃ.
+*
+* AnimationSystemɓo^ĂԂ́AԂAnimationSystemǗ.
+* ̂ƂUpdate()͉Ȃ̊֐AnimationSystem̏Ԃǂݏ.
+*
+* o^ꂽRg[[Rs[ƁARs[͂̎_̏Ԃo^̃Rg[[ɂȂ.
+* o^ꂽRg[[ɑꍇ́Ao^ێ܂ܑ̏ԂXbgɐݒ肷.
+* o^ꂽ܂ܔjꂽRg[[́AIɓo^.
+* ̂߁AAnimationSystem̓Rg[[ɔjȂ΂ȂȂ.
 */
 class AnimationController
 {
 public:
 	AnimationController() = default;
     explicit AnimationController(const AnimationList* list);
-    AnimationController(const AnimationController&) = default;
-	AnimationController& operator=(const AnimationController& src) {
-		this->~AnimationController();
-		new(this) AnimationController(src);
-		return *this;
-	}
+	AnimationController(const AnimationController& src);
+	~AnimationController();
+	AnimationController& operator=(const AnimationController& src);
 
 	void SetSeqIndex(uint32_t no);
 	void SetCellIndex(uint32_t index);
 	void Update(double delta);
+	void Seek(double t);
 	const AnimationData& GetData() const;
 	size_t GetSeqCount() const;
-	uint32_t GetSeqIndex() const { return seqIndex; }
+	uint32_t GetSeqIndex() const;
 	bool IsFinished() const;
+	bool IsBound() const { return system != nullptr; }
 
 private:
+	friend class AnimationSystem;
+
+	void Resolve() const;
+
 	const AnimationList* list = nullptr;
 	uint32_t seqIndex = 0;
-	uint32_t cellIndex = 0;
-	double time = 0;
+	mutable uint32_t cellIndex = 0; ///< ŌɃt[߂Ƃ̃t[.
+	mutable double time = 0; ///< cellIndex̃t[̊Jňoߎ. t[̕\Ԃ𒴂Ă邱Ƃ.
+	AnimationSystem* system = nullptr; ///< ԂǗĂAj[VVXe.
+	uint32_t slot = 0; ///< Aj[VVXẽXbgԍ.
+};
+
+/**
+* ̃Aj[V܂Ƃ߂čXVNX.
+*
+* Rg[[̏(XgAV[PXAt[Aoߎ)ނƂ̘AzɊi[A
+* 1̃[vőSẴAj[VXV.
+* oߎԂ̉Zƃt[؂ւ̔4XbgSIMDōsA
+* t[؂ւXbgʂɏ.
+*
+* eXbgɂ́Ã݂t[̃Aj[Vf[^ւ̃|C^ێĂ.
+* o^ꂽRg[[GetData()͂̃|C^ԂȂ̂ŁA
+* `掞ɃV[PX̔zǂKvȂ.
+*
+* 1̃XbgQƂRg[[͏1. Rs[Rg[[͓o^Ȃ.
+* o^Rg[[i[źAo^Oɑ傫m肳Ă.
+*/
+class AnimationSystem
+{
+public:
+	AnimationSystem() = default;
+	~AnimationSystem() = default;
+	AnimationSystem(const AnimationSystem&) = delete;
+	AnimationSystem& operator=(const AnimationSystem&) = delete;
+
+	void Reserve(size_t slotCount);
+	void Attach(uint32_t slot, AnimationController& controller);
+	void Detach(uint32_t slot, AnimationController& controller);
+	void Update(double delta);
+
+	void SetSeqIndex(uint32_t slot, uint32_t idx);
+	void Seek(uint32_t slot, double t);
+	const AnimationData& GetData(uint32_t slot) const;
+	const AnimationList* GetList(uint32_t slot) const { return listArray[slot]; }
+	uint32_t GetSeqIndex(uint32_t slot) const { return seqArray[slot]; }
+	uint32_t GetFrameIndex(uint32_t slot) const { return frameArray[slot]; }
+	float GetTime(uint32_t slot) const { return timeArray[slot]; }
+	bool IsFinished(uint32_t slot) const;
+
+private:
+	void Resize(size_t slotCount);
+	void Advance(uint32_t slot);
+	void Resolve(uint32_t slot);
+
+	std::vector<const AnimationList*> listArray; ///< Aj[VXg. nullptrȂ疢gp.
+	std::vector<uint32_t> seqArray; ///< V[PX̃CfbNX.
+	std::vector<uint32_t> frameArray; ///< t[̃CfbNX.
+	std::vector<float> timeArray; ///< ݂̃t[̌oߎ. vf4̔{.
+	std::vector<float> durationArray; ///< ݂̃t[̕\. 0ȉȂ؂ւȂ. vf4̔{.
+	std::vector<const AnimationData*> dataArray; ///< ݂̃t[̃Aj[Vf[^.
 };
 
 const AnimationList& GetAnimationList();
@@ -0,0 +1,244 @@
+/**
+* @file Atlas.cpp
+*/
+#include "Atlas.h"
+#include <algorithm>
+#include <limits>
+
+using namespace DirectX;
+
+namespace Sprite {
+
+namespace /* unnamed */ {
+
+/**
+* nȏōŏ2ׂ̂߂.
+*/
+uint32_t RoundUpToPowerOfTwo(uint32_t n)
+{
+	uint32_t result = 1;
+	while (result < n) {
+		result <<= 1;
+	}
+	return result;
+}
+
+} // unnamed namespace
+
+/**
+* RXgN^.
+*
+* @param maxWidth  ܂Ƃ߂摜̕.
+* @param maxHeight ܂Ƃ߂摜̍ő̍.
+*                  ۂ̍́ASẲ摜܂2ׂ̂̒lɐ؂l߂.
+* @param padding   摜̎͂ɐ݂]̃sNZ.
+*/
+AtlasBuilder::AtlasBuilder(uint32_t w, uint32_t h, uint32_t p) :
+	maxWidth(w),
+	maxHeight(h),
+	padding(p)
+{
+}
+
+/**
+* ܂Ƃ߂摜o^.
+*
+* ZXg𕡐o^ƁABuild()ŕ񏑂Ă܂̂Œ.
+* 摜ƃZXgBuild()I܂ŔjȂ.
+*
+* @param image     ܂Ƃ߂摜.
+* @param cellLists imageQƂZXg̔z.
+*/
+void AtlasBuilder::Add(const Image& image, const std::vector<CellList*>& cellLists)
+{
+	if (image.data.empty()) {
+		return;
+	}
+	entryList.push_back(Entry{ &image, cellLists, 0, 0 });
+}
+
+/**
+* o^ꂽ摜1̉摜ɂ܂Ƃ߂.
+*
+* @param page ܂Ƃ߂摜i[IuWFNg.
+*
+* @retval true  SẲ摜܂Ƃ߁AZXg.
+* @retval false 摜܂Ȃ. ZXg͏Ȃ.
+*/
+bool AtlasBuilder::Build(Image& page)
+{
+	if (entryList.empty()) {
+		return false;
+	}
+
+	// ̑傫ɔzuƁAXJCC̉ʂȂȂlߍ݌ǂȂ.
+	std::vector<size_t> order;
+	order.reserve(entryList.size());
+	for (size_t i = 0; i < entryList.size(); ++i) {
+		order.push_back(i);
+	}
+	std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+		const Image& a = *entryList[lhs].image;
+		const Image& b = *entryList[rhs].image;
+		return a.height != b.height ? a.height > b.height : a.width > b.width;
+	});
+
+	skyline.clear();
+	skyline.push_back(SkylineNode{ 0, 0, maxWidth });
+	uint32_t usedHeight = 0;
+	for (size_t i : order) {
+		Entry& e = entryList[i];
+		const uint32_t w = e.image->width + padding * 2;
+		const uint32_t h = e.image->height + padding * 2;
+		if (!Insert(w, h, e.x, e.y)) {
+			OutputDebugStringA("ERROR: AtlasBuilder: 摜܂܂.\n");
+			return false;
+		}
+		usedHeight = std::max(usedHeight, e.y + h);
+	}
+
+	page.width = maxWidth;
+	page.height = std::min(RoundUpToPowerOfTwo(usedHeight), maxHeight);
+	page.data.assign(page.width * page.height, 0);
+	for (const Entry& e : entryList) {
+		Blit(page, e);
+	}
+	for (const Entry& e : entryList) {
+		RemapCell(page, e);
+	}
+	return true;
+}
+
+/**
+* XJCCɋ`zu.
+*
+* zu\ȈʒûAł(YW)̈ʒuI.
+* ̌₪ꍇ́AyƂȂZIŌԂ炷.
+*
+* @param width  zu`̕.
+* @param height zu`̍.
+* @param x      zuʒuXWi[ϐ.
+* @param y      zuʒuYWi[ϐ.
+*
+* @retval true  zu.
+* @retval false zułꏊȂ.
+*/
+bool AtlasBuilder::Insert(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y)
+{
+	size_t bestIndex = std::numeric_limits<size_t>::max();
+	uint32_t bestY = std::numeric_limits<uint32_t>::max();
+	uint32_t bestWidth = std::numeric_limits<uint32_t>::max();
+	for (size_t i = 0; i < skyline.size(); ++i) {
+		if (skyline[i].x + width > maxWidth) {
+			break;
+		}
+		// `̉ɂ̂AłႢʒuɂ̂`̒ɂȂ.
+		uint32_t top = 0;
+		uint32_t remaining = width;
+		for (size_t j = i; j < skyline.size(); ++j) {
+			top = std::max(top, skyline[j].y);
+			if (skyline[j].width >= remaining) {
+				break;
+			}
+			remaining -= skyline[j].width;
+		}
+		if (top + height > maxHeight) {
+			continue;
+		}
+		if (top < bestY || (top == bestY && skyline[i].width < bestWidth)) {
+			bestIndex = i;
+			bestY = top;
+			bestWidth = skyline[i].width;
+		}
+	}
+	if (bestIndex == std::numeric_limits<size_t>::max()) {
+		return false;
+	}
+
+	const SkylineNode node{ skyline[bestIndex].x, bestY + height, width };
+	skyline.insert(skyline.begin() + bestIndex, node);
+
+	// VɉBꂽ.
+	const uint32_t nodeRight = node.x + node.width;
+	for (size_t i = bestIndex + 1; i < skyline.size();) {
+		if (skyline[i].x >= nodeRight) {
+			break;
+		}
+		const uint32_t shrink = nodeRight - skyline[i].x;
+		if (skyline[i].width <= shrink) {
+			skyline.erase(skyline.begin() + i);
+			continue;
+		}
+		skyline[i].x += shrink;
+		skyline[i].width -= shrink;
+		break;
+	}
+
+	// ŗׂ荇.
+	for (size_t i = 0; i + 1 < skyline.size();) {
+		if (skyline[i].y == skyline[i + 1].y) {
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		} else {
+			++i;
+		}
+	}
+
+	x = node.x;
+	y = bestY;
+	return true;
+}
+
+/**
+* 摜܂Ƃ߂摜ɏ݁A̗͂]ɒ[̃sNZ𕡐.
+*
+* @param page  ݐ̉摜.
+* @param entry މ摜̏.
+*/
+void AtlasBuilder::Blit(Image& page, const Entry& entry) const
+{
+	const Image& src = *entry.image;
+	const uint32_t ox = entry.x + padding;
+	const uint32_t oy = entry.y + padding;
+	for (uint32_t y = 0; y < src.height; ++y) {
+		const uint32_t* s = &src.data[y * src.width];
+		uint32_t* d = &page.data[(oy + y) * page.width + ox];
+		std::copy(s, s + src.width, d);
+		std::fill(d - padding, d, s[0]);
+		std::fill(d + src.width, d + src.width + padding, s[src.width - 1]);
+	}
+
+	// ㉺̗]ɂ́AE̗]܂߂[̍s𕡐.
+	const uint32_t rowWidth = src.width + padding * 2;
+	const size_t topRow = oy * page.width + entry.x;
+	const size_t bottomRow = (oy + src.height - 1) * page.width + entry.x;
+	for (uint32_t i = 0; i < padding; ++i) {
+		std::copy(&page.data[topRow], &page.data[topRow] + rowWidth, &page.data[(entry.y + i) * page.width + entry.x]);
+		std::copy(&page.data[bottomRow], &page.data[bottomRow] + rowWidth, &page.data[(oy + src.height + i) * page.width + entry.x]);
+	}
+}
+
+/**
+* ZXguv, tsizeA܂Ƃ߂摜̍Wɏ.
+*
+* @param page  ܂Ƃ߂摜.
+* @param entry ZXg摜̏.
+*/
+void AtlasBuilder::RemapCell(const Image& page, const Entry& entry) const
+{
+	const float pageWidth = static_cast<float>(page.width);
+	const float pageHeight = static_cast<float>(page.height);
+	const XMVECTOR scale = XMVectorSet(static_cast<float>(entry.image->width) / pageWidth, static_cast<float>(entry.image->height) / pageHeight, 0.0f, 0.0f);
+	const XMVECTOR offset = XMVectorSet(static_cast<float>(entry.x + padding) / pageWidth, static_cast<float>(entry.y + padding) / pageHeight, 0.0f, 0.0f);
+	for (CellList* cellList : entry.cellLists) {
+		for (Cell& cell : cellList->list) {
+			XMStoreFloat2(&cell.uv, XMVectorMultiplyAdd(XMLoadFloat2(&cell.uv), scale, offset));
+			XMStoreFloat2(&cell.tsize, XMVectorMultiply(XMLoadFloat2(&cell.tsize), scale));
+		}
+		if (!cellList->quadList.empty()) {
+			BuildQuadTemplate(*cellList);
+		}
+	}
+}
+
+} // namespace Sprite
@@ -0,0 +1,68 @@
+/**
+* @file Atlas.h
+*/
+#ifndef DX12TUTORIAL_SRC_ATLAS_H_
+#define DX12TUTORIAL_SRC_ATLAS_H_
+#include "Sprite.h"
+#include <vector>
+#include <stdint.h>
+
+namespace Sprite {
+
+/**
+* ̉摜1̃eNX`ɂ܂Ƃ߂NX.
+*
+* 摜XJCC@ŋlߍ݁Aꂼ̉摜ŎgĂZXguv, tsize
+* ܂Ƃ߂摜̍Wɏ.
+* ɂAʁX̉摜gXvCgohŕ`ł悤ɂȂ.
+*
+* - 摜̎͂ɂpaddingsNZ̗]݂A[̃sNZ]ɕ(u[h).
+*   ɂāAoCjAtB^ŗׂ̉摜̐F邱Ƃh.
+* - eNX`W̃bvOƂŹA܂Ƃ߂͐\Ȃ.
+*
+* g:
+* -# Add()ŉ摜ƁẢ摜QƂZXgo^.
+* -# Build()ŉ摜܂Ƃ߂. Ɠo^ZXg.
+* -# ResourceLoader::Create()ȂǂŁA܂Ƃ߂摜eNX`쐬.
+*/
+class AtlasBuilder
+{
+public:
+	AtlasBuilder(uint32_t maxWidth, uint32_t maxHeight, uint32_t padding = 2);
+	~AtlasBuilder() = default;
+	AtlasBuilder(const AtlasBuilder&) = delete;
+	AtlasBuilder& operator=(const AtlasBuilder&) = delete;
+
+	void Add(const Image& image, const std::vector<CellList*>& cellLists);
+	bool Build(Image& page);
+
+private:
+	/// o^ꂽ摜̏.
+	struct Entry {
+		const Image* image;
+		std::vector<CellList*> cellLists;
+		uint32_t x; ///< ܂Ƃ߂摜̍XW(]܂).
+		uint32_t y; ///< ܂Ƃ߂摜̍YW(]܂).
+	};
+
+	/// XJCC\鐅.
+	struct SkylineNode {
+		uint32_t x;
+		uint32_t y;
+		uint32_t width;
+	};
+
+	bool Insert(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y);
+	void Blit(Image& page, const Entry& entry) const;
+	void RemapCell(const Image& page, const Entry& entry) const;
+
+	uint32_t maxWidth;
+	uint32_t maxHeight;
+	uint32_t padding;
+	std::vector<Entry> entryList;
+	std::vector<SkylineNode> skyline;
+};
+
+} // namespace Sprite
+
+#endif // DX12TUTORIAL_SRC_ATLAS_H_
@@ -0,0 +1,202 @@
+/**
+* @file CellMesh.cpp
+*/
+#include "CellMesh.h"
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+
+using namespace DirectX;
+
+namespace Sprite {
+
+const int CellMesh::quadIndex[CellMesh::quadCount][4] = {
+	{ 0, 1, 2, 3 },
+	{ 7, 0, 3, 4 },
+	{ 4, 5, 6, 7 },
+};
+
+/**
+* ZŜ𕢂`쐬.
+*
+* 쐬`͋`1ŕ`悳.
+*
+* @param mesh 쐬`i[ϐ.
+*/
+void MakeRectMesh(CellMesh& mesh)
+{
+	mesh.vertex[0] = mesh.vertex[7] = XMFLOAT2(0, 0);
+	mesh.vertex[1] = mesh.vertex[2] = XMFLOAT2(1, 0);
+	mesh.vertex[3] = mesh.vertex[4] = XMFLOAT2(1, 1);
+	mesh.vertex[5] = mesh.vertex[6] = XMFLOAT2(0, 1);
+	mesh.isRect = true;
+}
+
+/**
+* Z̕s͂ތ`쐬.
+*
+* Z͈̔͂ɂsNẐAAt@lalphaThreshold傫̂sƂ݂ȂA
+* sȃsNZׂĊ܂8̓ʑp`߂.
+* oCjAtB^ŉɂޕc߁Ap`paddingsNZOɍL.
+*
+* @param image          ZQƂ摜.
+* @param cell           `쐬Z.
+* @param mesh           쐬`i[ϐ.
+* @param alphaThreshold sƂ݂ȂAt@l̉(̒l͊܂܂Ȃ).
+* @param padding        p`OɍL镝(sNZ).
+*
+* @retval true  쐬. ZSɓȏꍇAʐ0̌`󂪍쐬.
+* @retval false Z摜͈̔͊O. meshɂ̓ZŜ𕢂`󂪊i[.
+*/
+bool BakeCellMesh(const Image& image, const Cell& cell, CellMesh& mesh, uint32_t alphaThreshold, float padding)
+{
+	const int left = static_cast<int>(floor(cell.uv.x * image.width + 0.5f));
+	const int top = static_cast<int>(floor(cell.uv.y * image.height + 0.5f));
+	const int width = static_cast<int>(floor(cell.tsize.x * image.width + 0.5f));
+	const int height = static_cast<int>(floor(cell.tsize.y * image.height + 0.5f));
+	if (width <= 0 || height <= 0 || left < 0 || top < 0 ||
+		left + width > static_cast<int>(image.width) || top + height > static_cast<int>(image.height)) {
+		MakeRectMesh(mesh);
+		return false;
+	}
+
+	// es̍[ƉE[̕ssNZŁA8ׂĂ͈̔͂܂.
+	float xmin = FLT_MAX, xmax = -FLT_MAX, ymin = FLT_MAX, ymax = -FLT_MAX;
+	float smin = FLT_MAX, smax = -FLT_MAX, dmin = FLT_MAX, dmax = -FLT_MAX;
+	for (int y = 0; y < height; ++y) {
+		const uint32_t* row = image.data.data() + (top + y) * image.width + left;
+		int x0 = 0;
+		while (x0 < width && (row[x0] >> 24) <= alphaThreshold) {
+			++x0;
+		}
+		if (x0 >= width) {
+			continue;
+		}
+		int x1 = width - 1;
+		while ((row[x1] >> 24) <= alphaThreshold) {
+			--x1;
+		}
+		const float fx0 = static_cast<float>(x0);
+		const float fx1 = static_cast<float>(x1 + 1);
+		const float fy0 = static_cast<float>(y);
+		const float fy1 = static_cast<float>(y + 1);
+		xmin = std::min(xmin, fx0);
+		xmax = std::max(xmax, fx1);
+		ymin = std::min(ymin, fy0);
+		ymax = std::max(ymax, fy1);
+		smin = std::min(smin, fx0 + fy0);
+		smax = std::max(smax, fx1 + fy1);
+		dmin = std::min(dmin, fx0 - fy1);
+		dmax = std::max(dmax, fx1 - fy0);
+	}
+	if (xmin > xmax) {
+		for (XMFLOAT2& e : mesh.vertex) {
+			e = XMFLOAT2(0.5f, 0.5f);
+		}
+		mesh.isRect = false;
+		return true;
+	}
+
+	const float fw = static_cast<float>(width);
+	const float fh = static_cast<float>(height);
+	xmin = std::max(0.0f, xmin - padding);
+	xmax = std::min(fw, xmax + padding);
+	ymin = std::max(0.0f, ymin - padding);
+	ymax = std::min(fh, ymax + padding);
+	smin -= padding * 2;
+	smax += padding * 2;
+	dmin -= padding * 2;
+	dmax += padding * 2;
+
+	const XMFLOAT2 v[CellMesh::vertexCount] = {
+		{ std::max(xmin, smin - ymin), ymin },
+		{ std::min(xmax, dmax + ymin), ymin },
+		{ xmax, std::max(ymin, xmax - dmax) },
+		{ xmax, std::min(ymax, smax - xmax) },
+		{ std::min(xmax, smax - ymax), ymax },
+		{ std::max(xmin, dmin + ymax), ymax },
+		{ xmin, std::min(ymax, xmin - dmin) },
+		{ xmin, std::max(ymin, smin - xmin) },
+	};
+	for (int i = 0; i < CellMesh::vertexCount; ++i) {
+		mesh.vertex[i].x = std::min(xmax, std::max(xmin, v[i].x)) / fw;
+		mesh.vertex[i].y = std::min(ymax, std::max(ymin, v[i].y)) / fh;
+	}
+	mesh.isRect = false;
+	return true;
+}
+
+/**
+* ZXĝׂẴZɂČ`쐬.
+*
+* ؂l߂`͋`3̒_g߁AʐςZmaxAreaRatio{𒴂ꍇ
+* hԂsNZ̍팸蒸_̑Ƃ݂ȂA`1ŕ`悷`ɂ.
+*
+* @param image          ZXgQƂ摜.
+* @param cellList       `쐬ZXg.
+* @param meshList       쐬`i[z. cellListƓтɂȂ.
+* @param alphaThreshold sƂ݂ȂAt@l̉(̒l͊܂܂Ȃ).
+* @param padding        p`OɍL镝(sNZ).
+* @param maxAreaRatio   ؂l߂`gʐς̏(ZŜ̖ʐς1Ƃ).
+*
+* @return ؂l߂`ŕ`悷Z̐.
+*/
+size_t BakeCellMeshList(const Image& image, const std::vector<Cell>& cellList, std::vector<CellMesh>& meshList, uint32_t alphaThreshold, float padding, float maxAreaRatio)
+{
+	meshList.resize(cellList.size());
+	size_t meshCount = 0;
+	for (size_t i = 0; i < cellList.size(); ++i) {
+		BakeCellMesh(image, cellList[i], meshList[i], alphaThreshold, padding);
+		if (meshList[i].isRect) {
+			continue;
+		}
+		if (CalcMeshArea(meshList[i]) > maxAreaRatio) {
+			MakeRectMesh(meshList[i]);
+			continue;
+		}
+		++meshCount;
+	}
+	return meshCount;
+}
+
+/**
+* `̖ʐς߂.
+*
+* @param mesh ʐς߂`.
+*
+* @return ZŜ̖ʐς1ƂƂ̖ʐ.
+*/
+float CalcMeshArea(const CellMesh& mesh)
+{
+	float area = 0;
+	for (int i = 0; i < CellMesh::vertexCount; ++i) {
+		const XMFLOAT2& a = mesh.vertex[i];
+		const XMFLOAT2& b = mesh.vertex[(i + 1) % CellMesh::vertexCount];
+		area += a.x * b.y - b.x * a.y;
+	}
+	return fabs(area) * 0.5f;
+}
+
+/**
+* _`̓ɂ邩ׂ.
+*
+* @param mesh ׂ`.
+* @param p    ׂ_. Z̍(0, 0)AE(1, 1)ƂW.
+*
+* @retval true  p͌`̓܂͕ӏɂ.
+* @retval false p͌`̊Oɂ.
+*/
+bool IsInsideMesh(const CellMesh& mesh, const XMFLOAT2& p)
+{
+	for (int i = 0; i < CellMesh::vertexCount; ++i) {
+		const XMFLOAT2& a = mesh.vertex[i];
+		const XMFLOAT2& b = mesh.vertex[(i + 1) % CellMesh::vertexCount];
+		const float cross = (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+		if (cross < -1.0e-5f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace Sprite
@@ -0,0 +1,42 @@
+/**
+* @file CellMesh.h
+*/
+#ifndef DX12TUTORIAL_SRC_CELLMESH_H_
+#define DX12TUTORIAL_SRC_CELLMESH_H_
+#include "SpriteTypes.h"
+#include <DirectXMath.h>
+#include <vector>
+#include <stdint.h>
+
+namespace Sprite {
+
+/**
+* ؂l߂Ž`.
+*
+* Z̕sȃsNZ͂ށA8(㉺EƎ΂4)̕ӂȂʑp`.
+* _̓Z̍(0, 0)AE(1, 1)ƂWŁAʏŎvɕ.
+* ӂ̒0ɂȂ钸_͏dȂĊi[.
+*
+* `掞͎lp`3(_0-1-2-3, 7-0-3-4, 4-5-6-7)ɕA
+* ʏ̃XvCg3̒_gp.
+* ؂l߂Ăʐς܂茸ȂŹAisRecttrueɂĒʏ̋`1ŕ`悷.
+*/
+struct CellMesh
+{
+	static const int vertexCount = 8;
+	static const int quadCount = 3;
+	static const int quadIndex[quadCount][4];
+
+	DirectX::XMFLOAT2 vertex[vertexCount];
+	bool isRect; ///< trueȂvertexg킸AZŜ̋`(lp`1)ŕ`悷.
+};
+
+void MakeRectMesh(CellMesh& mesh);
+bool BakeCellMesh(const Image& image, const Cell& cell, CellMesh& mesh, uint32_t alphaThreshold = 0, float padding = 1.0f);
+size_t BakeCellMeshList(const Image& image, const std::vector<Cell>& cellList, std::vector<CellMesh>& meshList, uint32_t alphaThreshold = 0, float padding = 1.0f, float maxAreaRatio = 0.7f);
+float CalcMeshArea(const CellMesh& mesh);
+bool IsInsideMesh(const CellMesh& mesh, const DirectX::XMFLOAT2& p);
+
+} // namespace Sprite
+
+#endif // DX12TUTORIAL_SRC_CELLMESH_H_
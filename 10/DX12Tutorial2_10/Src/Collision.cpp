@@ -3,6 +3,11 @@
 */
 #include "Collision.h"
 #include <algorithm>
+#include <math.h>
+#ifdef COLLISION_ENABLE_BATCH_TEST
+#include "DebugHelper.h"
+#include <stdio.h>
+#endif // COLLISION_ENABLE_BATCH_TEST
 
 using namespace DirectX;
 
@@ -301,7 +306,7 @@ XMVECTOR Shape::Aabb(float x, float y) const
 	switch (type) {
 	case ShapeType::Circle: {
 		const XMVECTOR r = XMVectorReplicate(circle.radius);
-		return XMVectorPermute<0, 1, 4, 5>(pos - r, pos - r);
+		return XMVectorPermute<0, 1, 4, 5>(pos - r, pos + r);
 	}
 	case ShapeType::Rectangle:
 		return XMVectorPermute<0, 1, 4, 5>(pos + XMLoadFloat2(&rect.leftTop), pos + XMLoadFloat2(&rect.rightBottom));
@@ -389,4 +394,986 @@ bool IsCollision(const Shape& sa, const XMFLOAT2& pa, const Shape& sb, const XMF
 	return funcList[static_cast<int>(sa.type)][static_cast<int>(sb.type)](sa, pa, sb, pb);
 }
 
+namespace /* unnamed */ {
+
+/**
+* ړ_Ɖ~̐ڐG߂.
+*
+* @param o _̈ړJnʒu.
+* @param d _̈ړ. tɂ_̈ʒuo + d * tɂȂ.
+* @param c ~̒S.
+* @param r ~̔a.
+* @param t ڐG(0`1)i[ϐ. Jn_ŉ~̓ɂꍇ0ɂȂ.
+*
+* @retval true  0`1̊ԂɐڐG.
+* @retval false ڐGȂ.
+*/
+bool SweepPointCircle(XMVECTOR o, XMVECTOR d, XMVECTOR c, float r, float& t)
+{
+	const XMVECTOR m = o - c;
+	const float distSq = XMVectorGetX(XMVector2LengthSq(m)) - r * r;
+	if (distSq <= 0) {
+		t = 0;
+		return true;
+	}
+	const float a = XMVectorGetX(XMVector2LengthSq(d));
+	const float b = XMVectorGetX(XMVector2Dot(m, d));
+	// ~܂Ă邩A~牓Ăꍇ͐ڐGȂ.
+	if (a <= 0 || b >= 0) {
+		return false;
+	}
+	const float disc = b * b - a * distSq;
+	if (disc < 0) {
+		return false;
+	}
+	t = (-b - std::sqrt(disc)) / a;
+	return t <= 1;
+}
+
+/**
+* ړ_AABB̐ڐG߂.
+*
+* Detector::LineRect()ƓXuAړʂ̂܂܌Ƃčs.
+*
+* @param o    _̈ړJnʒu.
+* @param d    _̈ړ.
+* @param bMin AABB̍W.
+* @param bMax AABB̉EW.
+* @param t    ڐG(0`1)i[ϐ. Jn_AABB̓ɂꍇ0ɂȂ.
+*
+* @retval true  0`1̊ԂɐڐG.
+* @retval false ڐGȂ.
+*/
+bool SweepPointAabb(XMVECTOR o, XMVECTOR d, XMVECTOR bMin, XMVECTOR bMax, float& t)
+{
+	XMVECTORF32 vo, vd, vMin, vMax;
+	vo.v = o;
+	vd.v = d;
+	vMin.v = bMin;
+	vMax.v = bMax;
+	float tmin = 0;
+	float tmax = 1;
+	for (int i = 0; i < 2; ++i) {
+		if (std::abs(vd[i]) < FLT_EPSILON) {
+			if (vo[i] < vMin[i] || vo[i] > vMax[i]) {
+				return false;
+			}
+		} else {
+			const float invD = 1.0f / vd[i];
+			float t1 = (vMin[i] - vo[i]) * invD;
+			float t2 = (vMax[i] - vo[i]) * invD;
+			if (t1 > t2) { std::swap(t1, t2); }
+			tmin = std::max(t1, tmin);
+			tmax = std::min(t2, tmax);
+			if (tmin > tmax) {
+				return false;
+			}
+		}
+	}
+	t = tmin;
+	return true;
+}
+
+/**
+* ړ~ƒ`̐ڐG߂.
+*
+* `~̔ac܂pے`ƁA~̒S̈ړƂ̔s.
+* pے`́Acꂼɖc܂2̒`ƁAl̉~ɕĔ肷.
+*
+* @param o    ~̒S̈ړJnʒu.
+* @param d    ~̒S̈ړ.
+* @param bMin `̍W.
+* @param bMax `̉EW.
+* @param r    ~̔a.
+* @param t    ڐG(0`1)i[ϐ.
+*
+* @retval true  0`1̊ԂɐڐG.
+* @retval false ڐGȂ.
+*/
+bool SweepCircleRect(XMVECTOR o, XMVECTOR d, XMVECTOR bMin, XMVECTOR bMax, float r, float& t)
+{
+	const XMVECTOR rx = XMVectorSet(r, 0, 0, 0);
+	const XMVECTOR ry = XMVectorSet(0, r, 0, 0);
+	const XMVECTOR corner[4] = {
+		bMin, XMVectorPermute<4, 1, 2, 3>(bMin, bMax), bMax, XMVectorPermute<0, 5, 2, 3>(bMin, bMax)
+	};
+	float first = FLT_MAX;
+	float tmp;
+	if (SweepPointAabb(o, d, bMin - rx, bMax + rx, tmp)) {
+		first = std::min(first, tmp);
+	}
+	if (SweepPointAabb(o, d, bMin - ry, bMax + ry, tmp)) {
+		first = std::min(first, tmp);
+	}
+	for (const XMVECTOR& c : corner) {
+		if (SweepPointCircle(o, d, c, r, tmp)) {
+			first = std::min(first, tmp);
+		}
+	}
+	if (first > 1) {
+		return false;
+	}
+	t = first;
+	return true;
+}
+
+/**
+* ړ~Ɛ̐ڐG߂.
+*
+* ~̔ac܂JvZ`ƁA~̒S̈ړƂ̔s.
+* JvŹǍɉ`ƁA[̉~ɕĔ肷.
+*
+* @param o ~̒S̈ړJnʒu.
+* @param d ~̒S̈ړ.
+* @param a ̎n_.
+* @param b ̏I_.
+* @param r ~̔a.
+* @param t ڐG(0`1)i[ϐ.
+*
+* @retval true  0`1̊ԂɐڐG.
+* @retval false ڐGȂ.
+*/
+bool SweepCircleLine(XMVECTOR o, XMVECTOR d, XMVECTOR a, XMVECTOR b, float r, float& t)
+{
+	float first = FLT_MAX;
+	float tmp;
+	if (SweepPointCircle(o, d, a, r, tmp)) {
+		first = std::min(first, tmp);
+	}
+	if (SweepPointCircle(o, d, b, r, tmp)) {
+		first = std::min(first, tmp);
+	}
+	const XMVECTOR ab = b - a;
+	const float length = XMVectorGetX(XMVector2Length(ab));
+	if (length > 0) {
+		// ̌XƂWnɕϊāA`ƂĔ肷.
+		const XMVECTOR u = ab / XMVectorReplicate(length);
+		const XMVECTOR n = XMVectorSet(-XMVectorGetY(u), XMVectorGetX(u), 0, 0);
+		const XMVECTOR ao = o - a;
+		const XMVECTOR localO = XMVectorSet(XMVectorGetX(XMVector2Dot(ao, u)), XMVectorGetX(XMVector2Dot(ao, n)), 0, 0);
+		const XMVECTOR localD = XMVectorSet(XMVectorGetX(XMVector2Dot(d, u)), XMVectorGetX(XMVector2Dot(d, n)), 0, 0);
+		if (SweepPointAabb(localO, localD, XMVectorSet(0, -r, 0, 0), XMVectorSet(length, r, 0, 0), tmp)) {
+			first = std::min(first, tmp);
+		}
+	}
+	if (first > 1) {
+		return false;
+	}
+	t = first;
+	return true;
+}
+
+/**
+* p̓ʑp`.
+*
+* `4_A2_̑p`ƂĈ.
+*/
+struct ConvexPolygon
+{
+	XMVECTOR vertex[4];
+	size_t count;
+};
+
+/**
+* `܂͐̌`󂩂ʑp`쐬.
+*
+* @param s `܂͐̌`.
+* @param p `̍W.
+*
+* @return 쐬ʑp`.
+*/
+ConvexPolygon MakeConvexPolygon(const Shape& s, XMVECTOR p)
+{
+	ConvexPolygon poly;
+	if (s.Type() == ShapeType::Rectangle) {
+		const XMVECTOR lt = p + XMLoadFloat2(&s.AsRect().leftTop);
+		const XMVECTOR rb = p + XMLoadFloat2(&s.AsRect().rightBottom);
+		poly.vertex[0] = lt;
+		poly.vertex[1] = XMVectorPermute<4, 1, 2, 3>(lt, rb);
+		poly.vertex[2] = rb;
+		poly.vertex[3] = XMVectorPermute<0, 5, 2, 3>(lt, rb);
+		poly.count = 4;
+	} else {
+		poly.vertex[0] = p + XMLoadFloat2(&s.AsLine().start);
+		poly.vertex[1] = p + XMLoadFloat2(&s.AsLine().end);
+		poly.count = 2;
+	}
+	return poly;
+}
+
+/**
+* ʑp`ɓe͈͂߂.
+*
+* @param poly    eʑp`.
+* @param axis    e̎.
+* @param minimum ͈͂̍ŏli[ϐ.
+* @param maximum ͈͂̍őli[ϐ.
+*/
+void ProjectConvexPolygon(const ConvexPolygon& poly, XMVECTOR axis, float& minimum, float& maximum)
+{
+	minimum = FLT_MAX;
+	maximum = -FLT_MAX;
+	for (size_t i = 0; i < poly.count; ++i) {
+		const float v = XMVectorGetX(XMVector2Dot(poly.vertex[i], axis));
+		minimum = std::min(minimum, v);
+		maximum = std::max(maximum, v);
+	}
+}
+
+/**
+* ړʑp`ƁAÎ~ʑp`̐ڐG߂.
+*
+* ƂɁAe͈͂dȂn߂鎞ƏdȂ肪I鎞߁A
+* SĂ̎ŏdȂĂԂ̊JnڐGƂ.
+* X, YƁǍі@g.
+*
+* @param a ړʑp`.
+* @param d äړ.
+* @param b Î~ʑp`.
+* @param t ڐG(0`1)i[ϐ. Jn_ŏdȂĂꍇ0ɂȂ.
+*
+* @retval true  0`1̊ԂɐڐG.
+* @retval false ڐGȂ.
+*/
+bool SweepConvexPolygon(const ConvexPolygon& a, XMVECTOR d, const ConvexPolygon& b, float& t)
+{
+	XMVECTOR axisList[6] = { XMVectorSet(1, 0, 0, 0), XMVectorSet(0, 1, 0, 0) };
+	size_t axisCount = 2;
+	for (const ConvexPolygon* poly : { &a, &b }) {
+		if (poly->count == 2) {
+			const XMVECTOR v = XMVector2Normalize(poly->vertex[1] - poly->vertex[0]);
+			axisList[axisCount++] = v;
+			axisList[axisCount++] = XMVectorSet(-XMVectorGetY(v), XMVectorGetX(v), 0, 0);
+		}
+	}
+
+	float tFirst = 0;
+	float tLast = 1;
+	for (size_t i = 0; i < axisCount; ++i) {
+		float aMin, aMax, bMin, bMax;
+		ProjectConvexPolygon(a, axisList[i], aMin, aMax);
+		ProjectConvexPolygon(b, axisList[i], bMin, bMax);
+		const float speed = XMVectorGetX(XMVector2Dot(d, axisList[i]));
+		if (std::abs(speed) < FLT_EPSILON) {
+			if (aMax < bMin || aMin > bMax) {
+				return false;
+			}
+			continue;
+		}
+		float t1 = (bMin - aMax) / speed;
+		float t2 = (bMax - aMin) / speed;
+		if (t1 > t2) { std::swap(t1, t2); }
+		tFirst = std::max(t1, tFirst);
+		tLast = std::min(t2, tLast);
+		if (tFirst > tLast) {
+			return false;
+		}
+	}
+	t = tFirst;
+	return true;
+}
+
+} // unnamed namespace
+
+/**
+* ړ`󓯎m̓蔻.
+*
+* 1t[̊ԂɁAsapa0pa1ցAsbpb0pb1֓ňړƂāAŏɐڐG鎞߂.
+* ړʂ`傫ꍇłA蔲ɏՓ˂oł.
+*
+* ~܂ޑgݍ킹́Ǎ`~̔ac܂`ƁA~̒S̈ړƂ̔s.
+* `Ɛ̑gݍ킹́AƂɏdȂԂ߂Ĕ肷.
+*
+* @param sa  ӑ̌`.
+* @param pa0 ӑ̈ړJnW.
+* @param pa1 ӑ̈ړIW.
+* @param sb  Eӑ̌`.
+* @param pb0 Eӑ̈ړJnW.
+* @param pb1 Eӑ̈ړIW.
+* @param toi ڐGi[ϐ. ړJn0AړI1Ƃ䗦Ŋi[.
+*            Jn_ŏdȂĂꍇ0ɂȂ.
+*
+* @retval true  ړɏՓ˂.
+* @retval false Փ˂Ȃ.
+*/
+bool SweepCollision(const Shape& sa, const XMFLOAT2& pa0, const XMFLOAT2& pa1,
+	const Shape& sb, const XMFLOAT2& pb0, const XMFLOAT2& pb1, float& toi)
+{
+	const XMVECTOR a0 = XMLoadFloat2(&pa0);
+	const XMVECTOR b0 = XMLoadFloat2(&pb0);
+	// sb猩sȃΓIȈړ.
+	const XMVECTOR d = (XMLoadFloat2(&pa1) - a0) - (XMLoadFloat2(&pb1) - b0);
+
+	if (sa.type == ShapeType::Circle) {
+		switch (sb.type) {
+		case ShapeType::Circle:
+			return SweepPointCircle(a0, d, b0, sa.circle.radius + sb.circle.radius, toi);
+		case ShapeType::Rectangle:
+			return SweepCircleRect(a0, d, b0 + XMLoadFloat2(&sb.rect.leftTop), b0 + XMLoadFloat2(&sb.rect.rightBottom), sa.circle.radius, toi);
+		case ShapeType::Line:
+			return SweepCircleLine(a0, d, b0 + XMLoadFloat2(&sb.line.start), b0 + XMLoadFloat2(&sb.line.end), sa.circle.radius, toi);
+		default:
+			return false;
+		}
+	}
+	if (sb.type == ShapeType::Circle) {
+		// sa猩sb̈ړƂĔ肷.
+		switch (sa.type) {
+		case ShapeType::Rectangle:
+			return SweepCircleRect(b0, -d, a0 + XMLoadFloat2(&sa.rect.leftTop), a0 + XMLoadFloat2(&sa.rect.rightBottom), sb.circle.radius, toi);
+		case ShapeType::Line:
+			return SweepCircleLine(b0, -d, a0 + XMLoadFloat2(&sa.line.start), a0 + XMLoadFloat2(&sa.line.end), sb.circle.radius, toi);
+		default:
+			return false;
+		}
+	}
+	return SweepConvexPolygon(MakeConvexPolygon(sa, a0), d, MakeConvexPolygon(sb, b0), toi);
+}
+
+/**
+* ~`̌`z̖ɒǉ.
+*
+* @param s ǉ`.
+* @param p `̍W.
+*
+* @retval true  ǉ.
+* @retval false s~`ł͂ȂߒǉłȂ.
+*/
+bool CircleBatch::Push(const Shape& s, const XMFLOAT2& p)
+{
+	if (s.Type() != ShapeType::Circle) {
+		return false;
+	}
+	x.push_back(p.x);
+	y.push_back(p.y);
+	radius.push_back(s.AsCircle().radius);
+	return true;
+}
+
+/**
+* zɂ.
+*/
+void CircleBatch::Clear()
+{
+	x.clear();
+	y.clear();
+	radius.clear();
+}
+
+/**
+* `̌`z̖ɒǉ.
+*
+* @param s ǉ`.
+* @param p `̍W.
+*
+* @retval true  ǉ.
+* @retval false s`ł͂ȂߒǉłȂ.
+*/
+bool RectBatch::Push(const Shape& s, const XMFLOAT2& p)
+{
+	if (s.Type() != ShapeType::Rectangle) {
+		return false;
+	}
+	const Shape::Rect& rect = s.AsRect();
+	left.push_back(p.x + rect.leftTop.x);
+	top.push_back(p.y + rect.leftTop.y);
+	right.push_back(p.x + rect.rightBottom.x);
+	bottom.push_back(p.y + rect.rightBottom.y);
+	return true;
+}
+
+/**
+* zɂ.
+*/
+void RectBatch::Clear()
+{
+	left.clear();
+	top.clear();
+	right.clear();
+	bottom.clear();
+}
+
+/**
+* ̌`z̖ɒǉ.
+*
+* @param s ǉ`.
+* @param p `̍W.
+*
+* @retval true  ǉ.
+* @retval false sł͂ȂߒǉłȂ.
+*/
+bool LineBatch::Push(const Shape& s, const XMFLOAT2& p)
+{
+	if (s.Type() != ShapeType::Line) {
+		return false;
+	}
+	const Shape::Line& line = s.AsLine();
+	startX.push_back(line.start.x + p.x);
+	startY.push_back(line.start.y + p.y);
+	endX.push_back(line.end.x + p.x);
+	endY.push_back(line.end.y + p.y);
+	return true;
+}
+
+/**
+* zɂ.
+*/
+void LineBatch::Clear()
+{
+	startX.clear();
+	startY.clear();
+	endX.clear();
+	endY.clear();
+}
+
+namespace /* unnamed */ {
+
+/**
+* 4vf̍W.
+*/
+struct Point4
+{
+	XMVECTOR x;
+	XMVECTOR y;
+};
+
+/**
+* 4vf̒`.
+*/
+struct Rect4
+{
+	XMVECTOR left;
+	XMVECTOR top;
+	XMVECTOR right;
+	XMVECTOR bottom;
+};
+
+/**
+* ziԖڂő4vfǂݍ.
+*
+* @param v ǂݍޔz.
+* @param i ǂݍ݂JnCfbNX.
+* @param n ǂݍޗvf. 4̏ꍇAc̗vf0ɂȂ.
+*
+* @return ǂݍ񂾒l.
+*/
+XMVECTOR LoadLane(const std::vector<float>& v, size_t i, size_t n)
+{
+	if (n >= 4) {
+		return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&v[i]));
+	}
+	XMFLOAT4 tmp(0, 0, 0, 0);
+	float* p = &tmp.x;
+	for (size_t k = 0; k < n; ++k) {
+		p[k] = v[i + k];
+	}
+	return XMLoadFloat4(&tmp);
+}
+
+/**
+* W4vfɕ.
+*/
+Point4 SplatPoint(float x, float y)
+{
+	return { XMVectorReplicate(x), XMVectorReplicate(y) };
+}
+
+/**
+* xNg(x, y)̑g4vf܂Ƃ߂ĐK.
+*
+* XMVector2Normalize()ƓA0̃xNg0xNgɂȂ.
+*/
+void Normalize4(XMVECTOR& x, XMVECTOR& y)
+{
+	const XMVECTOR length = XMVectorSqrt(x * x + y * y);
+	const XMVECTOR nonZero = XMVectorNotEqual(length, XMVectorZero());
+	x = XMVectorAndInt(x / length, nonZero);
+	y = XMVectorAndInt(y / length, nonZero);
+}
+
+/**
+* 4vf֐ĂяoAʂrbg}XNɊi[.
+*
+* @param count   肷vf.
+* @param hitMask ʂi[rbg}XN. iԖڂ̗vfՓ˂Ă΁AiԖڂ̃rbg1ɂȂ.
+* @param func    ֐. JnCfbNXƗvf󂯎AՓ˂vfSrbg1̃}XNԂ.
+*/
+template<typename Func>
+void ForEachLane(size_t count, std::vector<uint32_t>& hitMask, Func func)
+{
+	hitMask.assign((count + 31) / 32, 0);
+	for (size_t i = 0; i < count; i += 4) {
+		const size_t n = std::min<size_t>(4, count - i);
+		uint32_t m[4];
+		XMStoreInt4(m, func(i, n));
+		const uint32_t bits = ((m[0] & 1) | (m[1] & 2) | (m[2] & 4) | (m[3] & 8)) & ((1U << n) - 1);
+		hitMask[i / 32] |= bits << (i % 32);
+	}
+}
+
+/**
+* ~Ɖ~̓蔻(4vf).
+*
+* Detector::CircleCircle()ƓvZ4vf܂Ƃ߂čs.
+*/
+XMVECTOR CircleCircle4(const Point4& a, XMVECTOR ra, const Point4& b, XMVECTOR rb)
+{
+	const XMVECTOR dx = a.x - b.x;
+	const XMVECTOR dy = a.y - b.y;
+	const XMVECTOR radSum = ra + rb;
+	return XMVectorLess(dx * dx + dy * dy, radSum * radSum);
+}
+
+/**
+* `Ɖ~̓蔻(4vf).
+*
+* Detector::RectCircle()ƓvZ4vf܂Ƃ߂čs.
+*/
+XMVECTOR RectCircle4(const Rect4& a, const Point4& c, XMVECTOR radius)
+{
+	const XMVECTOR dx = XMVectorMin(XMVectorMax(c.x, a.left), a.right) - c.x;
+	const XMVECTOR dy = XMVectorMin(XMVectorMax(c.y, a.top), a.bottom) - c.y;
+	return XMVectorLess(dx * dx + dy * dy, radius * radius);
+}
+
+/**
+* `ƒ`̓蔻(4vf).
+*
+* Detector::RectRect()ƓvZ4vf܂Ƃ߂čs.
+*/
+XMVECTOR RectRect4(const Rect4& a, const Rect4& b)
+{
+	XMVECTOR miss = XMVectorOrInt(XMVectorLess(a.right, b.left), XMVectorGreater(a.left, b.right));
+	miss = XMVectorOrInt(miss, XMVectorLess(a.bottom, b.top));
+	miss = XMVectorOrInt(miss, XMVectorGreater(a.top, b.bottom));
+	return XMVectorAndCInt(XMVectorTrueInt(), miss);
+}
+
+/**
+* Ɖ~̓蔻(4vf).
+*
+* Detector::LineCircle()ƓvZ4vf܂Ƃ߂čs.
+* ̑ɑSĂ̏vZAXMVectorSelect()ŌʂI.
+*
+* @param a      ̎n_.
+* @param b      ̏I_.
+* @param v      Ǩ.
+* @param o      ~̒S.
+* @param radius ~̔a.
+*/
+XMVECTOR LineCircle4(const Point4& a, const Point4& b, const Point4& v, const Point4& o, XMVECTOR radius)
+{
+	const XMVECTOR aox = o.x - a.x;
+	const XMVECTOR aoy = o.y - a.y;
+	const XMVECTOR box = o.x - b.x;
+	const XMVECTOR boy = o.y - b.y;
+	const XMVECTOR zero = XMVectorZero();
+	const XMVECTOR radSq = radius * radius;
+
+	const XMVECTOR apart = XMVectorGreater(XMVectorAbs(v.x * aoy - v.y * aox), radius);
+	const XMVECTOR beforeStart = XMVectorLess(aox * v.x + aoy * v.y, zero);
+	const XMVECTOR afterEnd = XMVectorGreater(box * v.x + boy * v.y, zero);
+	const XMVECTOR nearStart = XMVectorLess(aox * aox + aoy * aoy, radSq);
+	const XMVECTOR nearEnd = XMVectorLess(box * box + boy * boy, radSq);
+
+	XMVECTOR hit = XMVectorSelect(XMVectorTrueInt(), nearEnd, afterEnd);
+	hit = XMVectorSelect(hit, nearStart, beforeStart);
+	return XMVectorAndCInt(hit, apart);
+}
+
+/**
+* ƒ`̓蔻(4vf).
+*
+* Detector::LineRect()ƓXu4vf܂Ƃ߂čs.
+* ɕsȗvfł́At͈̔͂XVɎn_͈͓ǂ𒲂ׂ.
+*
+* @param p0 ̎n_.
+* @param p1 ̏I_.
+* @param d  Ǩ.
+* @param b  `.
+*/
+XMVECTOR LineRect4(const Point4& p0, const Point4& p1, const Point4& d, const Rect4& b)
+{
+	const XMVECTOR p0List[2] = { p0.x, p0.y };
+	const XMVECTOR dList[2] = { d.x, d.y };
+	const XMVECTOR bMin[2] = { b.left, b.top };
+	const XMVECTOR bMax[2] = { b.right, b.bottom };
+
+	const XMVECTOR epsilon = XMVectorReplicate(FLT_EPSILON);
+	XMVECTOR tmin = XMVectorReplicate(-FLT_MAX);
+	XMVECTOR tmax = XMVectorReplicate(FLT_MAX);
+	XMVECTOR miss = XMVectorFalseInt();
+	for (int i = 0; i < 2; ++i) {
+		const XMVECTOR parallel = XMVectorLess(XMVectorAbs(dList[i]), epsilon);
+		const XMVECTOR outside = XMVectorOrInt(XMVectorLess(p0List[i], bMin[i]), XMVectorGreater(p0List[i], bMax[i]));
+		const XMVECTOR invD = XMVectorReciprocal(dList[i]);
+		const XMVECTOR t1 = (bMin[i] - p0List[i]) * invD;
+		const XMVECTOR t2 = (bMax[i] - p0List[i]) * invD;
+		const XMVECTOR newMin = XMVectorMax(XMVectorMin(t1, t2), tmin);
+		const XMVECTOR newMax = XMVectorMin(XMVectorMax(t1, t2), tmax);
+		miss = XMVectorOrInt(miss, XMVectorSelect(XMVectorGreater(newMin, newMax), outside, parallel));
+		tmin = XMVectorSelect(newMin, tmin, parallel);
+		tmax = XMVectorSelect(newMax, tmax, parallel);
+	}
+	const XMVECTOR ex = p1.x - p0.x;
+	const XMVECTOR ey = p1.y - p0.y;
+	const XMVECTOR hit = XMVectorAndInt(XMVectorLessOrEqual(tmin, ex * ex + ey * ey), XMVectorGreaterOrEqual(tmax * tmax, XMVectorZero()));
+	return XMVectorAndCInt(hit, miss);
+}
+
+/**
+* ƒ̓蔻(4vf).
+*
+* Detector::LineLine()ƓvZ4vf܂Ƃ߂čs.
+*/
+XMVECTOR LineLine4(const Point4& a, const Point4& b, const Point4& c, const Point4& d)
+{
+	const XMVECTOR bax = b.x - a.x;
+	const XMVECTOR bay = b.y - a.y;
+	const XMVECTOR dcx = d.x - c.x;
+	const XMVECTOR dcy = d.y - c.y;
+	const XMVECTOR cax = c.x - a.x;
+	const XMVECTOR cay = c.y - a.y;
+	const XMVECTOR denom = bax * dcy - bay * dcx;
+	const XMVECTOR r = (cax * dcy - cay * dcx) / denom;
+	const XMVECTOR s = (cax * bay - cay * bax) / denom;
+
+	const XMVECTOR zero = XMVectorZero();
+	const XMVECTOR one = XMVectorSplatOne();
+	XMVECTOR miss = XMVectorLess(XMVectorAbs(denom), XMVectorReplicate(FLT_EPSILON));
+	miss = XMVectorOrInt(miss, XMVectorOrInt(XMVectorLess(r, zero), XMVectorGreater(r, one)));
+	miss = XMVectorOrInt(miss, XMVectorOrInt(XMVectorLess(s, zero), XMVectorGreater(s, one)));
+	return XMVectorAndCInt(XMVectorTrueInt(), miss);
+}
+
+/**
+* `̌`4vfɕ.
+*/
+Rect4 SplatRect(const Shape& s, const XMFLOAT2& p)
+{
+	const Shape::Rect& rect = s.AsRect();
+	return {
+		XMVectorReplicate(p.x + rect.leftTop.x), XMVectorReplicate(p.y + rect.leftTop.y),
+		XMVectorReplicate(p.x + rect.rightBottom.x), XMVectorReplicate(p.y + rect.rightBottom.y)
+	};
+}
+
+/**
+* ̌`4vfɕ.
+*
+* @param s     ̌`.
+* @param p     `̍W.
+* @param start n_i[ϐ.
+* @param end   I_i[ϐ.
+* @param dir   Ki[ϐ.
+*/
+void SplatLine(const Shape& s, const XMFLOAT2& p, Point4& start, Point4& end, Point4& dir)
+{
+	const XMVECTOR a = XMLoadFloat2(&s.AsLine().start) + XMLoadFloat2(&p);
+	const XMVECTOR b = XMLoadFloat2(&s.AsLine().end) + XMLoadFloat2(&p);
+	const XMVECTOR v = XMVector2Normalize(b - a);
+	start = SplatPoint(XMVectorGetX(a), XMVectorGetY(a));
+	end = SplatPoint(XMVectorGetX(b), XMVectorGetY(b));
+	dir = SplatPoint(XMVectorGetX(v), XMVectorGetY(v));
+}
+
+} // unnamed namespace
+
+/**
+* 1̌`ƁẢ~Ƃ̓蔻.
+*
+* 4vf܂Ƃ߂čs. ʂIsCollision()ʂɌĂ񂾏ꍇƈv.
+*
+* @param s       肷`.
+* @param p       肷`̍W.
+* @param batch   Ώۂ̉~̔z.
+* @param hitMask ʂi[rbg}XN. batchiԖڂƏՓ˂Ă΁AiԖڂ̃rbg1ɂȂ.
+*                IsHit()Œׂ邱Ƃł.
+*/
+void IsCollisionBatch(const Shape& s, const XMFLOAT2& p, const CircleBatch& batch, std::vector<uint32_t>& hitMask)
+{
+	const auto loadCenter = [&batch](size_t i, size_t n) {
+		return Point4{ LoadLane(batch.x, i, n), LoadLane(batch.y, i, n) };
+	};
+	switch (s.Type()) {
+	case ShapeType::Circle: {
+		const Point4 a = SplatPoint(p.x, p.y);
+		const XMVECTOR ra = XMVectorReplicate(s.AsCircle().radius);
+		ForEachLane(batch.Size(), hitMask, [&](size_t i, size_t n) {
+			return CircleCircle4(a, ra, loadCenter(i, n), LoadLane(batch.radius, i, n));
+		});
+		break;
+	}
+	case ShapeType::Rectangle: {
+		const Rect4 a = SplatRect(s, p);
+		ForEachLane(batch.Size(), hitMask, [&](size_t i, size_t n) {
+			return RectCircle4(a, loadCenter(i, n), LoadLane(batch.radius, i, n));
+		});
+		break;
+	}
+	case ShapeType::Line: {
+		Point4 a, b, v;
+		SplatLine(s, p, a, b, v);
+		ForEachLane(batch.Size(), hitMask, [&](size_t i, size_t n) {
+			return LineCircle4(a, b, v, loadCenter(i, n), LoadLane(batch.radius, i, n));
+		});
+		break;
+	}
+	default:
+		hitMask.assign((batch.Size() + 31) / 32, 0);
+		break;
+	}
+}
+
+/**
+* 1̌`ƁA̒`Ƃ̓蔻.
+*
+* 4vf܂Ƃ߂čs. ʂIsCollision()ʂɌĂ񂾏ꍇƈv.
+*
+* @param s       肷`.
+* @param p       肷`̍W.
+* @param batch   Ώۂ̒`̔z.
+* @param hitMask ʂi[rbg}XN. batchiԖڂƏՓ˂Ă΁AiԖڂ̃rbg1ɂȂ.
+*                IsHit()Œׂ邱Ƃł.
+*/
+void IsCollisionBatch(const Shape& s, const XMFLOAT2& p, const RectBatch& batch, std::vector<uint32_t>& hitMask)
+{
+	const auto loadRect = [&batch](size_t i, size_t n) {
+		return Rect4{
+			LoadLane(batch.left, i, n), LoadLane(batch.top, i, n),
+			LoadLane(batch.right, i, n), LoadLane(batch.bottom, i, n)
+		};
+	};
+	switch (s.Type()) {
+	case ShapeType::Circle: {
+		const Point4 c = SplatPoint(p.x, p.y);
+		const XMVECTOR radius = XMVectorReplicate(s.AsCircle().radius);
+		ForEachLane(batch.Size(), hitMask, [&](size_t i, size_t n) {
+			return RectCircle4(loadRect(i, n), c, radius);
+		});
+		break;
+	}
+	case ShapeType::Rectangle: {
+		const Rect4 a = SplatRect(s, p);
+		ForEachLane(batch.Size(), hitMask, [&](size_t i, size_t n) {
+			return RectRect4(a, loadRect(i, n));
+		});
+		break;
+	}
+	case ShapeType::Line: {
+		Point4 a, b, v;
+		SplatLine(s, p, a, b, v);
+		ForEachLane(batch.Size(), hitMask, [&](size_t i, size_t n) {
+			return LineRect4(a, b, v, loadRect(i, n));
+		});
+		break;
+	}
+	default:
+		hitMask.assign((batch.Size() + 31) / 32, 0);
+		break;
+	}
+}
+
+/**
+* 1̌`ƁA̐Ƃ̓蔻.
+*
+* 4vf܂Ƃ߂čs. ʂIsCollision()ʂɌĂ񂾏ꍇƈv.
+*
+* @param s       肷`.
+* @param p       肷`̍W.
+* @param batch   Ώۂ̐̔z.
+* @param hitMask ʂi[rbg}XN. batchiԖڂƏՓ˂Ă΁AiԖڂ̃rbg1ɂȂ.
+*                IsHit()Œׂ邱Ƃł.
+*/
+void IsCollisionBatch(const Shape& s, const XMFLOAT2& p, const LineBatch& batch, std::vector<uint32_t>& hitMask)
+{
+	const auto loadLine = [&batch](size_t i, size_t n, Point4& start, Point4& end, Point4& dir) {
+		start = Point4{ LoadLane(batch.startX, i, n), LoadLane(batch.startY, i, n) };
+		end = Point4{ LoadLane(batch.endX, i, n), LoadLane(batch.endY, i, n) };
+		dir = Point4{ end.x - start.x, end.y - start.y };
+		Normalize4(dir.x, dir.y);
+	};
+	switch (s.Type()) {
+	case ShapeType::Circle: {
+		const Point4 o = SplatPoint(p.x, p.y);
+		const XMVECTOR radius = XMVectorReplicate(s.AsCircle().radius);
+		ForEachLane(batch.Size(), hitMask, [&](size_t i, size_t n) {
+			Point4 a, b, v;
+			loadLine(i, n, a, b, v);
+			return LineCircle4(a, b, v, o, radius);
+		});
+		break;
+	}
+	case ShapeType::Rectangle: {
+		const Rect4 rect = SplatRect(s, p);
+		ForEachLane(batch.Size(), hitMask, [&](size_t i, size_t n) {
+			Point4 a, b, v;
+			loadLine(i, n, a, b, v);
+			return LineRect4(a, b, v, rect);
+		});
+		break;
+	}
+	case ShapeType::Line: {
+		Point4 a, b, v;
+		SplatLine(s, p, a, b, v);
+		ForEachLane(batch.Size(), hitMask, [&](size_t i, size_t n) {
+			return LineLine4(a, b,
+				Point4{ LoadLane(batch.startX, i, n), LoadLane(batch.startY, i, n) },
+				Point4{ LoadLane(batch.endX, i, n), LoadLane(batch.endY, i, n) });
+		});
+		break;
+	}
+	default:
+		hitMask.assign((batch.Size() + 31) / 32, 0);
+		break;
+	}
+}
+
+#ifdef COLLISION_ENABLE_BATCH_TEST
+namespace /* unnamed */ {
+
+/**
+* eXgp̃_Ȍ`쐬.
+*
+* 8{1{́AXu̕sȏꍇʂ悤Ɏɕsɂ.
+*
+* @param type   쐬`̎.
+* @param random .
+*
+* @return 쐬`.
+*/
+Shape MakeRandomShape(ShapeType type, DebugHelper::Random& random)
+{
+	switch (type) {
+	case ShapeType::Circle:
+		return Shape::MakeCircle(random(2, 40));
+	case ShapeType::Rectangle: {
+		const float cx = random(-16, 16);
+		const float cy = random(-16, 16);
+		const float hw = random(2, 40);
+		const float hh = random(2, 40);
+		return Shape::MakeRectangle(XMFLOAT2(cx - hw, cy - hh), XMFLOAT2(cx + hw, cy + hh));
+	}
+	default: {
+		const XMFLOAT2 s(random(-40, 40), random(-40, 40));
+		XMFLOAT2 e(s.x + random(-80, 80), s.y + random(-80, 80));
+		switch ((random.GetSeed() >> 8) % 8) {
+		case 0: e.y = s.y; break;
+		case 1: e.x = s.x; break;
+		}
+		return Shape::MakeLine(s, e);
+	}
+	}
+}
+
+} // unnamed namespace
+
+/**
+* IsCollisionBatch()̌ʂƏԂAIsCollision()Ɣr.
+*
+* 3ނ̌`󂻂ꂼɂcount̃_ȔΏۂ64̔葤̌`쐬A
+* SĂ̌`̑gݍ킹ŁAIsCollisionBatch()̌ʂIsCollision()ʂɌĂ񂾏ꍇƈv邩ׂ.
+* count4̔{łȂ΁A[̗vf̏؂.
+* Ԃ́Agݍ킹ƂɑSĂ̔repeatsA1̔肠̎ԂŔr.
+* ʂPlatform::DebugOutput()ŏo͂.
+*
+* @param count  Ώۂ̌`̐.
+* @param repeat Ԃ̌v.
+*
+* @retval true  SĂ̌ʂv.
+* @retval false vȂʂ.
+*/
+bool TestCollisionBatch(size_t count, int repeat)
+{
+	const ShapeType typeList[] = { ShapeType::Circle, ShapeType::Rectangle, ShapeType::Line };
+	const char* const nameList[] = { "Circle", "Rect", "Line" };
+	const size_t queryCount = 64;
+
+	DebugHelper::Random random;
+	std::vector<Shape> targetList[3];
+	std::vector<XMFLOAT2> targetPos[3];
+	std::vector<Shape> queryList[3];
+	std::vector<XMFLOAT2> queryPos[3];
+	CircleBatch circleBatch;
+	RectBatch rectBatch;
+	LineBatch lineBatch;
+	for (int type = 0; type < 3; ++type) {
+		for (size_t i = 0; i < count; ++i) {
+			targetList[type].push_back(MakeRandomShape(typeList[type], random));
+			targetPos[type].push_back(XMFLOAT2(random(0, 320), random(0, 240)));
+		}
+		for (size_t i = 0; i < queryCount; ++i) {
+			queryList[type].push_back(MakeRandomShape(typeList[type], random));
+			queryPos[type].push_back(XMFLOAT2(random(0, 320), random(0, 240)));
+		}
+	}
+	for (size_t i = 0; i < count; ++i) {
+		circleBatch.Push(targetList[0][i], targetPos[0][i]);
+		rectBatch.Push(targetList[1][i], targetPos[1][i]);
+		lineBatch.Push(targetList[2][i], targetPos[2][i]);
+	}
+
+	bool result = true;
+	std::vector<uint32_t> hitMask;
+	std::vector<uint32_t> scalarMask;
+	for (int queryType = 0; queryType < 3; ++queryType) {
+		for (int targetType = 0; targetType < 3; ++targetType) {
+			const auto runBatch = [&](size_t q) {
+				const Shape& s = queryList[queryType][q];
+				const XMFLOAT2& p = queryPos[queryType][q];
+				switch (targetType) {
+				case 0: IsCollisionBatch(s, p, circleBatch, hitMask); break;
+				case 1: IsCollisionBatch(s, p, rectBatch, hitMask); break;
+				default: IsCollisionBatch(s, p, lineBatch, hitMask); break;
+				}
+			};
+			const auto runScalar = [&](size_t q) {
+				const Shape& s = queryList[queryType][q];
+				const XMFLOAT2& p = queryPos[queryType][q];
+				scalarMask.assign((count + 31) / 32, 0);
+				for (size_t i = 0; i < count; ++i) {
+					if (IsCollision(s, p, targetList[targetType][i], targetPos[targetType][i])) {
+						scalarMask[i / 32] |= 1U << (i % 32);
+					}
+				}
+			};
+
+			size_t hitCount = 0;
+			size_t mismatchCount = 0;
+			for (size_t q = 0; q < queryCount; ++q) {
+				runScalar(q);
+				runBatch(q);
+				for (size_t i = 0; i < count; ++i) {
+					const bool hit = IsHit(scalarMask, i);
+					hitCount += hit;
+					mismatchCount += hit != IsHit(hitMask, i);
+				}
+			}
+
+			const double toNs = 1.0e6 / static_cast<double>(queryCount * count);
+			const double scalarTime = DebugHelper::Measure(repeat, [&]() {
+				for (size_t q = 0; q < queryCount; ++q) {
+					runScalar(q);
+				}
+			}) * toNs;
+			const double batchTime = DebugHelper::Measure(repeat, [&]() {
+				for (size_t q = 0; q < queryCount; ++q) {
+					runBatch(q);
+				}
+			}) * toNs;
+
+			char text[256];
+			snprintf(text, _countof(text), "IsCollisionBatch(%s-%s): hit=%u mismatch=%u scalar=%.2fns batch=%.2fns (x%.2f)\n",
+				nameList[queryType], nameList[targetType], static_cast<uint32_t>(hitCount), static_cast<uint32_t>(mismatchCount),
+				scalarTime, batchTime, batchTime > 0 ? scalarTime / batchTime : 0.0);
+			Platform::DebugOutput(text);
+			if (mismatchCount) {
+				result = false;
+			}
+		}
+	}
+	return result;
+}
+#endif // COLLISION_ENABLE_BATCH_TEST
+
 } // namespace Collision
@@ -4,6 +4,8 @@
 #ifndef DX12TUTORIAL_SRC_COLLISION_H_
 #define DX12TUTORIAL_SRC_COLLISION_H_
 #include <DirectXMath.h>
+#include <vector>
+#include <stdint.h>
 
 /**
 * 蔻薼O.
@@ -29,6 +31,8 @@ class Shape
 {
 	friend struct Detector;
 	friend bool IsCollision(const Shape&, const DirectX::XMFLOAT2&, const Shape&, const DirectX::XMFLOAT2&);
+	friend bool SweepCollision(const Shape&, const DirectX::XMFLOAT2&, const DirectX::XMFLOAT2&,
+		const Shape&, const DirectX::XMFLOAT2&, const DirectX::XMFLOAT2&, float&);
 
 public:
 	struct Circle
@@ -84,6 +88,82 @@ private:
 };
 
 bool IsCollision(const Shape&, const DirectX::XMFLOAT2&, const Shape&, const DirectX::XMFLOAT2&);
+bool SweepCollision(const Shape&, const DirectX::XMFLOAT2&, const DirectX::XMFLOAT2&,
+	const Shape&, const DirectX::XMFLOAT2&, const DirectX::XMFLOAT2&, float& toi);
+
+/**
+* ~`̔Ώۂ܂Ƃ߂ĕێz.
+*
+* vfƂɒSWƔaʁX̔zɊi[.
+* IsCollisionBatch()ŁA1̌`Ƃ܂Ƃ߂Ĕ肷邽߂Ɏg.
+*/
+struct CircleBatch
+{
+	void Clear();
+	bool Push(const Shape& s, const DirectX::XMFLOAT2& p);
+	size_t Size() const { return x.size(); }
+
+	std::vector<float> x; ///< SXW.
+	std::vector<float> y; ///< SYW.
+	std::vector<float> radius; ///< a.
+};
+
+/**
+* `̔Ώۂ܂Ƃ߂ĕێz.
+*
+* ƉE̍ẂA`̍W[hWŊi[.
+*/
+struct RectBatch
+{
+	void Clear();
+	bool Push(const Shape& s, const DirectX::XMFLOAT2& p);
+	size_t Size() const { return left.size(); }
+
+	std::vector<float> left;
+	std::vector<float> top;
+	std::vector<float> right;
+	std::vector<float> bottom;
+};
+
+/**
+* ̔Ώۂ܂Ƃ߂ĕێz.
+*
+* n_ƏI_́A`̍W[hWŊi[.
+*/
+struct LineBatch
+{
+	void Clear();
+	bool Push(const Shape& s, const DirectX::XMFLOAT2& p);
+	size_t Size() const { return startX.size(); }
+
+	std::vector<float> startX;
+	std::vector<float> startY;
+	std::vector<float> endX;
+	std::vector<float> endY;
+};
+
+void IsCollisionBatch(const Shape&, const DirectX::XMFLOAT2&, const CircleBatch&, std::vector<uint32_t>& hitMask);
+void IsCollisionBatch(const Shape&, const DirectX::XMFLOAT2&, const RectBatch&, std::vector<uint32_t>& hitMask);
+void IsCollisionBatch(const Shape&, const DirectX::XMFLOAT2&, const LineBatch&, std::vector<uint32_t>& hitMask);
+
+/**
+* IsCollisionBatch()̌ʂAiԖڂ̗vfՓ˂Ă邩ׂ.
+*
+* @param hitMask IsCollisionBatch()쐬rbg}XN.
+* @param i       ׂvf̃CfbNX.
+*
+* @retval true  Փ˂Ă.
+* @retval false Փ˂ĂȂ.
+*/
+inline bool IsHit(const std::vector<uint32_t>& hitMask, size_t i)
+{
+	return (hitMask[i / 32] >> (i % 32)) & 1;
+}
+
+//#define COLLISION_ENABLE_BATCH_TEST
+#ifdef COLLISION_ENABLE_BATCH_TEST
+bool TestCollisionBatch(size_t count, int repeat);
+#endif // COLLISION_ENABLE_BATCH_TEST
 
 } // namespace Collision
 
@@ -0,0 +1,159 @@
+/**
+* @file CommandStream.cpp
+*/
+#include "CommandStream.h"
+#include "SpriteCore.h"
+
+namespace Sprite {
+
+/**
+* RXgN^.
+*/
+CommandStream::CommandStream() :
+	offset(0, 0),
+	drawStart(0)
+{
+}
+
+/**
+* L^ej.
+*
+* mۍς݂͉̃Ȃ̂ŁAt[Xg[g񂷂Ƃł.
+*/
+void CommandStream::Reset()
+{
+	commandList.clear();
+	vertexList.clear();
+	stateList.clear();
+	bundleList.clear();
+	offset = DirectX::XMFLOAT2(0, 0);
+	drawStart = 0;
+}
+
+/**
+* `Xe[g̕ύXL^.
+*
+* @param state ȍ~̕`Ɏgp`Xe[g.
+*/
+void CommandStream::SetState(const StreamState& state)
+{
+	commandList.push_back(Command{ CommandType::SetState, static_cast<uint32_t>(stateList.size()), 0, 0 });
+	stateList.push_back(state);
+	offset = DirectX::XMFLOAT2(-(state.viewport.z * 0.5f), state.viewport.w * 0.5f);
+}
+
+/**
+* oh̕ύXL^.
+*
+* L^oh́AXg[Zbg܂ŔjȂ.
+*
+* @param bundleId ȍ~̕`ɎgpohID.
+*/
+void CommandStream::BindBundle(const BundleId& bundleId)
+{
+	commandList.push_back(Command{ CommandType::BindBundle, static_cast<uint32_t>(bundleList.size()), 0, 0 });
+	bundleList.push_back(bundleId);
+}
+
+/**
+* XvCg̕`L^.
+*
+* @param first    `悷XvCg̐擪.
+* @param last     `悷XvCg̏I[.
+* @param cellList `ɎgpZXg.
+*
+* @retval true  L^.
+* @retval false `Xe[g܂̓ohݒ肳ĂȂ.
+*/
+bool CommandStream::Draw(const Sprite* first, const Sprite* last, const Cell* cellList)
+{
+	if (!BeginDraw()) {
+		return false;
+	}
+	for (const Sprite* sprite = first; sprite != last; ++sprite) {
+		AddSprite(*sprite, cellList);
+	}
+	EndDraw();
+	return true;
+}
+
+/**
+* XvCg̕`L^.
+*
+* @param spriteList `悷XvCg̃Xg.
+* @param cellList   `ɎgpZXg.
+*
+* @retval true  L^.
+* @retval false `Xe[g܂̓ohݒ肳ĂȂ.
+*/
+bool CommandStream::Draw(const std::vector<Sprite>& spriteList, const Cell* cellList)
+{
+	if (spriteList.empty()) {
+		return BeginDraw();
+	}
+	return Draw(&*spriteList.begin(), (&*spriteList.begin()) + spriteList.size(), cellList);
+}
+
+/**
+* 쐬ς݂̒_f[^̕`L^.
+*
+* @param first `悷钸_f[^̐擪.
+* @param last  `悷钸_f[^̏I[.
+*
+* @retval true  L^.
+* @retval false `Xe[g܂̓ohݒ肳ĂȂ.
+*/
+bool CommandStream::Draw(const Vertex* first, const Vertex* last)
+{
+	if (!BeginDraw()) {
+		return false;
+	}
+	vertexList.insert(vertexList.end(), first, first + (last - first) / 4 * 4);
+	EndDraw();
+	return true;
+}
+
+/**
+* `R}h̋L^Jn.
+*
+* @retval true  L^\.
+* @retval false `Xe[g܂̓ohݒ肳ĂȂ.
+*/
+bool CommandStream::BeginDraw()
+{
+	if (stateList.empty() || bundleList.empty()) {
+		return false;
+	}
+	drawStart = vertexList.size();
+	return true;
+}
+
+/**
+* XvCg̒_f[^ǉ.
+*
+* @param sprite   ǉXvCg.
+* @param cellList XvCggpZXg.
+*/
+void CommandStream::AddSprite(const Sprite& sprite, const Cell* cellList)
+{
+	if (sprite.scale.x == 0 || sprite.scale.y == 0) {
+		return;
+	}
+	const size_t index = vertexList.size();
+	vertexList.resize(index + 4);
+	AddVertex(sprite, cellList + sprite.GetCellIndex(), sprite.animeController.GetData(), &vertexList[index], offset);
+}
+
+/**
+* `R}h̋L^I.
+*
+* _f[^1ǉȂꍇA`R}h͋L^Ȃ.
+*/
+void CommandStream::EndDraw()
+{
+	if (vertexList.size() > drawStart) {
+		commandList.push_back(Command{ CommandType::Draw, 0, static_cast<uint32_t>(drawStart), static_cast<uint32_t>(vertexList.size() - drawStart) });
+	}
+}
+
+} // namespace Sprite
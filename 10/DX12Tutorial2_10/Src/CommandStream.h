@@ -0,0 +1,103 @@
+/**
+* @file CommandStream.h
+*/
+#ifndef DX12TUTORIAL_SRC_COMMANDSTREAM_H_
+#define DX12TUTORIAL_SRC_COMMANDSTREAM_H_
+#include "SpriteTypes.h"
+#include <DirectXMath.h>
+#include <vector>
+#include <stdint.h>
+
+namespace Sprite {
+
+struct Sprite;
+
+/**
+* R}hXg[ɋL^`Xe[g.
+*/
+struct StreamState
+{
+	DirectX::XMFLOAT4X4 matViewProjection; ///< `ɎgpWϊs.
+	DirectX::XMFLOAT4 viewport; ///< `pr[|[g(X, Y, , ).
+};
+
+/**
+* `R}h̎.
+*/
+enum class CommandType
+{
+	SetState, ///< `Xe[gύX. index̓Xe[g̃CfbNX.
+	BindBundle, ///< ohύX. index̓oh̃CfbNX.
+	Draw, ///< _f[^`悷. first, count͒_f[^͈̔.
+};
+
+/**
+* `R}h.
+*/
+struct Command
+{
+	CommandType type;
+	uint32_t index;
+	uint32_t first;
+	uint32_t count;
+};
+
+/**
+* XvCg̕`eL^NX.
+*
+* `R}hƒ_f[^CPŨɋL^邾ŁAOtBbNXAPIɂ͐GȂ.
+* ̂߁AV[⃌C[ƂɃXg[pӂ΁Aꂼʂ̃XbhŋL^ł.
+* L^éACXbhRenderer::Submit()ɓnƂŎۂ̃R}hXgɕϊ.
+*
+* L^eGetCommandList()ȂǂŎ擾ł̂ŁAGPUȂĂL^ʂ؂ł.
+*
+* 1̃Xg[𕡐̃Xbh瓯ɑ삵Ă͂ȂȂ.
+*/
+class CommandStream
+{
+public:
+	CommandStream();
+	~CommandStream() = default;
+
+	void Reset();
+	void SetState(const StreamState& state);
+	void BindBundle(const BundleId& bundleId);
+	bool Draw(const Sprite* first, const Sprite* last, const Cell* cellList);
+	bool Draw(const std::vector<Sprite>& spriteList, const Cell* cellList);
+	bool Draw(const Vertex* first, const Vertex* last);
+	bool Empty() const { return commandList.empty(); }
+
+	template<typename Iterator>
+	bool Draw(Iterator first, Iterator last, const Cell* cellList)
+	{
+		if (!BeginDraw()) {
+			return false;
+		}
+		for (Iterator sprite = first; sprite != last; ++sprite) {
+			AddSprite(*sprite, cellList);
+		}
+		EndDraw();
+		return true;
+	}
+
+	const std::vector<Command>& GetCommandList() const { return commandList; }
+	const std::vector<Vertex>& GetVertexList() const { return vertexList; }
+	const std::vector<StreamState>& GetStateList() const { return stateList; }
+	const std::vector<BundleId>& GetBundleList() const { return bundleList; }
+
+private:
+	bool BeginDraw();
+	void AddSprite(const Sprite& sprite, const Cell* cellList);
+	void EndDraw();
+
+	std::vector<Command> commandList;
+	std::vector<Vertex> vertexList;
+	std::vector<StreamState> stateList;
+	std::vector<BundleId> bundleList;
+	DirectX::XMFLOAT2 offset; ///< ݂̃Xe[gɂXN[W.
+	size_t drawStart; ///< L^̕`R}h̍ŏ̒_̃CfbNX.
+};
+
+} // namespace Sprite
+
+#endif // DX12TUTORIAL_SRC_COMMANDSTREAM_H_
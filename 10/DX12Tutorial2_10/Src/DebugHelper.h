@@ -0,0 +1,91 @@
+/**
+* @file DebugHelper.h
+*
+* rEvp̃R[hŋʂɎg@\.
+*/
+#ifndef DX12TUTORIAL_SRC_DEBUGHELPER_H_
+#define DX12TUTORIAL_SRC_DEBUGHELPER_H_
+#include "Platform.h"
+#include <DirectXMath.h>
+#include <stdint.h>
+#include <math.h>
+
+namespace DebugHelper {
+
+/**
+* rEvp̗.
+*
+* `@ɂ. 킪Ȃɓn𐶐̂ŁArʂČł.
+*/
+class Random
+{
+public:
+	explicit Random(uint32_t s = 12345) : seed(s) {}
+
+	/**
+	* ̗𐶐.
+	*
+	* @return . ʃrbg͎ẐŁAʃrbgg.
+	*/
+	uint32_t Next()
+	{
+		seed = seed * 1664525 + 1013904223;
+		return seed;
+	}
+
+	/**
+	* ͈͂w肵ė𐶐.
+	*
+	* @param minValue ŏl.
+	* @param maxValue ől.
+	*
+	* @return minValueȏmaxValue̗.
+	*/
+	float operator()(float minValue, float maxValue)
+	{
+		return minValue + static_cast<float>(Next() >> 8) / 16777216.0f * (maxValue - minValue);
+	}
+
+	uint32_t GetSeed() const { return seed; }
+
+private:
+	uint32_t seed;
+};
+
+/**
+* 2̍Ŵ߂.
+*
+* @param a rW.
+* @param b rW.
+*
+* @return XY̍̐Βl̂A傫ق.
+*/
+inline float GetError(const DirectX::XMFLOAT2& a, const DirectX::XMFLOAT2& b)
+{
+	const float dx = fabsf(a.x - b.x);
+	const float dy = fabsf(a.y - b.y);
+	return dx > dy ? dx : dy;
+}
+
+/**
+* Ԃv.
+*
+* @param repeat JԂ.
+* @param func   v鏈.
+*
+* @return 1񂠂̏(~b).
+*/
+template<typename F>
+double Measure(int repeat, F func)
+{
+	const int64_t t0 = Platform::GetPerformanceCounter();
+	for (int i = 0; i < repeat; ++i) {
+		func();
+	}
+	const int64_t t1 = Platform::GetPerformanceCounter();
+	return Platform::ToMilliseconds(t0, t1) / repeat;
+}
+
+} // namespace DebugHelper
+
+#endif // DX12TUTORIAL_SRC_DEBUGHELPER_H_
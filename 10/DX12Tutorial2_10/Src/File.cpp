@@ -2,8 +2,14 @@
 * @file File.cpp
 */
 #include "File.h"
+#include "Platform.h"
 #include <string>
+#ifdef _WIN32
 #include <Windows.h>
+#else
+#include <stdio.h>
+#include <stdlib.h>
+#endif // _WIN32
 
 /**
 * t@C𑀍삷@\i[閼O.
@@ -21,6 +27,7 @@ namespace File {
 */
 bool Read(const wchar_t* filename, BufferType& buffer)
 {
+#ifdef _WIN32
 	HANDLE h = CreateFileW(filename, GENERIC_READ, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
 	if (h == INVALID_HANDLE_VALUE) {
 		OutputDebugStringW((std::wstring(L"ERROR: '") + filename + L"'̃I[vɎs\n").c_str());
@@ -41,6 +48,36 @@ bool Read(const wchar_t* filename, BufferType& buffer)
 		return false;
 	}
 	return true;
+#else
+	std::string name(wcslen(filename) * MB_CUR_MAX + 1, '\0');
+	const size_t nameLength = wcstombs(&name[0], filename, name.size());
+	if (nameLength == static_cast<size_t>(-1)) {
+		Platform::DebugOutput("ERROR: t@C̕ϊɎs\n");
+		return false;
+	}
+	name.resize(nameLength);
+	FILE* fp = fopen(name.c_str(), "rb");
+	if (!fp) {
+		Platform::DebugOutput((std::string("ERROR: '") + name + "'̃I[vɎs\n").c_str());
+		return false;
+	}
+	fseek(fp, 0, SEEK_END);
+	const long size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	if (size < 0) {
+		fclose(fp);
+		Platform::DebugOutput((std::string("ERROR: '") + name + "'̃t@CTCY擾Ɏs\n").c_str());
+		return false;
+	}
+	buffer.resize(static_cast<size_t>(size));
+	const size_t readBytes = fread(buffer.data(), 1, buffer.size(), fp);
+	fclose(fp);
+	if (readBytes != buffer.size()) {
+		Platform::DebugOutput((std::string("ERROR: '") + name + "'̓ǂݍ݂Ɏs\n").c_str());
+		return false;
+	}
+	return true;
+#endif // _WIN32
 }
 
 } // namespace File
\ No newline at end of file
@@ -239,7 +239,9 @@ bool Graphics::Initialize(HWND hwnd, int clientWidth, int clientHeight)
 	if (!loader.Begin(csuDescriptorHeap)) {
 		return false;
 	}
-	if (!spriteRenderer.Init(device, frameBufferCount, 10000, loader)) {
+	// eʂ͒_Ŏw肷. ؂l߂`̃XvCg112_g߁A
+	// `Ȃ7500A؂l߂`󂾂ł2500`ł傫ɂĂ.
+	if (!spriteRenderer.Init(device, frameBufferCount, 30000, loader)) {
 		return false;
 	}
 	ID3D12CommandList* ppCommandLists[] = { loader.End() };
@@ -26,7 +26,7 @@ const D3D12_INPUT_ELEMENT_DESC terrainVertexLayout[] = {
 };
 
 bool LoadShader(const wchar_t* filename, const char* target, ID3DBlob** blob);
-bool CreatePSO(PSO& pso, ID3D12Device* device, bool warp, const wchar_t* vs, const wchar_t* ps, const wchar_t* hs, const wchar_t* ds, const D3D12_BLEND_DESC& blendDesc);
+bool CreatePSO(PSO& pso, ID3D12Device* device, bool warp, const wchar_t* vs, const wchar_t* ps, const wchar_t* hs, const wchar_t* ds, const D3D12_BLEND_DESC& blendDesc, UINT srvCount = 1);
 
 /**
 * VF[_ǂݍ.
@@ -56,11 +56,12 @@ bool LoadShader(const wchar_t* filename, const char* target, ID3DBlob** blob)
 * @param pso 쐬PSOIuWFNg.
 * @param vs  쐬PSOɐݒ肷钸_VF[_t@C.
 * @param ps  쐬PSOɐݒ肷sNZVF[_t@C.
+* @param srvCount [gp[^0̃fXNv^e[uɊ܂߂SRV̐.
 *
 * @retval true  쐬.
 * @retval false 쐬s.
 */
-bool CreatePSO(PSO& pso, ID3D12Device* device, bool warp, const wchar_t* vs, const wchar_t* ps, const wchar_t* hs, const wchar_t* ds, const D3D12_BLEND_DESC& blendDesc)
+bool CreatePSO(PSO& pso, ID3D12Device* device, bool warp, const wchar_t* vs, const wchar_t* ps, const wchar_t* hs, const wchar_t* ds, const D3D12_BLEND_DESC& blendDesc, UINT srvCount)
 {
 	ComPtr<ID3DBlob> vertexShaderBlob;
 	if (!LoadShader(vs, "vs_5_0", &vertexShaderBlob)) {
@@ -84,7 +85,7 @@ bool CreatePSO(PSO& pso, ID3D12Device* device, bool warp, const wchar_t* vs, con
 	// [gVOl`ݒ肳ĂȂꍇłAVOl`̍쐬ɂ͐邱Ƃ.
 	// ̏ꍇAPSO쐬ɃG[.
 	{
-		D3D12_DESCRIPTOR_RANGE descRange0[] = { CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0) };
+		D3D12_DESCRIPTOR_RANGE descRange0[] = { CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, srvCount, 0) };
 		D3D12_DESCRIPTOR_RANGE descRange1[] = { CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, 1, 0) };
 		D3D12_STATIC_SAMPLER_DESC staticSampler[] = { CD3DX12_STATIC_SAMPLER_DESC(0) };
 		CD3DX12_ROOT_PARAMETER rootParameters[3];
@@ -180,6 +181,9 @@ bool CreatePSOList(ID3D12Device* device, bool warp)
 	if (!CreatePSO(psoList[PSOType_Sprite], device, warp, L"Res/VertexShader.hlsl", L"Res/PixelShader.hlsl", nullptr, nullptr, blendDesc)) {
 		return false;
 	}
+	if (!CreatePSO(psoList[PSOType_PaletteSprite], device, warp, L"Res/PaletteSpriteVS.hlsl", L"Res/PaletteSpritePS.hlsl", nullptr, nullptr, blendDesc, 2)) {
+		return false;
+	}
 	return true;
 }
 
@@ -23,6 +23,7 @@ enum PSOType {
 	PSOType_NoiseTexture,
 	PSOType_Sprite,
     PSOType_Terrain,
+	PSOType_PaletteSprite,
 	countof_PSOType
 };
 
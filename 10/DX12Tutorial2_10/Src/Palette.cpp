@@ -0,0 +1,289 @@
+/**
+* @file Palette.cpp
+*
+* pbgteNX`쐬邽߂́ACPǓFƃpbg̔zu.
+*
+* pbgteNX`̓CfbNX摜ƃpbg摜2ō\.
+* - CfbNX摜1sNZ8rbgŁApbg̉Ԗڂ̐Fg\.
+* - pbg摜͕256sNZŁA1s1̃pbgɑΉ.
+*   XvCgpaletteIndexAgps̔ԍɂȂ.
+*
+* CfbNX摜ɑ΂ăpbg𕡐pӂ΁A1̃ZŐFႢ̃XvCg\ł.
+*/
+#include "Palette.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace Sprite {
+
+namespace /* unnamed */ {
+
+/**
+* Fp̐F̏.
+*/
+struct ColorCount
+{
+	uint32_t color; ///< RGBA8`̐F.
+	uint32_t count; ///< ̐FgĂsNZ.
+};
+
+/**
+* fBAJbg@ŎgAFԂ̔.
+*
+* Fp̐F̔ẑA[first, last)͈̔͂S.
+*/
+struct ColorBox
+{
+	size_t first;
+	size_t last;
+};
+
+/**
+* Fw肳ꂽ`l̒lo.
+*
+* @param color   RGBA8`̐F.
+* @param channel `lԍ(0=R, 1=G, 2=B, 3=A).
+*
+* @return `l̒l(0`255).
+*/
+uint32_t GetChannel(uint32_t color, int channel)
+{
+	return (color >> (channel * 8)) & 0xff;
+}
+
+/**
+* ̒ŁAl͈̔͂łL`l𒲂ׂ.
+*
+* @param list Fp̐F̔z.
+* @param box  ׂ锠.
+* @param range łL`l̒l͈̔͂i[ϐ.
+*
+* @return l͈̔͂łL`l̔ԍ.
+*/
+int FindWidestChannel(const std::vector<ColorCount>& list, const ColorBox& box, uint32_t& range)
+{
+	uint32_t minValue[4] = { 255, 255, 255, 255 };
+	uint32_t maxValue[4] = { 0, 0, 0, 0 };
+	for (size_t i = box.first; i < box.last; ++i) {
+		for (int ch = 0; ch < 4; ++ch) {
+			const uint32_t c = GetChannel(list[i].color, ch);
+			minValue[ch] = std::min(minValue[ch], c);
+			maxValue[ch] = std::max(maxValue[ch], c);
+		}
+	}
+	int widest = 0;
+	range = 0;
+	for (int ch = 0; ch < 4; ++ch) {
+		if (maxValue[ch] - minValue[ch] > range) {
+			range = maxValue[ch] - minValue[ch];
+			widest = ch;
+		}
+	}
+	return widest;
+}
+
+/**
+* Ɋ܂܂F́AsNZŏdݕtϐF߂.
+*
+* @param list Fp̐F̔z.
+* @param box  ϐF߂锠.
+*
+* @return ϐF.
+*/
+uint32_t AverageColor(const std::vector<ColorCount>& list, const ColorBox& box)
+{
+	uint64_t sum[4] = {};
+	uint64_t total = 0;
+	for (size_t i = box.first; i < box.last; ++i) {
+		for (int ch = 0; ch < 4; ++ch) {
+			sum[ch] += static_cast<uint64_t>(GetChannel(list[i].color, ch)) * list[i].count;
+		}
+		total += list[i].count;
+	}
+	uint32_t color = 0;
+	for (int ch = 0; ch < 4; ++ch) {
+		color |= static_cast<uint32_t>((sum[ch] + total / 2) / total) << (ch * 8);
+	}
+	return color;
+}
+
+} // unnamed namespace
+
+/**
+* RGBA8`̉摜8rbgCfbNX`ɌF.
+*
+* At@l0̃sNZׂ͂ăCfbNX0ɂȂApbg0Ԃ͊SȓFɂȂ.
+* ȊO̐F(maxColors - 1)FȉȂAF͕ωȂ.
+* ꍇ̓fBAJbg@(maxColors - 1)FɌF.
+*
+* @param src       F摜.
+* @param dst       F摜i[IuWFNg.
+* @param palette   쐬pbgi[IuWFNg. vfmaxColorsɂȂ.
+* @param maxColors pbg̐F(2`256).
+*
+* @retval true  F.
+* @retval false s.
+*/
+bool QuantizeImage(const Image& src, IndexedImage& dst, Palette& palette, size_t maxColors)
+{
+	if (src.data.empty() || maxColors < 2 || maxColors > 256) {
+		return false;
+	}
+
+	// gĂFƁÃsNZ𐔂.
+	std::unordered_map<uint32_t, uint32_t> histogram;
+	for (uint32_t c : src.data) {
+		if (c >> 24) {
+			++histogram[c];
+		}
+	}
+	std::vector<ColorCount> list;
+	list.reserve(histogram.size());
+	for (const auto& e : histogram) {
+		list.push_back({ e.first, e.second });
+	}
+	std::sort(list.begin(), list.end(), [](const ColorCount& lhs, const ColorCount& rhs) { return lhs.color < rhs.color; });
+
+	// F܂܂ŁAl͈̔͂łL𒆉lŕ.
+	std::vector<ColorBox> boxList;
+	if (!list.empty()) {
+		boxList.push_back({ 0, list.size() });
+	}
+	while (boxList.size() < maxColors - 1) {
+		size_t target = boxList.size();
+		uint32_t targetRange = 0;
+		int targetChannel = 0;
+		for (size_t i = 0; i < boxList.size(); ++i) {
+			if (boxList[i].last - boxList[i].first < 2) {
+				continue;
+			}
+			uint32_t range;
+			const int ch = FindWidestChannel(list, boxList[i], range);
+			if (range > targetRange) {
+				target = i;
+				targetRange = range;
+				targetChannel = ch;
+			}
+		}
+		if (target >= boxList.size()) {
+			break;
+		}
+		ColorBox& box = boxList[target];
+		std::sort(list.begin() + box.first, list.begin() + box.last,
+			[targetChannel](const ColorCount& lhs, const ColorCount& rhs) { return GetChannel(lhs.color, targetChannel) < GetChannel(rhs.color, targetChannel); });
+		uint64_t total = 0;
+		for (size_t i = box.first; i < box.last; ++i) {
+			total += list[i].count;
+		}
+		size_t median = box.first;
+		for (uint64_t n = 0; median < box.last - 1 && n + list[median].count <= total / 2; ++median) {
+			n += list[median].count;
+		}
+		median = std::max(median, box.first + 1);
+		const ColorBox newBox = { median, box.last };
+		box.last = median;
+		boxList.push_back(newBox);
+	}
+
+	// ƂɕϐFpbgɓo^A̐F甠̔ԍ悤ɂ.
+	palette.assign(maxColors, 0);
+	std::unordered_map<uint32_t, uint8_t> colorToIndex;
+	colorToIndex.reserve(list.size());
+	for (size_t i = 0; i < boxList.size(); ++i) {
+		const uint8_t index = static_cast<uint8_t>(i + 1);
+		palette[index] = AverageColor(list, boxList[i]);
+		for (size_t n = boxList[i].first; n < boxList[i].last; ++n) {
+			colorToIndex[list[n].color] = index;
+		}
+	}
+
+	dst.width = src.width;
+	dst.height = src.height;
+	dst.data.resize(src.data.size());
+	for (size_t i = 0; i < src.data.size(); ++i) {
+		const uint32_t c = src.data[i];
+		dst.data[i] = (c >> 24) ? colorToIndex[c] : 0;
+	}
+	return true;
+}
+
+/**
+* FႢ̉摜ACfbNX摜ɑΉpbg쐬.
+*
+* CfbNX摜(x, y)畝width, height͈̔͂ƁAFႢ̉摜(vx, vy)n܂
+* 傫͈̔͂rACfbNXƂɐFႢ̉摜ŎgĂFpbgɐݒ肷.
+* ͈͓ŎgĂȂCfbNX̐F́AbasePalette̐F̂܂܂ɂȂ.
+*
+* @param index          CfbNX摜.
+* @param x              CfbNX摜̔r͈͂̍XW.
+* @param y              CfbNX摜̔r͈͂̍YW.
+* @param width          r͈͂̕.
+* @param height         r͈͂̍.
+* @param variant        FႢ̉摜.
+* @param vx             FႢ̉摜̔r͈͂̍XW.
+* @param vy             FႢ̉摜̔r͈͂̍YW.
+* @param basePalette    CfbNX摜̃pbg.
+* @param variantPalette 쐬pbgi[IuWFNg.
+*
+* @retval true  쐬.
+* @retval false ͈͂摜͂ݏoĂ.
+*               ܂́ACfbNXɈقȂFΉĂāAF̒uł͕\łȂ.
+*               ̏ꍇAvariantPaletteɂ͍ŏɌFݒ肳.
+*/
+bool MakeVariantPalette(const IndexedImage& index, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+	const Image& variant, uint32_t vx, uint32_t vy, const Palette& basePalette, Palette& variantPalette)
+{
+	variantPalette = basePalette;
+	if (x + width > index.width || y + height > index.height || vx + width > variant.width || vy + height > variant.height) {
+		return false;
+	}
+	bool assigned[256] = {};
+	bool result = true;
+	for (uint32_t row = 0; row < height; ++row) {
+		const uint8_t* pIndex = index.data.data() + (y + row) * index.width + x;
+		const uint32_t* pColor = variant.data.data() + (vy + row) * variant.width + vx;
+		for (uint32_t col = 0; col < width; ++col) {
+			const uint8_t i = pIndex[col];
+			if (i >= variantPalette.size()) {
+				variantPalette.resize(i + 1, 0);
+			}
+			if (!assigned[i]) {
+				variantPalette[i] = pColor[col];
+				assigned[i] = true;
+			} else if (variantPalette[i] != pColor[col]) {
+				result = false;
+			}
+		}
+	}
+	return result;
+}
+
+/**
+* ̃pbg1̃pbg摜ɂ܂Ƃ߂.
+*
+* pbg摜͕256sNZA̓pbg̐ɂȂ.
+* nԖڂ̃pbgnsڂɔzuA256FɖȂ͓FŖ߂.
+*
+* @param paletteList ܂Ƃ߂pbg̔z.
+* @param page        ܂Ƃ߂pbg摜i[IuWFNg.
+*
+* @retval true  쐬.
+* @retval false pbg1Ȃ.
+*/
+bool PackPalette(const std::vector<Palette>& paletteList, Image& page)
+{
+	if (paletteList.empty()) {
+		return false;
+	}
+	page.width = 256;
+	page.height = static_cast<uint32_t>(paletteList.size());
+	page.data.assign(page.width * page.height, 0);
+	for (size_t row = 0; row < paletteList.size(); ++row) {
+		const Palette& palette = paletteList[row];
+		const size_t count = std::min<size_t>(palette.size(), page.width);
+		std::copy(palette.begin(), palette.begin() + count, page.data.begin() + row * page.width);
+	}
+	return true;
+}
+
+} // namespace Sprite
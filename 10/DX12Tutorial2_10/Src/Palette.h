@@ -0,0 +1,19 @@
+/**
+* @file Palette.h
+*/
+#ifndef DX12TUTORIAL_SRC_PALETTE_H_
+#define DX12TUTORIAL_SRC_PALETTE_H_
+#include "SpriteTypes.h"
+#include <vector>
+#include <stdint.h>
+
+namespace Sprite {
+
+bool QuantizeImage(const Image& src, IndexedImage& dst, Palette& palette, size_t maxColors = 256);
+bool MakeVariantPalette(const IndexedImage& index, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+	const Image& variant, uint32_t vx, uint32_t vy, const Palette& basePalette, Palette& variantPalette);
+bool PackPalette(const std::vector<Palette>& paletteList, Image& page);
+
+} // namespace Sprite
+
+#endif // DX12TUTORIAL_SRC_PALETTE_H_
@@ -0,0 +1,65 @@
+/**
+* @file Platform.cpp
+*/
+#include "Platform.h"
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <chrono>
+#include <stdio.h>
+#endif // _WIN32
+
+/**
+* OSɈˑ@\i[閼O.
+*/
+namespace Platform {
+
+/**
+* fobOp̕o͂.
+*
+* Windowsł̓fobK̏o̓EBhEɁAȊOł͕WG[o͂ɏo͂.
+*
+* @param text o͂镶.
+*/
+void DebugOutput(const char* text)
+{
+#ifdef _WIN32
+	OutputDebugStringA(text);
+#else
+	fputs(text, stderr);
+#endif // _WIN32
+}
+
+/**
+* ptH[}XJE^̌ݒl擾.
+*
+* @return JE^l. 1b̑ʂGetPerformanceFrequency()Ŏ擾ł.
+*/
+int64_t GetPerformanceCounter()
+{
+#ifdef _WIN32
+	LARGE_INTEGER i;
+	QueryPerformanceCounter(&i);
+	return i.QuadPart;
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif // _WIN32
+}
+
+/**
+* ptH[}XJE^1b̑ʂ擾.
+*
+* @return 1b̑.
+*/
+int64_t GetPerformanceFrequency()
+{
+#ifdef _WIN32
+	LARGE_INTEGER i;
+	QueryPerformanceFrequency(&i);
+	return i.QuadPart;
+#else
+	return 1000000000;
+#endif // _WIN32
+}
+
+} // namespace Platform
@@ -0,0 +1,40 @@
+/**
+* @file Platform.h
+*
+* OSɈˑ@\̑.
+*
+* fobOo͂ƎԌv܂Ƃ߂Ă. WindowsȊOł͕WCuőւ邽߁A
+* XvCg̒_쐬\tgEFA`Ȃǂ̃OtBbNXAPIɈˑȂ́A
+* windows.hȂŃrhł.
+*/
+#ifndef DX12TUTORIAL_SRC_PLATFORM_H_
+#define DX12TUTORIAL_SRC_PLATFORM_H_
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef _countof
+#define _countof(a) (sizeof(a) / sizeof((a)[0]))
+#endif // _countof
+
+namespace Platform {
+
+void DebugOutput(const char* text);
+int64_t GetPerformanceCounter();
+int64_t GetPerformanceFrequency();
+
+/**
+* 2̃ptH[}XJE^̒l̍~bɕϊ.
+*
+* @param start vJñJE^l.
+* @param end   vĨJE^l.
+*
+* @return startend܂ł̌oߎ(~b).
+*/
+inline double ToMilliseconds(int64_t start, int64_t end)
+{
+	return static_cast<double>(end - start) * 1000.0 / static_cast<double>(GetPerformanceFrequency());
+}
+
+} // namespace Platform
+
+#endif // DX12TUTORIAL_SRC_PLATFORM_H_
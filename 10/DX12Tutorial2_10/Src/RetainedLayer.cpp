@@ -0,0 +1,271 @@
+/**
+* @file RetainedLayer.cpp
+*/
+#include "RetainedLayer.h"
+#include <algorithm>
+
+using namespace DirectX;
+
+namespace Sprite {
+
+/**
+* RXgN^.
+*/
+RetainedLayer::RetainedLayer() :
+	offset(0, 0)
+{
+}
+
+/**
+* .
+*
+* o^ς݂̃XvCg͑Sēo^.
+*
+* @param screenSize XN[̕ƍ.
+*/
+void RetainedLayer::Init(const XMFLOAT2& screenSize)
+{
+	offset = XMFLOAT2(-screenSize.x * 0.5f, screenSize.y * 0.5f);
+	slotList.clear();
+	freeSlotList.clear();
+	dirtySlotList.clear();
+	vertexList.clear();
+}
+
+/**
+* XvCgo^.
+*
+* o^XvCg̒_f[^́AUpdate()ō쐬.
+*
+* @param sprite   o^XvCg.
+* @param cellList XvCggpZXg.
+*
+* @return 蓖ĂꂽXbg̔ԍ.
+*/
+size_t RetainedLayer::Add(Sprite& sprite, const Cell* cellList)
+{
+	size_t slot;
+	if (!freeSlotList.empty()) {
+		slot = freeSlotList.back();
+		freeSlotList.pop_back();
+	} else {
+		slot = slotList.size();
+		slotList.push_back(Slot{ nullptr, nullptr, false });
+		vertexList.resize(vertexList.size() + 4);
+	}
+	Slot& e = slotList[slot];
+	e.sprite = &sprite;
+	e.cellList = cellList;
+	MarkDirty(slot);
+	return slot;
+}
+
+/**
+* XvCg̓o^.
+*
+* Xbg͋󂫃XbgƂčėp.
+* 󂫃Xbg͖ʐ0̎lp`Ƃĕ`悳邽߁Aʂɂ͉\Ȃ.
+*
+* @param slot o^Xbg̔ԍ.
+*/
+void RetainedLayer::Remove(size_t slot)
+{
+	if (slot >= slotList.size() || !slotList[slot].sprite) {
+		return;
+	}
+	slotList[slot].sprite = nullptr;
+	ClearVertex(slot);
+	freeSlotList.push_back(slot);
+}
+
+/**
+* Xbg̒_f[^AUpdate()ō蒼悤ɂ.
+*
+* XvCg𒼐ڏꍇɌĂяo.
+*
+* @param slot 蒼Xbg̔ԍ.
+*/
+void RetainedLayer::MarkDirty(size_t slot)
+{
+	if (slot < slotList.size() && slotList[slot].sprite && !slotList[slot].dirty) {
+		slotList[slot].dirty = true;
+		dirtySlotList.push_back(slot);
+	}
+}
+
+/**
+* XvCg̈ʒuύX.
+*
+* @param slot ύXXbg̔ԍ.
+* @param pos  Vʒu.
+*/
+void RetainedLayer::SetPosition(size_t slot, const XMFLOAT3& pos)
+{
+	if (Sprite* sprite = Modify(slot)) {
+		sprite->pos = pos;
+	}
+}
+
+/**
+* XvCg̉]pύX.
+*
+* @param slot     ύXXbg̔ԍ.
+* @param rotation V]p(WA).
+*/
+void RetainedLayer::SetRotation(size_t slot, float rotation)
+{
+	if (Sprite* sprite = Modify(slot)) {
+		sprite->rotation = rotation;
+	}
+}
+
+/**
+* XvCg̊g嗦ύX.
+*
+* @param slot  ύXXbg̔ԍ.
+* @param scale Vg嗦. XY0̏ꍇ͕`悳Ȃ.
+*/
+void RetainedLayer::SetScale(size_t slot, const XMFLOAT2& scale)
+{
+	if (Sprite* sprite = Modify(slot)) {
+		sprite->scale = scale;
+	}
+}
+
+/**
+* XvCg̐FύX.
+*
+* @param slot  ύXXbg̔ԍ.
+* @param color VF.
+*/
+void RetainedLayer::SetColor(size_t slot, const XMFLOAT4& color)
+{
+	if (Sprite* sprite = Modify(slot)) {
+		sprite->color = color;
+	}
+}
+
+/**
+* XvCg\ZύX.
+*
+* @param slot      ύXXbg̔ԍ.
+* @param cellIndex VZ̃CfbNX.
+*/
+void RetainedLayer::SetCellIndex(size_t slot, uint32_t cellIndex)
+{
+	if (Sprite* sprite = Modify(slot)) {
+		sprite->animeController.SetCellIndex(cellIndex);
+	}
+}
+
+/**
+* Xbgɓo^ꂽXvCg擾.
+*
+* @param slot Xbg̔ԍ.
+*
+* @retval nullptrȊO Xbgɓo^ꂽXvCg.
+* @retval nullptr     Xbg󂢂ĂA܂͔͈͊O.
+*/
+const Sprite* RetainedLayer::Get(size_t slot) const
+{
+	return (slot < slotList.size()) ? slotList[slot].sprite : nullptr;
+}
+
+/**
+* ύXꂽXvCg̒_f[^蒼.
+*
+* ύXXgɓo^ꂽXbg.
+*
+* @return _f[^蒼Xbg̐.
+*/
+size_t RetainedLayer::Update()
+{
+	size_t count = 0;
+	for (size_t i : dirtySlotList) {
+		Slot& e = slotList[i];
+		e.dirty = false;
+		if (!e.sprite) {
+			continue;
+		}
+		if (e.sprite->scale.x == 0 || e.sprite->scale.y == 0) {
+			ClearVertex(i);
+		} else {
+			AddVertex(*e.sprite, e.cellList + e.sprite->GetCellIndex(), e.sprite->animeController.GetData(), &vertexList[i * 4], offset);
+		}
+		++count;
+	}
+	dirtySlotList.clear();
+	return count;
+}
+
+/**
+* SẴXbg`悷.
+*
+* @param renderer `Ɏgp郌_[.
+* @param bundleId `ɎgpohID.
+* @param info     `.
+*
+* @retval true  R}hXg쐬.
+* @retval false R}hXg쐬s.
+*/
+bool RetainedLayer::Draw(Renderer& renderer, const BundleId& bundleId, RenderingInfo& info) const
+{
+	return Draw(renderer, 0, slotList.size(), bundleId, info);
+}
+
+/**
+* w肵͈͂̃Xbg`悷.
+*
+* eNX`̈قȂXvCg1̃C[ɂ܂Ƃ߂ꍇAeNX`Ƃɔ͈͂𕪂ĕ`悷.
+*
+* @param renderer `Ɏgp郌_[.
+* @param first    `悷ŏ̃Xbg̔ԍ.
+* @param last     `悷Ō̃Xbg̔ԍ+1.
+* @param bundleId `ɎgpohID.
+* @param info     `.
+*
+* @retval true  R}hXg쐬.
+* @retval false R}hXg쐬s.
+*/
+bool RetainedLayer::Draw(Renderer& renderer, size_t first, size_t last, const BundleId& bundleId, RenderingInfo& info) const
+{
+	last = std::min(last, slotList.size());
+	if (first >= last) {
+		return true;
+	}
+	return renderer.Draw(vertexList.data() + first * 4, vertexList.data() + last * 4, bundleId, info);
+}
+
+/**
+* XvCgύX邽߂ɃXbgύXXgɒǉ.
+*
+* @param slot Xbg̔ԍ.
+*
+* @retval nullptrȊO ύXXvCg.
+* @retval nullptr     Xbg󂢂ĂA܂͔͈͊O.
+*/
+Sprite* RetainedLayer::Modify(size_t slot)
+{
+	if (slot >= slotList.size() || !slotList[slot].sprite) {
+		return nullptr;
+	}
+	MarkDirty(slot);
+	return slotList[slot].sprite;
+}
+
+/**
+* Xbg̒_f[^ʐ0̎lp`ɂ.
+*
+* @param slot Ώۂ̃Xbg̔ԍ.
+*/
+void RetainedLayer::ClearVertex(size_t slot)
+{
+	Vertex* v = &vertexList[slot * 4];
+	for (int i = 0; i < 4; ++i) {
+		v[i].position = XMFLOAT3(0, 0, 0);
+		v[i].color = XMFLOAT4(0, 0, 0, 0);
+		v[i].texcoord = XMFLOAT2(0, 0);
+	}
+}
+
+} // namespace Sprite
@@ -0,0 +1,76 @@
+/**
+* @file RetainedLayer.h
+*/
+#ifndef DX12TUTORIAL_SRC_RETAINEDLAYER_H_
+#define DX12TUTORIAL_SRC_RETAINEDLAYER_H_
+#include "Sprite.h"
+#include <DirectXMath.h>
+#include <vector>
+#include <limits>
+
+namespace Sprite {
+
+/**
+* XvCg̒_f[^ێ郌C[.
+*
+* wi^CgŜ悤ɁAقƂǕωȂXvCgo^Ďg.
+* o^XvCgɂ͒_f[^̒uꏊ(Xbg)蓖Ă.
+* XvCg̕ύXSetPosition()Ȃǂ̃C[̊֐ʂčs. ύXXbg͕ύXXgɒǉA
+* Update()͕ύXXg̃Xbg̒_f[^蒼.
+* ύXȂt[Update()́AXbg1ׂɏI.
+* `掞͕ێĂ钸_f[^`pobt@ɃRs[邾Ȃ̂ŁA
+* ωȂXvCgɂ͒_̌vZRXgȂ.
+*
+* o^XvCg̃oϐ𒼐ڏASprite::Update()ŃAj[Vi߂肵ĂA
+* C[͂̕ύXoȂ. ̏ꍇMarkDirty()ĂԂ.
+* Aj[VANVŖt[ωXvCǵAC[ɓo^ɒʏ̕@ŕ`悷邱.
+*
+* o^XvCgƃZXǵAo^܂ňړEjĂ͂ȂȂ.
+*/
+class RetainedLayer
+{
+public:
+	static const size_t npos = std::numeric_limits<size_t>::max();
+
+	RetainedLayer();
+	~RetainedLayer() = default;
+	RetainedLayer(const RetainedLayer&) = delete;
+	RetainedLayer& operator=(const RetainedLayer&) = delete;
+
+	void Init(const DirectX::XMFLOAT2& screenSize);
+	size_t Add(Sprite& sprite, const Cell* cellList);
+	void Remove(size_t slot);
+	void MarkDirty(size_t slot);
+	void SetPosition(size_t slot, const DirectX::XMFLOAT3& pos);
+	void SetRotation(size_t slot, float rotation);
+	void SetScale(size_t slot, const DirectX::XMFLOAT2& scale);
+	void SetColor(size_t slot, const DirectX::XMFLOAT4& color);
+	void SetCellIndex(size_t slot, uint32_t cellIndex);
+	const Sprite* Get(size_t slot) const;
+	size_t Update();
+	bool Draw(Renderer& renderer, const BundleId& bundleId, RenderingInfo& info) const;
+	bool Draw(Renderer& renderer, size_t first, size_t last, const BundleId& bundleId, RenderingInfo& info) const;
+	size_t Size() const { return slotList.size(); }
+	bool IsDirty() const { return !dirtySlotList.empty(); }
+
+private:
+	/// XvCg1̒_f[^̒uꏊ.
+	struct Slot {
+		Sprite* sprite;
+		const Cell* cellList;
+		bool dirty; ///< dirtySlotListɓo^ς݂Ȃtrue.
+	};
+
+	Sprite* Modify(size_t slot);
+	void ClearVertex(size_t slot);
+
+	DirectX::XMFLOAT2 offset; ///< XN[W.
+	std::vector<Slot> slotList;
+	std::vector<size_t> freeSlotList;
+	std::vector<size_t> dirtySlotList; ///< Update()Œ_f[^蒼Xbg̔ԍ.
+	std::vector<Vertex> vertexList;
+};
+
+} // namespace Sprite
+
+#endif // DX12TUTORIAL_SRC_RETAINEDLAYER_H_
@@ -5,6 +5,7 @@
 #include "../GamePad.h"
 #include "../Graphics.h"
 #include "../PSO.h"
+#include "../Atlas.h"
 #include <algorithm>
 
 using namespace DirectX;
@@ -117,18 +118,35 @@ bool MainGameScene::Load(::Scene::Context&)
     gameoverTime = 3;
   });
 
+  cellList[0] = *Sprite::LoadFromJsonFile(L"Res/Cell/Font.cell")->Get(0);
+  cellList[1] = *Sprite::LoadFromJsonFile(L"Res/Cell/CellEnemy.json")->Get(0);
+
   Graphics::Graphics& graphics = Graphics::Graphics::Get();
   Texture::ResourceLoader loader;
   loader.Begin(graphics.csuDescriptorHeap);
-  static const wchar_t* const textureNameList[] = {
-      L"Res/Objects.png",
-      L"Res/Font.png",
-      L"Res/UnknownPlanet.png",
-  };
-  for (int i = 0; i < countof_TexId; ++i) {
-    if (!loader.LoadFromFile(texture[i], i, textureNameList[i])) {
-      return false;
-    }
+  // IuWFNgƃtHg1̃eNX`ɂ܂Ƃ߂āAohŕ`ł悤ɂ.
+  Sprite::Image imageObjects, imageFont, imageAtlas;
+  if (!loader.LoadFromFile(imageObjects, L"Res/Objects.png")) {
+    return false;
+  }
+  // IuWFNg͓؂l߂`ŕ`悷.
+  // ʐς܂茸ȂŹA_̏Ȃ`̂܂ܕ`悳.
+  Sprite::BakeCellMeshList(imageObjects, cellList[1].list, cellList[1].meshList);
+  if (!loader.LoadFromFile(imageFont, L"Res/Font.png")) {
+    return false;
+  }
+  Sprite::AtlasBuilder atlasBuilder(2048, 2048);
+  atlasBuilder.Add(imageObjects, { &cellList[1] });
+  atlasBuilder.Add(imageFont, { &cellList[0] });
+  if (!atlasBuilder.Build(imageAtlas)) {
+    return false;
+  }
+  if (!loader.Create(texture[TexId_Objects], TexId_Objects, imageAtlas, L"Atlas(Objects, Font)")) {
+    return false;
+  }
+  texture[TexId_Font] = texture[TexId_Objects];
+  if (!loader.LoadFromFile(texture[TexId_BackGround], TexId_BackGround, L"Res/UnknownPlanet.png")) {
+    return false;
   }
   ID3D12CommandList* ppCommandLists[] = { loader.End() };
   graphics.commandQueue->ExecuteCommandLists(_countof(ppCommandLists), ppCommandLists);
@@ -136,12 +154,10 @@ bool MainGameScene::Load(::Scene::Context&)
 
   const PSO& pso = GetPSO(PSOType_Sprite);
   ID3D12DescriptorHeap* texDescHeap = graphics.csuDescriptorHeap.Get();
-  for (int i = 0; i < countof_TexId; ++i) {
-    bundleId[i] = graphics.spriteRenderer.CreateBundle(pso, texDescHeap, texture[i]);
-  }
+  bundleId[TexId_Objects] = graphics.spriteRenderer.CreateBundle(pso, texDescHeap, texture[TexId_Objects]);
+  bundleId[TexId_Font] = bundleId[TexId_Objects];
+  bundleId[TexId_BackGround] = graphics.spriteRenderer.CreateBundle(pso, texDescHeap, texture[TexId_BackGround]);
 
-  cellList[0] = *Sprite::LoadFromJsonFile(L"Res/Cell/Font.cell")->Get(0);
-  cellList[1] = *Sprite::LoadFromJsonFile(L"Res/Cell/CellEnemy.json")->Get(0);
   ptnList = Action::B::CreateDefaultPatternList();
   anmObjects = LoadAnimationFromJsonFile(L"Res/Anm/Animation.json");
   if (!producer.LoadScheduleFromJsonFile(L"Res/Level1.sch", ActionIdFromName(ptnList), EnemyIdFromName())) {
@@ -159,33 +175,17 @@ bool MainGameScene::Load(::Scene::Context&)
   const XMFLOAT2 center(graphics.viewport.Width * 0.5f, graphics.viewport.Height * 0.5f);
   spriteList.push_back(Sprite::Sprite(XMFLOAT3(center.x, center.y, 1.0f)));
   spriteList.back().animeController.SetCellIndex(0x81);
-  const char start[] = "00000000";
-  XMFLOAT3 pos(center.x - 64.0f, 32.0f, 0.0f);
-  XMVECTORF32 color = { 1, 1, 1, 1 };
-  const XMVECTORF32 colorFactor = { 0.95f, 0.95f, 0.95f, 1 };
-  for (const char c : start) {
-    if (c == '\0') {
-      break;
-    }
-    spriteList.push_back(Sprite::Sprite(pos));
-    spriteList.back().animeController.SetCellIndex(c);
-    color.v *= colorFactor;
-    XMStoreFloat4(&spriteList.back().color, color);
-    pos.x += 16;
-  }
+  const XMFLOAT2 screenSize(graphics.viewport.Width, graphics.viewport.Height);
+  textScore.Init(&cellList[0], screenSize);
+  textScore.SetSpacing(2);
+  textScore.SetPosition(XMFLOAT3(center.x - 64.0f, 32.0f, 0.0f));
+  textScore.SetColor(XMFLOAT4(0.95f, 0.95f, 0.95f, 1), XMFLOAT4(0.95f, 0.95f, 0.95f, 1));
+  textScore.SetNumber(score, 8);
 
-  {
-    const char fps[] = "FPS:00.0";
-    XMFLOAT3 pos(16.0f, 32.0f, 0.0f);
-    for (const char c : fps) {
-      if (c == '\0') {
-        break;
-      }
-      spriteListFps.push_back(Sprite::Sprite(pos));
-      spriteListFps.back().animeController.SetCellIndex(c);
-      pos.x += 16;
-    }
-  }
+  textFps.Init(&cellList[0], screenSize);
+  textFps.SetSpacing(2);
+  textFps.SetPosition(XMFLOAT3(16.0f, 32.0f, 0.0f));
+  textFps.SetText("FPS:00.0");
 
   static const XMFLOAT2 lt(-16, -16), rb(16, 16);
   pPlayer = world.AddEntity(GroupId_Player, anmObjects[0], XMFLOAT3(center.x, center.y* 1.75f, 0.5f), Collision::Shape::MakeRectangle(lt, rb));
@@ -226,6 +226,7 @@ int MainGameScene::Update(::Scene::Context&, double delta)
       static const XMFLOAT2 lt(-8, -16), rb(8, 16);
       SpatialGrid::Entity* p = world.AddEntity(GroupId_PlayerShot, anmObjects[0], { pPlayer->pos.x, pPlayer->pos.y, 0.5f }, Collision::Shape::MakeRectangle(lt, rb));
       p->actController.SetManualMove({ 0, -800 });
+      p->UseSweep(true);
       p->rotation = 3.14f;
       p->SetSeqIndex(AnmSeqId_PlayerShot);
       p->SetUpdateFunc([](SpatialGrid::Entity& entity) {
@@ -251,18 +252,15 @@ int MainGameScene::Update(::Scene::Context&, double delta)
     p->actControllerB.SetPattern(&ptnList[std::min<uint32_t>(action, ptnList.size())]);
   });
 #endif
-  uint32_t scoreTmp = score;
-  for (auto itr = spriteList.end() - 1; itr != spriteList.begin(); --itr) {
-    itr->animeController.SetCellIndex('0' + (scoreTmp % 10));
-    scoreTmp /= 10;
-  }
+  textScore.SetNumber(score, 8);
 
   {
-    uint32_t fps = static_cast<uint32_t>(Graphics::Graphics::Get().fps * 10);
-    auto itr = spriteListFps.end() - 1;
-    itr->animeController.SetCellIndex('0' + (fps % 10));
-    (itr - 2)->animeController.SetCellIndex('0' + ((fps / 10) % 10));
-    (itr - 3)->animeController.SetCellIndex('0' + ((fps / 100) % 10));
+    const uint32_t fps = static_cast<uint32_t>(Graphics::Graphics::Get().fps * 10);
+    char text[] = "FPS:00.0";
+    text[4] = static_cast<char>('0' + ((fps / 100) % 10));
+    text[5] = static_cast<char>('0' + ((fps / 10) % 10));
+    text[7] = static_cast<char>('0' + (fps % 10));
+    textFps.SetText(text);
   }
 
   terrain.Update(delta);
@@ -296,12 +294,21 @@ void MainGameScene::Draw(Graphics::Graphics& graphics) const
   spriteRenderingInfo.texDescHeap = graphics.csuDescriptorHeap.Get();
   spriteRenderingInfo.matViewProjection = graphics.matViewProjection;
 
-  const Sprite::Sprite* p = spriteList.data();
-  const size_t end = spriteList.size();
+//  const Sprite::Sprite* p = spriteList.data();
 //  graphics.spriteRenderer.Draw(p + 0, p + 1, cellList[0].list.data(), bundleId[TexId_BackGround], spriteRenderingInfo);
-  graphics.spriteRenderer.Draw(world.Begin(), world.End(), cellList[1].list.data(), bundleId[TexId_Objects], spriteRenderingInfo);
-  graphics.spriteRenderer.Draw(p + 1, p + end, cellList[0].list.data(), bundleId[TexId_Font], spriteRenderingInfo);
-  graphics.spriteRenderer.Draw(spriteListFps.begin(), spriteListFps.end(), cellList[0].list.data(), bundleId[TexId_Font], spriteRenderingInfo);
+  graphics.spriteRenderer.Draw(world.Begin(), world.End(), cellList[1], bundleId[TexId_Objects], spriteRenderingInfo);
+  textScore.Draw(graphics.spriteRenderer, bundleId[TexId_Font], spriteRenderingInfo);
+  textFps.Draw(graphics.spriteRenderer, bundleId[TexId_Font], spriteRenderingInfo);
+}
+
+/**
+* f̕`.
+*
+* XvCg͋L^ς݂̕`eĕ`悳̂ŁAn``悷.
+*/
+void MainGameScene::DrawForPause(Graphics::Graphics& graphics) const
+{
+  terrain.Draw(graphics.commandList.Get(), 0);
 }
 
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "../Scene.h"
 #include "../Texture.h"
 #include "../Sprite.h"
+#include "../Text.h"
 #include "../Animation.h"
 #include "../Action.h"
 #include "../Audio.h"
@@ -30,6 +31,7 @@ public:
 	virtual bool Load(::Scene::Context&) override;
 	virtual int Update(::Scene::Context&, double delta) override;
 	virtual void Draw(Graphics::Graphics& graphics) const override;
+	virtual void DrawForPause(Graphics::Graphics& graphics) const override;
 
 private:
 	MainGameScene();
@@ -59,7 +61,8 @@ private:
 	AnimationFile anmObjects;
 	Action::B::PatternList ptnList;
 	std::vector<Sprite::Sprite> spriteList;
-    std::vector<Sprite::Sprite> spriteListFps;
+	Sprite::GlyphRun textScore;
+	Sprite::GlyphRun textFps;
 
 	double time = 0;
 	double clearTime = 0;
@@ -72,6 +72,11 @@ bool TitleScene::Load(::Scene::Context&)
 		XMStoreFloat4(&spriteList.back().color, color);
 		pos.x += 16;
 	}
+	layer.Init(XMFLOAT2(graphics.viewport.Width, graphics.viewport.Height));
+	for (Sprite::Sprite& sprite : spriteList) {
+		layer.Add(sprite, cellList.list.data());
+	}
+	layer.Update();
 
 	seStart = Audio::Engine::Get().Prepare(L"Res/SE/Start.wav");
 
@@ -90,18 +95,18 @@ int TitleScene::Update(::Scene::Context&, double delta)
 {
 	time += delta;
 
-	for (Sprite::Sprite& sprite : spriteList) {
-		sprite.Update(delta);
-	}
-
 	if (startTimer > 0) {
 		startTimer -= delta;
 		if (startTimer <= 0) {
 			return ExitCode_MainGame;
 		}
 		const float blink = (std::fmod(startTimer, 0.25) > 0.125) ? 0.0f : 1.0f;
-		for (auto itr = spriteList.begin() + 2; itr != spriteList.end(); ++itr) {
-			itr->color.w = blink;
+		for (size_t i = 2; i < layer.Size(); ++i) {
+			XMFLOAT4 color = layer.Get(i)->color;
+			if (color.w != blink) {
+				color.w = blink;
+				layer.SetColor(i, color);
+			}
 		}
 	} else {
 		const GamePad gamepad = GetGamePad(GamePadId_1P);
@@ -110,6 +115,7 @@ int TitleScene::Update(::Scene::Context&, double delta)
 			seStart->Play();
 		}
 	}
+	layer.Update();
 	return ExitCode_Continue;
 }
 
@@ -126,10 +132,8 @@ void TitleScene::Draw(Graphics::Graphics& graphics) const
 	spriteRenderingInfo.texDescHeap = graphics.csuDescriptorHeap.Get();
 	spriteRenderingInfo.matViewProjection = graphics.matViewProjection;
 
-	const Sprite::Sprite* p = spriteList.data();
-	const size_t end = spriteList.size();
-	graphics.spriteRenderer.Draw(p + 0, p + 1, cellList.list.data(), bundleId[0], spriteRenderingInfo);
-	graphics.spriteRenderer.Draw(p + 1, p + end, cellList.list.data(), bundleId[1], spriteRenderingInfo);
+	layer.Draw(graphics.spriteRenderer, 0, 1, bundleId[0], spriteRenderingInfo);
+	layer.Draw(graphics.spriteRenderer, 1, layer.Size(), bundleId[1], spriteRenderingInfo);
 }
 
 }
\ No newline at end of file
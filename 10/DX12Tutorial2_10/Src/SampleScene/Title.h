@@ -6,6 +6,7 @@
 #include "../Scene.h"
 #include "../Texture.h"
 #include "../Sprite.h"
+#include "../RetainedLayer.h"
 #include "../Audio.h"
 
 namespace SampleScene {
@@ -33,6 +34,7 @@ private:
 	Sprite::BundleId bundleId[2];
 	Audio::SoundPtr seStart;
 	std::vector<Sprite::Sprite> spriteList;
+	Sprite::RetainedLayer layer;
 	Sprite::CellList cellList;
 	double time;
 	double startTimer;
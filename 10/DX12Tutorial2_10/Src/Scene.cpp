@@ -102,12 +102,14 @@ void TransitionController::Update(Context& context, double delta)
 		case TransitionType::Push:
 			if (const Creator* creator = FindCreator(itr->trans.nextScene)) {
 				sceneStack.back().p->Pause(context);
+				sceneStack.back().frozenDrawList.Reset();
 				LoadScene(context, creator);
 			}
 			break;
 		case TransitionType::Pop:
 			UnloadScene(context);
 			sceneStack.back().p->Resume(context);
+			sceneStack.back().frozenDrawList.Reset();
 			break;
 		}
 	}
@@ -117,13 +119,40 @@ void TransitionController::Update(Context& context, double delta)
 /**
 * V[`悷.
 *
+* f̃V[́Afɍŏɕ`悵Ƃ̃XvCg̕`eL^ĂA
+* Ȍ͍ĊJ܂ŋL^eĕ`悷.
+* XvCgȊO̕`Scene::DrawForPause()ōs.
+* f\ωV[́AScene::IsDrawFrozenOnPause()falseԂ.
+*
 * @param graphics `.
 */
 void TransitionController::Draw(Graphics::Graphics& graphics) const
 {
-	for (const auto& scene : sceneStack) {
-		if (scene.p->GetState() == Scene::StatusCode::Runnable) {
-			scene.p->Draw(graphics);
+	if (sceneStack.empty()) {
+		return;
+	}
+	const auto itrActiveScene = sceneStack.end() - 1;
+	for (auto itr = sceneStack.begin(); itr != sceneStack.end(); ++itr) {
+		const Scene& scene = *itr->p;
+		if (scene.GetState() != Scene::StatusCode::Runnable) {
+			continue;
+		}
+		if (itr == itrActiveScene || !scene.IsDrawFrozenOnPause()) {
+			scene.Draw(graphics);
+		} else if (itr->frozenDrawList.Empty()) {
+			graphics.spriteRenderer.BeginCapture(&itr->frozenDrawList);
+			scene.Draw(graphics);
+			graphics.spriteRenderer.EndCapture();
+		} else {
+			scene.DrawForPause(graphics);
+			Sprite::RenderingInfo spriteRenderingInfo;
+			spriteRenderingInfo.rtvHandle = graphics.GetRTVHandle();
+			spriteRenderingInfo.dsvHandle = graphics.GetDSVHandle();
+			spriteRenderingInfo.viewport = graphics.viewport;
+			spriteRenderingInfo.scissorRect = graphics.scissorRect;
+			spriteRenderingInfo.texDescHeap = graphics.csuDescriptorHeap.Get();
+			spriteRenderingInfo.matViewProjection = graphics.matViewProjection;
+			graphics.spriteRenderer.Submit(itr->frozenDrawList, spriteRenderingInfo);
 		}
 	}
 }
@@ -3,6 +3,7 @@
 */
 #ifndef DX12TUTORIAL_SRC_SCENE_H_
 #define DX12TUTORIAL_SRC_SCENE_H_
+#include "CommandStream.h"
 #include <memory>
 #include <vector>
 #include <string>
@@ -58,6 +59,8 @@ private:
 	virtual bool Load(Context&) { return true; }
 	virtual bool Unload(Context&) { return true; }
 	virtual void UpdateForPause(Context&, double) {}
+	virtual void DrawForPause(Graphics::Graphics&) const {}
+	virtual bool IsDrawFrozenOnPause() const { return true; }
 	virtual void Pause(Context&) {}
 	virtual void Resume(Context&) {}
 
@@ -123,6 +126,7 @@ private:
 	struct SceneInfo {
 		int id;
 		ScenePtr p;
+		mutable Sprite::CommandStream frozenDrawList; ///< fɍĕ`悷XvCg̕`e.
 	};
 
 	std::vector<Creator> creatorMap;
@@ -6,8 +6,10 @@
 #include "../PSO.h"
 #include "../GamePad.h"
 #include "../Collision.h"
+#include "../Palette.h"
 #include <DirectXMath.h>
 #include <algorithm>
+#include <functional>
 
 using namespace DirectX;
 
@@ -38,14 +40,14 @@ struct MainGameScene::Occurrence {
 
 namespace /* unnamed */ {
 
-/**
-* XvCgpZf[^.
-*/
-const Sprite::Cell cellList[] = {
-	{ XMFLOAT2(0.0f, 0.0f), XMFLOAT2(1.0f, 1.0f), XMFLOAT2(800, 600) },
-
-	{ XMFLOAT2(16.0f / 1024.0f, 48.0f / 512.0f), XMFLOAT2(480.0f / 1024.0f, 256.0f / 512.0f), XMFLOAT2(480, 256) },
-};
+// wĩ^C}bv.
+// 800x600̔wi摜50x50̃^CɕAcɁuʏA㉺]Aʏv̏ɕׂ.
+// ]摜ނƂŌpڂڗȂȂA2XN[ƍŏƓ\ɖ߂.
+const float bgTilePixel = 50.0f; ///< ^C1̑傫(sNZ).
+const uint32_t bgTileCountX = 16; ///< wi摜̉̃^C.
+const uint32_t bgTileCountY = 12; ///< wi摜̏c̃^C.
+const float bgLoopPixel = bgTilePixel * bgTileCountY * 2; ///< \ꏄ܂ł̃XN[(sNZ).
+const float bgScrollSpeed = 20.0f; ///< XN[x(sNZ/b).
 
 const MainGameScene::FormationData formationA[] = {
 	{ EnemyType_Winp, 2, 0.25f * 0, { 0, 0 } },
@@ -231,6 +233,54 @@ void DetectCollision(Iterator first0, Iterator last0, Iterator first1, Iterator
 }
 
 
+/**
+* ړ̏Փ˂lՓ˔.
+*
+* ӂ̃XvCǵAO̍XVňړO̍W猻݂̍W܂ŒIɈړ̂ƂĈA
+* ̊ԂɏՓ˂邩𑊑ΓIȈړŔ肷.
+* Փ˂͐ڐG̑ɉ邽߁AeO̓Gɉ̓Gɓ邱Ƃ͂Ȃ.
+*
+* t[[gቺ1̈ړʂ傫ȂĂAȒeG蔲Ȃ悤ɂ邽߂Ɏg.
+*
+* @param prevPos0 ӑ̃XvCg̈ړO̍W̔z. first0珇ɑΉ.
+* @param prevPos1 Eӑ̃XvCg̈ړO̍W̔z. first1珇ɑΉ.
+*/
+template<typename Iterator>
+void DetectSweptCollision(Iterator first0, Iterator last0, const XMFLOAT2* prevPos0,
+	Iterator first1, Iterator last1, const XMFLOAT2* prevPos1, CollisionSolver solver)
+{
+	std::vector<std::pair<float, Iterator>> hitList;
+	for (Iterator itr0 = first0; itr0 != last0; ++itr0, ++prevPos0) {
+		if (itr0->GetCollisionId() < 0) {
+			continue;
+		}
+		const Collision::Shape& shapeL = colShapes[itr0->GetCollisionId()];
+		const XMFLOAT2 posL(itr0->pos.x, itr0->pos.y);
+		const XMFLOAT2& prevPosL = *prevPos0;
+		hitList.clear();
+		const XMFLOAT2* prevPosR = prevPos1;
+		for (Iterator itr1 = first1; itr1 != last1; ++itr1, ++prevPosR) {
+			if (itr1->GetCollisionId() < 0) {
+				continue;
+			}
+			const Collision::Shape& shapeR = colShapes[itr1->GetCollisionId()];
+			const XMFLOAT2 posR(itr1->pos.x, itr1->pos.y);
+			float toi;
+			if (Collision::SweepCollision(shapeL, prevPosL, posL, shapeR, *prevPosR, posR, toi)) {
+				hitList.push_back(std::make_pair(toi, itr1));
+			}
+		}
+		std::stable_sort(hitList.begin(), hitList.end(),
+			[](const std::pair<float, Iterator>& lhs, const std::pair<float, Iterator>& rhs) { return lhs.first < rhs.first; });
+		for (auto& e : hitList) {
+			if (solver(*itr0, *e.second) == CollisionResult::FilterOut) {
+				break;
+			}
+		}
+	}
+}
+
+
 // prʃXvCg.
 const size_t playerCount = 1;
 const size_t playerShotCount = 3 * 2 * 3;
@@ -287,6 +337,14 @@ enum Enemy00ActId
 	Enemy00ActId_Destroyed,
 };
 
+// Gp̃pbgԍ.
+enum EnemyPaletteId
+{
+	EnemyPaletteId_Normal,
+	EnemyPaletteId_Damaged, ///< e̓_ŗp. sȐFSĔɂ.
+	EnemyPaletteId_Count,
+};
+
 } // unnamed namespace
 
 /**
@@ -318,6 +376,26 @@ bool MainGameScene::Load(::Scene::Context& context)
 	if (!graphics.texMap.LoadFromFile(texObjects, L"Res/Objects.png")) {
 		return false;
 	}
+	{
+		Sprite::IndexedImage image;
+		Sprite::Palette palette;
+		if (!graphics.texMap.LoadFromFile(image, palette, L"Res/Objects.png")) {
+			return false;
+		}
+		std::vector<Sprite::Palette> paletteList(EnemyPaletteId_Count, palette);
+		for (uint32_t& c : paletteList[EnemyPaletteId_Damaged]) {
+			if (c & 0xff000000) {
+				c |= 0x00ffffff;
+			}
+		}
+		Sprite::Image palettePage;
+		if (!Sprite::PackPalette(paletteList, palettePage)) {
+			return false;
+		}
+		if (!graphics.texMap.Create(texEnemy, texEnemyPalette, L"Res/Objects.png#Indexed", image, palettePage)) {
+			return false;
+		}
+	}
 	if (!graphics.texMap.LoadFromFile(texFont, L"Res/TextFont.png")) {
 		return false;
 	}
@@ -340,8 +418,32 @@ bool MainGameScene::Load(::Scene::Context& context)
 	pEndOccurrence = occurrenceList + _countof(occurrenceList);
 	clearTime = (pEndOccurrence - 1)->time;
 
-	sprBackground.push_back(Sprite::Sprite(anmOthers[0], XMFLOAT3(400, 300, 1.0f)));
-	sprBackground[0].SetSeqIndex(0);
+	// ŹAOɒʏ̃^CA㔼ɏ㉺]^Cׂ.
+	bgTileset.list.resize(bgTileCountX * bgTileCountY * 2);
+	for (uint32_t y = 0; y < bgTileCountY; ++y) {
+		for (uint32_t x = 0; x < bgTileCountX; ++x) {
+			const XMFLOAT2 uv(static_cast<float>(x) / bgTileCountX, static_cast<float>(y) / bgTileCountY);
+			const XMFLOAT2 tsize(1.0f / bgTileCountX, 1.0f / bgTileCountY);
+			const uint32_t i = y * bgTileCountX + x;
+			bgTileset.list[i] = { uv, tsize, XMFLOAT2(bgTilePixel, bgTilePixel) };
+			bgTileset.list[i + bgTileCountX * bgTileCountY] = { XMFLOAT2(uv.x, uv.y + tsize.y), XMFLOAT2(tsize.x, -tsize.y), XMFLOAT2(bgTilePixel, bgTilePixel) };
+		}
+	}
+	std::vector<uint32_t> bgTiles(bgTileCountX * bgTileCountY * 3);
+	for (uint32_t y = 0; y < bgTileCountY; ++y) {
+		for (uint32_t x = 0; x < bgTileCountX; ++x) {
+			const uint32_t normal = y * bgTileCountX + x;
+			const uint32_t flipped = (bgTileCountY - 1 - y) * bgTileCountX + x + bgTileCountX * bgTileCountY;
+			bgTiles[normal] = normal;
+			bgTiles[normal + bgTileCountX * bgTileCountY] = flipped;
+			bgTiles[normal + bgTileCountX * bgTileCountY * 2] = normal;
+		}
+	}
+	bgTileMap.Init(&bgTileset, XMFLOAT2(bgTilePixel, bgTilePixel), XMFLOAT2(800, 600), 4);
+	bgTileMap.Load(bgTileCountX, bgTileCountY * 3, bgTiles);
+	bgTileMap.SetDepth(1.0f);
+	bgTileMap.SetScroll(XMFLOAT2(0, bgLoopPixel));
+	bgTileMap.Update();
 
 	sprPlayer.reserve(playerSpriteCount);
 	sprPlayer.push_back(Sprite::Sprite(anmObjects[1], XMFLOAT3(400, 550, 0.4f)));
@@ -351,6 +453,8 @@ bool MainGameScene::Load(::Scene::Context& context)
 	for (int i = 0; i < playerShotCount; ++i) {
 		freePlayerShotList.push_back(&sprPlayer[PID_PlayerShot + i]);
 	}
+	prevPlayerPos.resize(playerSpriteCount);
+	prevEnemyPos.resize(enemyCount);
 
 	sprEnemy.resize(enemySpriteCount, Sprite::Sprite(anmObjects[0], XMFLOAT3(0, -100, 0.5f)));
 	for (int i = 0; i < enemyCount; ++i) {
@@ -361,6 +465,21 @@ bool MainGameScene::Load(::Scene::Context& context)
 		sprEnemy[EID_EnemyShot + i].SetCollisionId(CSID_None);
 		freeEnemyShotList.push_back(&sprEnemy[EID_EnemyShot + i]);
 	}
+	// Gëړ͂܂Ƃ߂čs. XbgԍGe̕яƈv悤ɁA擪珇ɓo^.
+	enemyShotBatch.Reserve(enemyShotCount);
+	for (int i = 0; i < enemyShotCount; ++i) {
+		enemyShotBatch.Add(nullptr, 0, &sprEnemy[EID_EnemyShot + i]);
+	}
+
+	// vC[ƓG̃Aj[V͂܂Ƃ߂čXV. XbgsprPlayerAsprEnemy̏Ɋ蓖Ă.
+	// o^ɔz̑傫ςƃRg[[̃Rs[ēo^ÔŁA傫m肳Ăo^邱.
+	animationSystem.Reserve(sprPlayer.size() + sprEnemy.size());
+	for (size_t i = 0; i < sprPlayer.size(); ++i) {
+		animationSystem.Attach(static_cast<uint32_t>(i), sprPlayer[i].animeController);
+	}
+	for (size_t i = 0; i < sprEnemy.size(); ++i) {
+		animationSystem.Attach(static_cast<uint32_t>(sprPlayer.size() + i), sprEnemy[i].animeController);
+	}
 
 	sprFont.reserve(256);
 	static const char text[] = "00000000";
@@ -390,6 +509,7 @@ bool MainGameScene::Load(::Scene::Context& context)
 	bundleId[0] = graphics.spriteRenderer.CreateBundle(pso, texDescHeap, texBackground);
 	bundleId[1] = graphics.spriteRenderer.CreateBundle(pso, texDescHeap, texObjects);
 	bundleId[2] = graphics.spriteRenderer.CreateBundle(pso, texDescHeap, texFont);
+	bundleId[3] = graphics.spriteRenderer.CreateBundle(GetPSO(PSOType_PaletteSprite), texDescHeap, texEnemy);
 
 	return true;
 }
@@ -450,8 +570,10 @@ void MainGameScene::UpdatePlayer(double delta)
 		}
 	}
 
-	for (Sprite::Sprite& sprite : sprPlayer) {
-		sprite.Update(delta);
+	// ړ̏Փ˔̂߁Ãt[Ŕ˂e܂߂ĈړO̍WL^Ă.
+	for (size_t i = 0; i < sprPlayer.size(); ++i) {
+		prevPlayerPos[i] = XMFLOAT2(sprPlayer[i].pos.x, sprPlayer[i].pos.y);
+		sprPlayer[i].Update(delta);
 	}
 	for (size_t i = PID_PlayerShot; i < PID_PlayerShot + playerShotCount; ++i) {
 		if (sprPlayer[i].GetCollisionId() < 0) {
@@ -466,6 +588,70 @@ void MainGameScene::UpdatePlayer(double delta)
 	}
 }
 
+/**
+* Ge˃NX.
+*
+* Ge̍WƑxAction::BatchǗ̂ŁAXvCg̃Rg[[ł͂Ȃ̃NXʂĐݒ肷.
+* Batch̃Xbg͓GeXvCg̕яɊ蓖ĂĂ̂ŁA擪̓GeXvCgƂ̍XbgԍɂȂ.
+*/
+class EnemyShotLauncher
+{
+public:
+	EnemyShotLauncher(std::vector<Sprite::Sprite*>& fl, Action::Batch& b) : freeList(&fl), batch(&b) {}
+
+	/**
+	* Ge𔭎˂.
+	*
+	* @param pos  ˈʒu.
+	* @param move ړx.
+	*
+	* @return ˂Ge. 󂫂Ȃnullptr.
+	*/
+	Sprite::Sprite* Launch(const XMFLOAT3& pos, const XMFLOAT2& move)
+	{
+		Sprite::Sprite* pSprite = Pop(pos);
+		if (pSprite) {
+			batch->SetManualMove(GetSlot(pSprite), move);
+		}
+		return pSprite;
+	}
+
+	/**
+	* Ge𔭎˂.
+	*
+	* @param pos    ˈʒu.
+	* @param degree ړ(0-360).
+	* @param speed  ړx(pixels/s).
+	*
+	* @return ˂Ge. 󂫂Ȃnullptr.
+	*/
+	Sprite::Sprite* Launch(const XMFLOAT3& pos, float degree, float speed)
+	{
+		Sprite::Sprite* pSprite = Pop(pos);
+		if (pSprite) {
+			batch->SetManualMove(GetSlot(pSprite), degree, speed);
+		}
+		return pSprite;
+	}
+
+private:
+	Sprite::Sprite* Pop(const XMFLOAT3& pos)
+	{
+		if (freeList->empty()) {
+			return nullptr;
+		}
+		Sprite::Sprite* pSprite = freeList->back();
+		freeList->pop_back();
+		pSprite->pos.z = pos.z;
+		batch->SetPosition(GetSlot(pSprite), XMFLOAT2(pos.x, pos.y));
+		return pSprite;
+	}
+	uint32_t GetSlot(const Sprite::Sprite* p) const { return static_cast<uint32_t>(p - batch->GetSprite(0)); }
+
+	std::vector<Sprite::Sprite*>* freeList;
+	Action::Batch* batch;
+};
+
 /**
 * Ge.
 */
@@ -473,8 +659,8 @@ class EnemyShotGenerator
 {
 public:
 	EnemyShotGenerator() = default;
-	EnemyShotGenerator(const Sprite::Sprite& p, std::vector<Sprite::Sprite*>& fl, uint32_t n = 1, float i = 2.0f) :
-		player(p), freeList(fl), stock(n), timer(0), interval(i), speed(-1)
+	EnemyShotGenerator(const Sprite::Sprite& p, const EnemyShotLauncher& l, uint32_t n = 1, float i = 2.0f) :
+		player(p), launcher(l), stock(n), timer(0), interval(i), speed(-1)
 	{}
 	void operator()(float delta, Sprite::Sprite* spr, float s, float r) {
 		if (speed < 0) {
@@ -488,29 +674,26 @@ public:
 			return;
 		}
 		timer = 0.0f;
-		if (freeList.empty()) {
-			return;
-		}
-		--stock;
-		timer = interval;
 
-		Sprite::Sprite* pSprite = freeList.back();
-		freeList.pop_back();
-		pSprite->pos = spr->pos;
 		XMVECTORF32 vec, angle;
 		vec.v = XMVector2Normalize(XMVectorSubtract(XMLoadFloat3(&player.pos), XMLoadFloat3(&spr->pos)));
 		angle.v = XMVectorACos(XMVectorSwizzle<1, 1, 1, 1>(vec));
+		const XMVECTOR move = XMVectorMultiply(vec, XMVectorSwizzle<0, 0, 0, 0>(XMLoadFloat(&speed)));
+		XMFLOAT2 fmove;
+		XMStoreFloat2(&fmove, move);
+		Sprite::Sprite* pSprite = launcher.Launch(spr->pos, fmove);
+		if (!pSprite) {
+			return;
+		}
+		--stock;
+		timer = interval;
 		pSprite->rotation = vec.f[0] < 0.0f ? angle.f[0] : -angle.f[0];
-		vec.v = XMVectorMultiply(vec, XMVectorSwizzle<0, 0, 0, 0>(XMLoadFloat(&speed)));
-		XMFLOAT2 move;
-		XMStoreFloat2(&move, vec);
-		pSprite->actController.SetManualMove(move);
 		pSprite->SetSeqIndex(EnemyAnmId_Shot00);
 		pSprite->SetCollisionId(CSID_EnemyShot_Normal);
 	}
 private:
 	const Sprite::Sprite& player;
-	std::vector<Sprite::Sprite*>& freeList;
+	EnemyShotLauncher launcher;
 	uint32_t stock;
 	float timer;
 	float interval;
@@ -524,7 +707,7 @@ class Enemy3WayShotGenerator
 {
 public:
 	Enemy3WayShotGenerator() = default;
-	explicit Enemy3WayShotGenerator(std::vector<Sprite::Sprite*>& fl) : freeList(fl), isActed(false) {}
+	explicit Enemy3WayShotGenerator(const EnemyShotLauncher& l) : launcher(l), isActed(false) {}
 	void operator()(float delta, Sprite::Sprite* spr, float s, float r) {
 		if (isActed) {
 			return;
@@ -538,21 +721,20 @@ public:
 			{ 270 + 15, { 8, 32 } },
 		};
 		for (auto itr = std::begin(info); itr != std::end(info); ++itr) {
-			if (freeList.empty()) {
+			XMFLOAT3 pos;
+			XMStoreFloat3(&pos, XMVectorAdd(XMLoadFloat3(&spr->pos), itr->pos));
+			Sprite::Sprite* pSprite = launcher.Launch(pos, itr->dir, s);
+			if (!pSprite) {
 				break;
 			}
-			Sprite::Sprite* pSprite = freeList.back();
-			freeList.pop_back();
-			XMStoreFloat3(&pSprite->pos, XMVectorAdd(XMLoadFloat3(&spr->pos), itr->pos));
 			pSprite->rotation = (270 - itr->dir) * 3.1415926f / 180.0f;
-			pSprite->actController.SetManualMove(itr->dir, s);
 			pSprite->SetSeqIndex(EnemyAnmId_Shot00);
 			pSprite->SetCollisionId(CSID_EnemyShot_Normal);
 		}
 		isActed = true;
 	}
 private:
-	std::vector<Sprite::Sprite*>& freeList;
+	EnemyShotLauncher launcher;
 	bool isActed;
 };
 
@@ -563,8 +745,8 @@ class EnemyBoss1stShotGenerator
 {
 public:
 	EnemyBoss1stShotGenerator() = default;
-	EnemyBoss1stShotGenerator(const Sprite::Sprite& p, std::vector<Sprite::Sprite*>& fl, uint32_t n = 1, float i = 2.0f) :
-		player(p), freeList(fl), interval(i), speed(-1)
+	EnemyBoss1stShotGenerator(const Sprite::Sprite& p, const EnemyShotLauncher& l, uint32_t n = 1, float i = 2.0f) :
+		player(p), launcher(l), interval(i), speed(-1)
 	{}
 	void operator()(float delta, Sprite::Sprite* spr, float s, float r) {
 		if (speed < 0) {
@@ -596,14 +778,13 @@ public:
 			{ -24, 88 }, { 24, 88 }
 		};
 		for (int i = 0; i < 2; ++i) {
-			if (freeList.empty()) {
+			XMFLOAT3 shotPos;
+			XMStoreFloat3(&shotPos, XMVectorAdd(XMLoadFloat3(&spr->pos), pos[i]));
+			Sprite::Sprite* pSprite = launcher.Launch(shotPos, 270, 600);
+			if (!pSprite) {
 				return;
 			}
-			Sprite::Sprite* pSprite = freeList.back();
-			freeList.pop_back();
-			XMStoreFloat3(&pSprite->pos, XMVectorAdd(XMLoadFloat3(&spr->pos), pos[i]));
 			pSprite->rotation = 0;
-			pSprite->actController.SetManualMove(270, 600);
 			pSprite->SetSeqIndex(EnemyAnmId_Shot01);
 			pSprite->SetCollisionId(CSID_EnemyShot_Normal);
 		}
@@ -627,17 +808,13 @@ public:
 			{ -88, -24 },{ 88, -24 }
 		};
 		for (int i = 0; i < 2; ++i) {
-			if (freeList.empty()) {
+			XMFLOAT3 shotPos;
+			XMStoreFloat3(&shotPos, XMVectorAdd(XMLoadFloat3(&spr->pos), pos[i]));
+			const float degree = (i == 0 ? (128 - stock[1] - 4) : (stock[1] - 4)) * 360.0f / 16.0f;
+			Sprite::Sprite* pSprite = launcher.Launch(shotPos, degree, 200);
+			if (!pSprite) {
 				return;
 			}
-			Sprite::Sprite* pSprite = freeList.back();
-			freeList.pop_back();
-			XMStoreFloat3(&pSprite->pos, XMVectorAdd(XMLoadFloat3(&spr->pos), pos[i]));
-			if (i == 0) {
-				pSprite->actController.SetManualMove((128 - stock[1] - 4) * 360.0f / 16.0f, 200);
-			} else {
-				pSprite->actController.SetManualMove((stock[1] - 4) * 360.0f / 16.0f, 200);
-			}
 			pSprite->rotation = 0;
 			pSprite->SetSeqIndex(EnemyAnmId_Shot02);
 			pSprite->SetCollisionId(CSID_EnemyShot_Normal);
@@ -664,21 +841,20 @@ public:
 			{ { 136, 56 },{ 160, 64 },{ 184, 72 } },
 		};
 		for (int i = 0; i < 2; ++i) {
-			if (freeList.empty()) {
-				return;
-			}
-			Sprite::Sprite* pSprite = freeList.back();
-			freeList.pop_back();
-			XMStoreFloat3(&pSprite->pos, XMVectorAdd(XMLoadFloat3(&spr->pos), pos[i][(stock[2] % 3)]));
+			XMFLOAT3 shotPos;
+			XMStoreFloat3(&shotPos, XMVectorAdd(XMLoadFloat3(&spr->pos), pos[i][(stock[2] % 3)]));
 
 			XMVECTORF32 vec, angle;
-			vec.v = XMVector2Normalize(XMVectorSubtract(XMLoadFloat3(&player.pos), XMLoadFloat3(&pSprite->pos)));
+			vec.v = XMVector2Normalize(XMVectorSubtract(XMLoadFloat3(&player.pos), XMLoadFloat3(&shotPos)));
 			angle.v = XMVectorACos(XMVectorSwizzle<1, 1, 1, 1>(vec));
+			const XMVECTOR move = XMVectorMultiply(vec, XMVectorSwizzle<0, 0, 0, 0>(XMLoadFloat(&speed)));
+			XMFLOAT2 fmove;
+			XMStoreFloat2(&fmove, move);
+			Sprite::Sprite* pSprite = launcher.Launch(shotPos, fmove);
+			if (!pSprite) {
+				return;
+			}
 			pSprite->rotation = vec.f[0] < 0.0f ? angle.f[0] : -angle.f[0];
-			vec.v = XMVectorMultiply(vec, XMVectorSwizzle<0, 0, 0, 0>(XMLoadFloat(&speed)));
-			XMFLOAT2 move;
-			XMStoreFloat2(&move, vec);
-			pSprite->actController.SetManualMove(move);
 			pSprite->SetSeqIndex(EnemyAnmId_Shot00);
 			pSprite->SetCollisionId(CSID_EnemyShot_Normal);
 		}
@@ -692,7 +868,7 @@ public:
 
 private:
 	const Sprite::Sprite& player;
-	std::vector<Sprite::Sprite*>& freeList;
+	EnemyShotLauncher launcher;
 	int32_t stock[3];
 	float timer[3];
 	float interval;
@@ -704,16 +880,16 @@ private:
 */
 void MainGameScene::GenerateEnemy(double delta)
 {
-	struct local {
-		static Sprite::Sprite* GetSprite(std::vector<Sprite::Sprite*>& freeList, const MainGameScene::Formation& data) {
-			if (freeList.empty()) {
-				return nullptr;
-			}
-			Sprite::Sprite* p = freeList.back();
-			freeList.pop_back();
-			XMStoreFloat3(&p->pos, XMVectorAdd(XMLoadFloat3(&data.pos), XMLoadFloat2(&data.cur->offset)));
-			return p;
+	// ot[ł͈ړĂȂ̂ŁAړO̍WoʒuɂĂ.
+	const auto getSprite = [this](const Formation& data) -> Sprite::Sprite* {
+		if (freeEnemyList.empty()) {
+			return nullptr;
 		}
+		Sprite::Sprite* p = freeEnemyList.back();
+		freeEnemyList.pop_back();
+		XMStoreFloat3(&p->pos, XMVectorAdd(XMLoadFloat3(&data.pos), XMLoadFloat2(&data.cur->offset)));
+		prevEnemyPos[p - &sprEnemy[EID_Enemy]] = XMFLOAT2(p->pos.x, p->pos.y);
+		return p;
 	};
 	while (pCurOccurrence != pEndOccurrence) {
 		if (pCurOccurrence->time > time) {
@@ -729,38 +905,42 @@ void MainGameScene::GenerateEnemy(double delta)
 			}
 			switch (itr->cur->type) {
 			case EnemyType_Winp:
-				if (Sprite::Sprite* pSprite = local::GetSprite(freeEnemyList, *itr)) {
+				if (Sprite::Sprite* pSprite = getSprite(*itr)) {
 					pSprite->SetSeqIndex(EnemyAnmId_SmallFighter);
 					pSprite->SetActionList(actionFile->Get(EnemyActListId_Winp));
-					pSprite->actController.SetGenerator(EnemyShotGenerator(sprPlayer[0], freeEnemyShotList));
+					pSprite->actController.SetGenerator(EnemyShotGenerator(sprPlayer[0], EnemyShotLauncher(freeEnemyShotList, enemyShotBatch)));
+					pSprite->actController.UseTrack(true);
 					pSprite->SetAction(itr->cur->actionId);
 					pSprite->SetCollisionId(CSID_Enemy00);
 					pSprite->hp = 1;
 				}
 				break;
 			case EnemyType_3Way:
-				if (Sprite::Sprite* pSprite = local::GetSprite(freeEnemyList, *itr)) {
+				if (Sprite::Sprite* pSprite = getSprite(*itr)) {
 					pSprite->SetActionList(actionFile->Get(EnemyActListId_3Way));
+					pSprite->actController.UseTrack(true);
 					pSprite->SetAction(itr->cur->actionId);
-					pSprite->actController.SetGenerator(Enemy3WayShotGenerator(freeEnemyShotList));
+					pSprite->actController.SetGenerator(Enemy3WayShotGenerator(EnemyShotLauncher(freeEnemyShotList, enemyShotBatch)));
 					pSprite->SetCollisionId(CSID_Enemy3Way);
 					pSprite->hp = 3;
 				}
 				break;
 			case EnemyType_Middle:
-				if (Sprite::Sprite* pSprite = local::GetSprite(freeEnemyList, *itr)) {
+				if (Sprite::Sprite* pSprite = getSprite(*itr)) {
 					pSprite->SetActionList(actionFile->Get(EnemyActListId_Middle));
+					pSprite->actController.UseTrack(true);
 					pSprite->SetAction(itr->cur->actionId);
-					pSprite->actController.SetGenerator(EnemyShotGenerator(sprPlayer[0], freeEnemyShotList, 5));
+					pSprite->actController.SetGenerator(EnemyShotGenerator(sprPlayer[0], EnemyShotLauncher(freeEnemyShotList, enemyShotBatch), 5));
 					pSprite->SetCollisionId(CSID_EnemyMiddle);
 					pSprite->hp = 40;
 				}
 				break;
 			case EnemyType_Boss1st:
-				if (Sprite::Sprite* pSprite = local::GetSprite(freeEnemyList, *itr)) {
+				if (Sprite::Sprite* pSprite = getSprite(*itr)) {
 					pSprite->SetActionList(actionFile->Get(EnemyActListId_Boss1st));
+					pSprite->actController.UseTrack(true);
 					pSprite->SetAction(itr->cur->actionId);
-					pSprite->actController.SetGenerator(EnemyBoss1stShotGenerator(sprPlayer[0], freeEnemyShotList, 500, 0.25f));
+					pSprite->actController.SetGenerator(EnemyBoss1stShotGenerator(sprPlayer[0], EnemyShotLauncher(freeEnemyShotList, enemyShotBatch), 500, 0.25f));
 					pSprite->SetCollisionId(CSID_EnemyBoss1st);
 					pSprite->hp = 400;
 				}
@@ -788,9 +968,11 @@ void MainGameScene::GenerateEnemy(double delta)
 */
 void MainGameScene::UpdateEnemy(double delta)
 {
-	for (Sprite::Sprite& sprite : sprEnemy) {
-		sprite.Update(delta);
+	for (size_t i = EID_Enemy; i < EID_Enemy + enemyCount; ++i) {
+		prevEnemyPos[i - EID_Enemy] = XMFLOAT2(sprEnemy[i].pos.x, sprEnemy[i].pos.y);
+		sprEnemy[i].Update(delta);
 	}
+	enemyShotBatch.Update(static_cast<float>(delta));
 	for (size_t i = EID_Enemy; i < EID_Enemy + enemyCount; ++i) {
 		Sprite::Sprite& p = sprEnemy[i];
 		if (p.GetCollisionId() == CSID_None) {
@@ -803,19 +985,20 @@ void MainGameScene::UpdateEnemy(double delta)
 			freeEnemyList.push_back(&p);
 			continue;
 		}
-		p.color = XMFLOAT4(1, 1, 1, 1);
+		p.SetPaletteIndex(EnemyPaletteId_Normal);
 	}
 	for (size_t i = EID_EnemyShot; i < EID_EnemyShot + enemyShotCount; ++i) {
 		Sprite::Sprite& p = sprEnemy[i];
 		if (p.GetCollisionId() == CSID_None) {
 			continue;
 		}
-		if (p.actController.IsDeletable() ||
+		const uint32_t slot = static_cast<uint32_t>(i - EID_EnemyShot);
+		if (enemyShotBatch.IsDeletable(slot) ||
 			p.pos.x < -32 || p.pos.x >= 832 ||
 			p.pos.y < -32 || p.pos.y >= 632) {
-			p.SetActionList(nullptr);
 			p.SetCollisionId(CSID_None);
-			p.pos.y = -100;
+			enemyShotBatch.SetManualMove(slot, XMFLOAT2(0, 0));
+			enemyShotBatch.SetPosition(slot, XMFLOAT2(p.pos.x, -100));
 			freeEnemyShotList.push_back(&p);
 		}
 	}
@@ -853,9 +1036,9 @@ void MainGameScene::UpdateScore(uint32_t score)
 */
 void MainGameScene::SolveCollision(::Scene::Context& context)
 {
-	DetectCollision(
-		sprPlayer.begin() + PID_PlayerShot, sprPlayer.end(),
-		sprEnemy.begin() + EID_Enemy, sprEnemy.begin() + enemyCount,
+	DetectSweptCollision(
+		sprPlayer.begin() + PID_PlayerShot, sprPlayer.end(), prevPlayerPos.data() + PID_PlayerShot,
+		sprEnemy.begin() + EID_Enemy, sprEnemy.begin() + EID_Enemy + enemyCount, prevEnemyPos.data(),
 		[this, &context](Sprite::Sprite& a, Sprite::Sprite& b) {
 		if (a.pos.y <= -32) {
 			a.actController.SetManualMove(0, 0);
@@ -871,7 +1054,7 @@ void MainGameScene::SolveCollision(::Scene::Context& context)
 		freePlayerShotList.push_back(&a);
 		if (--b.hp > 0) {
 			context.score += 10;
-			b.color = XMFLOAT4(1, 0, 0, 1);
+			b.SetPaletteIndex(EnemyPaletteId_Damaged);
 			seHit->Play();
 			return CollisionResult::FilterOut;
 		}
@@ -947,6 +1130,10 @@ void MainGameScene::SolveCollision(::Scene::Context& context)
 			b.SetCollisionId(CSID_None);
 			context.score += 100;
 			VibrateGamePad(GamePadId_1P, 0);
+		} else if (&b >= &sprEnemy[EID_EnemyShot]) {
+			const uint32_t slot = static_cast<uint32_t>(&b - &sprEnemy[EID_EnemyShot]);
+			enemyShotBatch.SetPosition(slot, XMFLOAT2(b.pos.x, -32));
+			enemyShotBatch.SetManualMove(slot, 0, 0);
 		} else {
 			b.pos.y = -32;
 			b.actController.SetManualMove(0, 0);
@@ -973,6 +1160,7 @@ int MainGameScene::Update(::Scene::Context& context, double delta)
 		bgm->SetVolume(bgmVolume);
 	}
 
+	animationSystem.Update(delta);
 	UpdatePlayer(delta);
 	UpdateEnemy(delta);
 	GenerateEnemy(delta);
@@ -981,9 +1169,9 @@ int MainGameScene::Update(::Scene::Context& context, double delta)
 
 	UpdateScore(context.score);
 
-	for (Sprite::Sprite& sprite : sprBackground) {
-		sprite.Update(delta);
-	}
+	// ʂ̏ɌĐiނ̂ŁA}bv̕\ʒu͏(YW̏ق)ֈړ.
+	bgTileMap.SetScroll(XMFLOAT2(0, bgLoopPixel - static_cast<float>(std::fmod(time * bgScrollSpeed, bgLoopPixel))));
+	bgTileMap.Update();
 
 	const GamePad gamepad = GetGamePad(GamePadId_1P);
 	static const uint32_t endingKey = GamePad::A | GamePad::START;
@@ -1001,6 +1189,8 @@ int MainGameScene::Update(::Scene::Context& context, double delta)
 
 /**
 * CQ[V[̕`.
+*
+* XvCg̕`e͂R}hXg[ɋL^A܂Ƃ߂ĕ`NXɓn.
 */
 void MainGameScene::Draw(Graphics::Graphics& graphics) const
 {
@@ -1013,8 +1203,17 @@ void MainGameScene::Draw(Graphics::Graphics& graphics) const
 	spriteRenderingInfo.matViewProjection = graphics.matViewProjection;
 
 	const PSO& pso = GetPSO(PSOType_Sprite);
-	graphics.spriteRenderer.Draw(sprBackground, cellList, bundleId[0], spriteRenderingInfo);
-	graphics.spriteRenderer.Draw(sprEnemy, cellFile[1]->Get(0)->list.data(), bundleId[1], spriteRenderingInfo);
-	graphics.spriteRenderer.Draw(sprPlayer, cellPlayer->Get(0)->list.data(), bundleId[1], spriteRenderingInfo);
-	graphics.spriteRenderer.Draw(sprFont, cellFile[0]->Get(0)->list.data(), bundleId[2], spriteRenderingInfo);
+	const D3D12_VIEWPORT& vp = graphics.viewport;
+	drawStream.Reset();
+	const Sprite::StreamState state = { graphics.matViewProjection, XMFLOAT4(vp.TopLeftX, vp.TopLeftY, vp.Width, vp.Height) };
+	drawStream.SetState(state);
+	drawStream.BindBundle(bundleId[0]);
+	bgTileMap.Draw(drawStream, state);
+	drawStream.BindBundle(bundleId[3]);
+	drawStream.Draw(sprEnemy, cellFile[1]->Get(0)->list.data());
+	drawStream.BindBundle(bundleId[1]);
+	drawStream.Draw(sprPlayer, cellPlayer->Get(0)->list.data());
+	drawStream.BindBundle(bundleId[2]);
+	drawStream.Draw(sprFont, cellFile[0]->Get(0)->list.data());
+	graphics.spriteRenderer.Submit(drawStream, spriteRenderingInfo);
 }
@@ -6,6 +6,7 @@
 #include "../Scene.h"
 #include "../Texture.h"
 #include "../Sprite.h"
+#include "../TileMap.h"
 #include "../Animation.h"
 #include "../Action.h"
 #include "../Audio.h"
@@ -43,10 +44,16 @@ private:
 
 	Resource::Texture texBackground;
 	Resource::Texture texObjects;
+	Resource::Texture texEnemy; ///< Gp̃CfbNXeNX`. e̓_łpbgŕ\.
+	Resource::Texture texEnemyPalette;
 	Resource::Texture texFont;
-	std::vector<Sprite::Sprite> sprBackground;
+	Sprite::CellList bgTileset; ///< wi摜^CɕZXg.
+	Sprite::TileMap bgTileMap;
+	AnimationSystem animationSystem; ///< sprPlayersprEnemỹAj[VǗ. XvCgɔj邽߁Aɐ錾.
 	std::vector<Sprite::Sprite> sprPlayer;
+	std::vector<DirectX::XMFLOAT2> prevPlayerPos; ///< O̍XVsOsprPlayer̍W.
 	std::vector<Sprite::Sprite> sprEnemy;
+	std::vector<DirectX::XMFLOAT2> prevEnemyPos; ///< O̍XVsO̓G(sprEnemyEID_Enemyn܂vf)̍W.
 	std::vector<Sprite::Sprite> sprFont;
 	Sprite::FilePtr cellFile[2];
 	Sprite::FilePtr cellPlayer;
@@ -66,6 +73,7 @@ private:
 	std::vector<Sprite::Sprite*> freePlayerShotList;
 	std::vector<Sprite::Sprite*> freeEnemyList;
 	std::vector<Sprite::Sprite*> freeEnemyShotList;
+	Action::Batch enemyShotBatch; ///< Ge̍WƑxǗ. Xbgԍ͓GeXvCg̕яƈv.
 	double time;
 	double clearTime;
 
@@ -80,7 +88,8 @@ private:
 	int playerShotCycle = 0;
 	float playerShotInterval = 0;
 
-	Sprite::BundleId bundleId[3];
+	Sprite::BundleId bundleId[4];
+	mutable Sprite::CommandStream drawStream; ///< XvCg̕`e. t[L^.
 };
 
 #endif // DX12TUTORIAL_SRC_SCENE_MAINGAMESCENE_H_
@@ -0,0 +1,925 @@
+/**
+* @file SoftwareRenderer.cpp
+*/
+#include "SoftwareRenderer.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <float.h>
+#include <math.h>
+#ifdef SPRITE_ENABLE_SOFTWARE_RENDERER_TEST
+#include "Platform.h"
+#include <stdio.h>
+#endif // SPRITE_ENABLE_SOFTWARE_RENDERER_TEST
+
+using namespace DirectX;
+
+namespace Sprite {
+
+namespace /* unnamed */ {
+
+/// eNX`o^ĂȂohŎg̃eNX`. FƂĈ.
+const Image emptyImage{};
+
+/**
+* RGBA8`̃sNZ0`1͈̔͂̃xNgɕϊ.
+*
+* @param c ϊsNZ.
+*
+* @return cR, G, B, ȀɊi[xNg.
+*/
+XMVECTOR LoadColor(uint32_t c)
+{
+	static const XMVECTORF32 scale{ 1.0f / 255.0f, 1.0f / 255.0f, 1.0f / 255.0f, 1.0f / 255.0f };
+	const XMVECTOR v = XMVectorSet(
+		static_cast<float>(c & 0xff),
+		static_cast<float>((c >> 8) & 0xff),
+		static_cast<float>((c >> 16) & 0xff),
+		static_cast<float>(c >> 24)
+	);
+	return XMVectorMultiply(v, scale);
+}
+
+/**
+* 0`1͈̔͂̃xNgRGBA8`̃sNZɕϊ.
+*
+* @param v ϊxNg.
+*
+* @return vɑΉsNZ.
+*/
+uint32_t StoreColor(XMVECTOR v)
+{
+	static const XMVECTORF32 scale{ 255.0f, 255.0f, 255.0f, 255.0f };
+	static const XMVECTORF32 half{ 0.5f, 0.5f, 0.5f, 0.5f };
+	XMFLOAT4 tmp;
+	XMStoreFloat4(&tmp, XMVectorMultiplyAdd(XMVectorSaturate(v), scale, half));
+	return static_cast<uint32_t>(tmp.x) |
+		(static_cast<uint32_t>(tmp.y) << 8) |
+		(static_cast<uint32_t>(tmp.z) << 16) |
+		(static_cast<uint32_t>(tmp.w) << 24);
+}
+
+/**
+* eNX`WJԂ͈͂Ɏ߂.
+*/
+int32_t Wrap(int32_t i, int32_t n)
+{
+	i %= n;
+	return i < 0 ? i + n : i;
+}
+
+/**
+* eNX`oCjAtB^ŃTvO.
+*
+* XvCgpPSÕTv[ɍ킹AAhbVO[hWRAPƂĈ.
+*
+* @param tex TvOeNX`.
+* @param u   eNX`WU.
+* @param v   eNX`WV.
+*
+* @return TvOF.
+*         eNX`̏ꍇ(1, 1, 1, 1)Ԃ.
+*/
+XMVECTOR Sample(const Image& tex, float u, float v)
+{
+	if (tex.data.empty()) {
+		return XMVectorSplatOne();
+	}
+	const int32_t w = static_cast<int32_t>(tex.width);
+	const int32_t h = static_cast<int32_t>(tex.height);
+	const float x = u * static_cast<float>(w) - 0.5f;
+	const float y = v * static_cast<float>(h) - 0.5f;
+	const float fx = floorf(x);
+	const float fy = floorf(y);
+	const int32_t x0 = Wrap(static_cast<int32_t>(fx), w);
+	const int32_t y0 = Wrap(static_cast<int32_t>(fy), h);
+	const int32_t x1 = Wrap(x0 + 1, w);
+	const int32_t y1 = Wrap(y0 + 1, h);
+	const XMVECTOR c00 = LoadColor(tex.data[y0 * w + x0]);
+	const XMVECTOR c10 = LoadColor(tex.data[y0 * w + x1]);
+	const XMVECTOR c01 = LoadColor(tex.data[y1 * w + x0]);
+	const XMVECTOR c11 = LoadColor(tex.data[y1 * w + x1]);
+	const XMVECTOR top = XMVectorLerp(c00, c10, x - fx);
+	const XMVECTOR bottom = XMVectorLerp(c01, c11, x - fx);
+	return XMVectorLerp(top, bottom, y - fy);
+}
+
+} // unnamed namespace
+
+/**
+* 摜TGA`Ńt@Cɕۑ.
+*
+* @param image    ۑ摜.
+* @param filename ۑ̃t@C.
+*
+* @retval true  ۑ.
+* @retval false ۑs.
+*/
+bool SaveImageToTgaFile(const Image& image, const char* filename)
+{
+	std::ofstream ofs(filename, std::ios::binary);
+	if (!ofs) {
+		return false;
+	}
+	const uint8_t header[18] = {
+		0, 0, 2, // ID, J[}bvȂ, 񈳏ktJ[.
+		0, 0, 0, 0, 0, // J[}bv.
+		0, 0, 0, 0, // _.
+		static_cast<uint8_t>(image.width), static_cast<uint8_t>(image.width >> 8),
+		static_cast<uint8_t>(image.height), static_cast<uint8_t>(image.height >> 8),
+		32, 0x28, // 32rbgJ[, At@8rbgE㌴_.
+	};
+	ofs.write(reinterpret_cast<const char*>(header), sizeof(header));
+	std::vector<uint8_t> buffer;
+	buffer.resize(image.data.size() * 4);
+	for (size_t i = 0; i < image.data.size(); ++i) {
+		const uint32_t c = image.data[i];
+		buffer[i * 4 + 0] = static_cast<uint8_t>(c >> 16);
+		buffer[i * 4 + 1] = static_cast<uint8_t>(c >> 8);
+		buffer[i * 4 + 2] = static_cast<uint8_t>(c);
+		buffer[i * 4 + 3] = static_cast<uint8_t>(c >> 24);
+	}
+	ofs.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+	return ofs.good();
+}
+
+/**
+* SaveImageToTgaFile()ŕۑTGAt@Cǂݍ.
+*
+* ǂݍ߂͔̂񈳏k32rbgJ[̉摜.
+*
+* @param image    ǂݍ񂾉摜̊i[.
+* @param filename ǂݍރt@C.
+*
+* @retval true  ǂݍݐ.
+* @retval false ǂݍݎs.
+*/
+bool LoadImageFromTgaFile(Image& image, const char* filename)
+{
+	std::ifstream ifs(filename, std::ios::binary);
+	if (!ifs) {
+		return false;
+	}
+	uint8_t header[18];
+	if (!ifs.read(reinterpret_cast<char*>(header), sizeof(header))) {
+		return false;
+	}
+	if (header[2] != 2 || header[16] != 32) {
+		return false;
+	}
+	ifs.seekg(header[0], std::ios::cur);
+	const uint32_t width = header[12] | (header[13] << 8);
+	const uint32_t height = header[14] | (header[15] << 8);
+	std::vector<uint8_t> buffer;
+	buffer.resize(width * height * 4);
+	if (!ifs.read(reinterpret_cast<char*>(buffer.data()), buffer.size())) {
+		return false;
+	}
+	// _̏ꍇ͏㉺𔽓]ēǂݍ.
+	const bool isBottomUp = !(header[17] & 0x20);
+	image.width = width;
+	image.height = height;
+	image.data.resize(width * height);
+	for (uint32_t y = 0; y < height; ++y) {
+		const uint8_t* src = buffer.data() + (isBottomUp ? height - 1 - y : y) * width * 4;
+		for (uint32_t x = 0; x < width; ++x, src += 4) {
+			image.data[y * width + x] = (src[2]) | (src[1] << 8) | (src[0] << 16) | (static_cast<uint32_t>(src[3]) << 24);
+		}
+	}
+	return true;
+}
+
+/**
+* 2̉摜r.
+*
+* @param lhs       r摜1.
+* @param rhs       r摜2.
+* @param tolerance FƂ݂Ȃe`l̍̍ől.
+*
+* @return ꂩ̃`l̍tolerance𒴂sNZ̐.
+*         摜̑傫قȂꍇsize_t̍őlԂ.
+*/
+size_t CompareImage(const Image& lhs, const Image& rhs, int tolerance)
+{
+	if (lhs.width != rhs.width || lhs.height != rhs.height || lhs.data.size() != rhs.data.size()) {
+		return std::numeric_limits<size_t>::max();
+	}
+	size_t count = 0;
+	for (size_t i = 0; i < lhs.data.size(); ++i) {
+		for (int shift = 0; shift < 32; shift += 8) {
+			const int a = static_cast<int>((lhs.data[i] >> shift) & 0xff);
+			const int b = static_cast<int>((rhs.data[i] >> shift) & 0xff);
+			if (std::abs(a - b) > tolerance) {
+				++count;
+				break;
+			}
+		}
+	}
+	return count;
+}
+
+/**
+* RXgN^.
+*/
+SoftwareRenderer::SoftwareRenderer() :
+	tileCountX(0),
+	tileCountY(0),
+	maxSpriteCount(0),
+	spriteCount(0),
+	threadCount(1),
+	isDrawing(false),
+	workerGeneration(0),
+	busyWorkerCount(0),
+	isWorkerQuit(false),
+	nextTile(0)
+{
+	image.width = 0;
+	image.height = 0;
+}
+
+/**
+* fXgN^.
+*
+* X^CYp̃XbhI.
+*/
+SoftwareRenderer::~SoftwareRenderer()
+{
+	StopWorkers();
+}
+
+/**
+* SoftwareRenderer.
+*
+* @param width     `摜̕.
+* @param height    `摜̍.
+* @param maxSprite 1t[ɕ`łőXvCg.
+* @param numThread X^CYɎgXbh. 0̏ꍇ̓n[hEFAXbhg.
+*                  ĂяõXbhɊ܂܂邽߁A쐬XbhnumThread-1ɂȂ.
+*
+* @retval true  .
+* @retval false s.
+*/
+bool SoftwareRenderer::Init(uint32_t width, uint32_t height, int maxSprite, int numThread)
+{
+	if (width == 0 || height == 0 || maxSprite <= 0 || isDrawing) {
+		return false;
+	}
+	StopWorkers();
+	image.width = width;
+	image.height = height;
+	image.data.resize(width * height);
+	depthBuffer.resize(width * height);
+
+	tileCountX = (width + tileSize - 1) / tileSize;
+	tileCountY = (height + tileSize - 1) / tileSize;
+	binList.resize(tileCountX * tileCountY);
+
+	maxSpriteCount = maxSprite;
+	triangleList.reserve(maxSpriteCount * 2);
+
+	threadCount = numThread > 0 ? numThread : static_cast<int>(std::thread::hardware_concurrency());
+	if (threadCount <= 0) {
+		threadCount = 1;
+	}
+	workerList.reserve(threadCount - 1);
+	for (int i = 1; i < threadCount; ++i) {
+		workerList.emplace_back(&SoftwareRenderer::WorkerMain, this, workerGeneration);
+	}
+	return true;
+}
+
+/**
+* ohɑΉeNX`o^.
+*
+* Submit()́AXg[ɋL^ꂽohID炱œo^eNX`I.
+* o^ĂȂoh͔F̃eNX`Ƃĕ`悳.
+*
+* @param bundleId eNX`ΉohID.
+* @param texture  ohɑΉeNX`. nullptȑꍇ͓o^.
+*                 SoftwareRenderer̓|C^ێ邽߁A`悪I܂ŔjȂ.
+*/
+void SoftwareRenderer::SetTexture(const BundleId& bundleId, const Image* texture)
+{
+	if (!bundleId) {
+		return;
+	}
+	if (textureList.size() <= *bundleId) {
+		textureList.resize(*bundleId + 1, nullptr);
+	}
+	textureList[*bundleId] = texture;
+}
+
+/**
+* XvCg̕`Jn.
+*
+* `摜clearColorŁA[xobt@1.0œhԂ.
+*
+* @param clearColor `摜hԂF.
+*
+* @retval true  `\ȏԂɂȂ.
+* @retval false `\ȏԂւ̑JڂɎs.
+*/
+bool SoftwareRenderer::Begin(const XMFLOAT4& clearColor)
+{
+	if (isDrawing || image.data.empty()) {
+		return false;
+	}
+	std::fill(image.data.begin(), image.data.end(), StoreColor(XMLoadFloat4(&clearColor)));
+	std::fill(depthBuffer.begin(), depthBuffer.end(), 1.0f);
+	triangleList.clear();
+	spriteCount = 0;
+	isDrawing = true;
+	return true;
+}
+
+/**
+* XvCg`.
+*
+* @param spriteList        `悷XvCg̃Xg.
+* @param cellList          `ɎgpZXg.
+* @param texture           `ɎgpeNX`.
+* @param matViewProjection `ɎgpWϊs.
+*
+* @retval true  `̓o^.
+* @retval false `̓o^s.
+*/
+bool SoftwareRenderer::Draw(const std::vector<Sprite>& spriteList, const Cell* cellList, const Image& texture, const XMFLOAT4X4& matViewProjection)
+{
+	if (spriteList.empty()) {
+		return isDrawing;
+	}
+	return Draw(&*spriteList.begin(), (&*spriteList.begin()) + spriteList.size(), cellList, texture, matViewProjection);
+}
+
+/**
+* XvCg`.
+*
+* @param first             `悷XvCg̐擪.
+* @param last              `悷XvCg̏I[.
+* @param cellList          `ɎgpZXg.
+* @param texture           `ɎgpeNX`.
+* @param matViewProjection `ɎgpWϊs.
+*
+* @retval true  `̓o^.
+* @retval false `̓o^s.
+*/
+bool SoftwareRenderer::Draw(const Sprite* first, const Sprite* last, const Cell* cellList, const Image& texture, const XMFLOAT4X4& matViewProjection)
+{
+	if (!isDrawing) {
+		return false;
+	}
+	const DrawParameters param = SetupDraw(cellList, texture, matViewProjection);
+	for (const Sprite* sprite = first; sprite != last; ++sprite) {
+		if (!Draw(param, *sprite)) {
+			break;
+		}
+	}
+	return true;
+}
+
+/**
+* XvCg`惋[v̐ݒ.
+*
+* @param cellList          `ɎgpZXg.
+* @param texture           `ɎgpeNX`.
+* @param matViewProjection `ɎgpWϊs.
+*
+* @return `惋[vpp[^.
+*/
+SoftwareRenderer::DrawParameters SoftwareRenderer::SetupDraw(const Cell* cellList, const Image& texture, const XMFLOAT4X4& matViewProjection) const
+{
+	return DrawParameters{
+		cellList,
+		&texture,
+		matViewProjection,
+		{ 0, 0, static_cast<float>(image.width), static_cast<float>(image.height) },
+		{ -(static_cast<float>(image.width) * 0.5f), static_cast<float>(image.height) * 0.5f }
+	};
+}
+
+/**
+* XvCgOp`ɕϊēo^.
+*
+* _f[^̍쐬RendererƓAddVertex()ōs.
+*
+* @param param  `惋[vpp[^.
+* @param sprite `悷XvCg.
+*
+* @retval true  `p.
+* @retval false `I.
+*/
+bool SoftwareRenderer::Draw(const DrawParameters& param, const Sprite& sprite)
+{
+	if (sprite.scale.x == 0 || sprite.scale.y == 0) {
+		return true;
+	}
+	if (spriteCount >= maxSpriteCount) {
+		return false;
+	}
+	Vertex v[4];
+	AddVertex(sprite, param.cellList + sprite.GetCellIndex(), sprite.animeController.GetData(), v, param.offset);
+	return AddQuad(param, v);
+}
+
+/**
+* lp`2̎Op`ɕϊēo^.
+*
+* Wϊs̓VF[_ƓA]uꂽԂŉ߂.
+*
+* @param param `惋[vpp[^.
+* @param v     lp`̒_f[^(4).
+*
+* @retval true  `p.
+* @retval false `łXvCg̏ɒB.
+*/
+bool SoftwareRenderer::AddQuad(const DrawParameters& param, const Vertex* v)
+{
+	if (spriteCount >= maxSpriteCount) {
+		return false;
+	}
+	const XMMATRIX m = XMMatrixTranspose(XMLoadFloat4x4(&param.matViewProjection));
+	const float halfWidth = param.viewport.z * 0.5f;
+	const float halfHeight = param.viewport.w * 0.5f;
+	XMVECTOR pos[4];
+	for (int i = 0; i < 4; ++i) {
+		const XMVECTOR clip = XMVector4Transform(XMVectorSetW(XMLoadFloat3(&v[i].position), 1.0f), m);
+		const float w = XMVectorGetW(clip);
+		if (w <= 0.0f) {
+			return true;
+		}
+		const float invW = 1.0f / w;
+		pos[i] = XMVectorSet(
+			(XMVectorGetX(clip) * invW + 1.0f) * halfWidth + param.viewport.x,
+			(1.0f - XMVectorGetY(clip) * invW) * halfHeight + param.viewport.y,
+			XMVectorGetZ(clip) * invW,
+			invW
+		);
+	}
+	AddTriangle(pos, v, 0, 1, 2, param.texture);
+	AddTriangle(pos, v, 2, 3, 0, param.texture);
+	++spriteCount;
+	return true;
+}
+
+/**
+* Op`̃X^CYpf[^쐬ēo^.
+*
+* @param pos     XN[Wɕϊ_W(wɂ1/wi[).
+* @param v       _f[^.
+* @param i0      Op`1߂̒_̃CfbNX.
+* @param i1      Op`2߂̒_̃CfbNX.
+* @param i2      Op`3߂̒_̃CfbNX.
+* @param texture Op`̕`ɎgpeNX`.
+*/
+void SoftwareRenderer::AddTriangle(const XMVECTOR* pos, const Vertex* v, int i0, int i1, int i2, const Image* texture)
+{
+	const int index[3] = { i0, i1, i2 };
+	XMFLOAT4 p[3];
+	for (int i = 0; i < 3; ++i) {
+		XMStoreFloat4(&p[i], pos[index[i]]);
+	}
+
+	// XN[WYȂ̂ŁAvȂʐςɂȂ.
+	// XvCgpPSO͔wʃJOs߁Aʐς0ȉ̎Op`͕`悵Ȃ.
+	const float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+	if (area <= 0.0f) {
+		return;
+	}
+
+	Triangle t;
+	t.minX = std::max(0, static_cast<int32_t>(floorf(std::min({ p[0].x, p[1].x, p[2].x }))));
+	t.minY = std::max(0, static_cast<int32_t>(floorf(std::min({ p[0].y, p[1].y, p[2].y }))));
+	t.maxX = std::min(static_cast<int32_t>(image.width), static_cast<int32_t>(ceilf(std::max({ p[0].x, p[1].x, p[2].x }))));
+	t.maxY = std::min(static_cast<int32_t>(image.height), static_cast<int32_t>(ceilf(std::max({ p[0].y, p[1].y, p[2].y }))));
+	if (t.minX >= t.maxX || t.minY >= t.maxY) {
+		return;
+	}
+	t.texture = texture;
+
+	// edge[k]kԖڂ̒_̑Εӂ̃GbW֐ŁAareaŊkԖڂ̒_̏dSWɂȂ.
+	for (int k = 0; k < 3; ++k) {
+		const XMFLOAT4& a = p[(k + 1) % 3];
+		const XMFLOAT4& b = p[(k + 2) % 3];
+		const float ea = -(b.y - a.y);
+		const float eb = b.x - a.x;
+		t.edge[k] = XMFLOAT3(ea, eb, (b.y - a.y) * a.x - (b.x - a.x) * a.y);
+		// ӂƏӂɏsNZ͕`悵AȊO̕ӂɏsNZ͕`悵Ȃ.
+		const bool isTopLeft = ea > 0.0f || (ea == 0.0f && eb > 0.0f);
+		t.edgeBias[k] = isTopLeft ? 0.0f : FLT_MIN;
+	}
+
+	// 1/w|ĂAsNZƂw|Ė߂Ƃœ␳s.
+	float attr[3][8];
+	for (int k = 0; k < 3; ++k) {
+		const Vertex& e = v[index[k]];
+		const float invW = p[k].w;
+		attr[k][0] = p[k].z;
+		attr[k][1] = invW;
+		attr[k][2] = e.texcoord.x * invW;
+		attr[k][3] = e.texcoord.y * invW;
+		attr[k][4] = e.color.x * invW;
+		attr[k][5] = e.color.y * invW;
+		attr[k][6] = e.color.z * invW;
+		attr[k][7] = e.color.w * invW;
+	}
+	const float invArea = 1.0f / area;
+	for (int i = 0; i < 8; ++i) {
+		t.attr[i].x = (t.edge[0].x * attr[0][i] + t.edge[1].x * attr[1][i] + t.edge[2].x * attr[2][i]) * invArea;
+		t.attr[i].y = (t.edge[0].y * attr[0][i] + t.edge[1].y * attr[1][i] + t.edge[2].y * attr[2][i]) * invArea;
+		t.attr[i].z = (t.edge[0].z * attr[0][i] + t.edge[1].z * attr[1][i] + t.edge[2].z * attr[2][i]) * invArea;
+	}
+	triangleList.push_back(t);
+}
+
+/**
+* R}hXg[̋L^e`悷.
+*
+* Xg[̒_f[^41̎lp`ƂĈ.
+* eNX`SetTexture()ŃohIDɑΉt̂g.
+*
+* @param stream `悷R}hXg[.
+*
+* @retval true  `̓o^.
+* @retval false `̓o^s.
+*/
+bool SoftwareRenderer::Submit(const CommandStream& stream)
+{
+	if (!isDrawing) {
+		return false;
+	}
+	XMFLOAT4X4 identity;
+	XMStoreFloat4x4(&identity, XMMatrixIdentity());
+	DrawParameters param = SetupDraw(nullptr, emptyImage, identity);
+	const Vertex* const v = stream.GetVertexList().data();
+	bool hasBundle = false;
+	for (const Command& cmd : stream.GetCommandList()) {
+		switch (cmd.type) {
+		case CommandType::SetState: {
+			const StreamState& state = stream.GetStateList()[cmd.index];
+			param.matViewProjection = state.matViewProjection;
+			param.viewport = state.viewport;
+			break;
+		}
+		case CommandType::BindBundle: {
+			const BundleId& bundleId = stream.GetBundleList()[cmd.index];
+			param.texture = &emptyImage;
+			if (bundleId && *bundleId < textureList.size() && textureList[*bundleId]) {
+				param.texture = textureList[*bundleId];
+			}
+			hasBundle = true;
+			break;
+		}
+		case CommandType::Draw:
+			if (!hasBundle) {
+				return false;
+			}
+			for (uint32_t i = 0; i + 4 <= cmd.count; i += 4) {
+				if (!AddQuad(param, v + cmd.first + i)) {
+					return true;
+				}
+			}
+			break;
+		}
+	}
+	return true;
+}
+
+/**
+* XvCg̕`I.
+*
+* o^ꂽOp`^CɐU蕪A^CPʂŕɃX^CY.
+* ̊֐Ԃ_ŁAGetImage()ŕ`挋ʂ擾ł.
+*
+* @retval true  `搬.
+* @retval false `掸s.
+*/
+bool SoftwareRenderer::End()
+{
+	if (!isDrawing) {
+		return false;
+	}
+	isDrawing = false;
+
+	for (auto& e : binList) {
+		e.clear();
+	}
+	for (size_t i = 0; i < triangleList.size(); ++i) {
+		const Triangle& t = triangleList[i];
+		const uint32_t tx0 = t.minX / tileSize;
+		const uint32_t ty0 = t.minY / tileSize;
+		const uint32_t tx1 = (t.maxX - 1) / tileSize;
+		const uint32_t ty1 = (t.maxY - 1) / tileSize;
+		for (uint32_t ty = ty0; ty <= ty1; ++ty) {
+			for (uint32_t tx = tx0; tx <= tx1; ++tx) {
+				binList[ty * tileCountX + tx].push_back(static_cast<uint32_t>(i));
+			}
+		}
+	}
+
+	// X^CYp̃XbhNAĂяõXbhꏏɃ^C.
+	nextTile = 0;
+	{
+		std::lock_guard<std::mutex> lock(workerMutex);
+		++workerGeneration;
+		busyWorkerCount = workerList.size();
+	}
+	startCondition.notify_all();
+	RasterizeTiles();
+	{
+		std::unique_lock<std::mutex> lock(workerMutex);
+		doneCondition.wait(lock, [this]() { return busyWorkerCount == 0; });
+	}
+	return true;
+}
+
+/**
+* ̃^CȂȂ܂ŁA^C1oăX^CY.
+*
+* ^Cm͏ݐ̃sNZdȂȂ߁AbNɕ񏈗ł.
+*/
+void SoftwareRenderer::RasterizeTiles()
+{
+	const size_t tileCount = binList.size();
+	for (size_t i = nextTile++; i < tileCount; i = nextTile++) {
+		if (!binList[i].empty()) {
+			RasterizeTile(i);
+		}
+	}
+}
+
+/**
+* X^CYpXbh̏.
+*
+* End()workerGenerationXV܂őҋ@A^CĂёҋ@.
+*
+* @param startGeneration Xbh쐬_workerGeneration.
+*/
+void SoftwareRenderer::WorkerMain(uint64_t startGeneration)
+{
+	uint64_t generation = startGeneration;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(workerMutex);
+			startCondition.wait(lock, [this, generation]() { return isWorkerQuit || workerGeneration != generation; });
+			if (isWorkerQuit) {
+				return;
+			}
+			generation = workerGeneration;
+		}
+		RasterizeTiles();
+		{
+			std::lock_guard<std::mutex> lock(workerMutex);
+			--busyWorkerCount;
+		}
+		doneCondition.notify_one();
+	}
+}
+
+/**
+* X^CYp̃XbhׂďI.
+*/
+void SoftwareRenderer::StopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(workerMutex);
+		isWorkerQuit = true;
+	}
+	startCondition.notify_all();
+	for (auto& e : workerList) {
+		e.join();
+	}
+	workerList.clear();
+	isWorkerQuit = false;
+}
+
+/**
+* 1̃^CX^CY.
+*
+* 4sNZ܂Ƃ߂āAGbW֐Ƒ̕ԂSIMDŌvZ.
+*
+* @param tileIndex X^CY^C̃CfbNX.
+*/
+void SoftwareRenderer::RasterizeTile(size_t tileIndex)
+{
+	const int32_t tileX = static_cast<int32_t>(tileIndex % tileCountX) * tileSize;
+	const int32_t tileY = static_cast<int32_t>(tileIndex / tileCountX) * tileSize;
+	const int32_t tileRight = std::min(tileX + tileSize, static_cast<int32_t>(image.width));
+	const int32_t tileBottom = std::min(tileY + tileSize, static_cast<int32_t>(image.height));
+	static const XMVECTORF32 laneOffset{ 0.5f, 1.5f, 2.5f, 3.5f };
+
+	for (uint32_t triangleIndex : binList[tileIndex]) {
+		const Triangle& t = triangleList[triangleIndex];
+		const int32_t sx = std::max(tileX, t.minX);
+		const int32_t sy = std::max(tileY, t.minY);
+		const int32_t ex = std::min(tileRight, t.maxX);
+		const int32_t ey = std::min(tileBottom, t.maxY);
+		if (sx >= ex || sy >= ey) {
+			continue;
+		}
+		const XMVECTOR right = XMVectorReplicate(static_cast<float>(ex));
+		XMVECTOR edgeA[3], edgeB[3], edgeC[3], edgeBias[3];
+		for (int k = 0; k < 3; ++k) {
+			edgeA[k] = XMVectorReplicate(t.edge[k].x);
+			edgeB[k] = XMVectorReplicate(t.edge[k].y);
+			edgeC[k] = XMVectorReplicate(t.edge[k].z);
+			edgeBias[k] = XMVectorReplicate(t.edgeBias[k]);
+		}
+		XMVECTOR attrA[8], attrB[8], attrC[8];
+		for (int i = 0; i < 8; ++i) {
+			attrA[i] = XMVectorReplicate(t.attr[i].x);
+			attrB[i] = XMVectorReplicate(t.attr[i].y);
+			attrC[i] = XMVectorReplicate(t.attr[i].z);
+		}
+
+		for (int32_t y = sy; y < ey; ++y) {
+			const XMVECTOR py = XMVectorReplicate(static_cast<float>(y) + 0.5f);
+			uint32_t* const colorLine = image.data.data() + y * image.width;
+			float* const depthLine = depthBuffer.data() + y * image.width;
+			for (int32_t x = sx; x < ex; x += 4) {
+				const XMVECTOR px = XMVectorAdd(XMVectorReplicate(static_cast<float>(x)), laneOffset);
+				XMVECTOR mask = XMVectorLess(px, right);
+				for (int k = 0; k < 3; ++k) {
+					const XMVECTOR e = XMVectorMultiplyAdd(edgeA[k], px, XMVectorMultiplyAdd(edgeB[k], py, edgeC[k]));
+					mask = XMVectorAndInt(mask, XMVectorGreaterOrEqual(e, edgeBias[k]));
+				}
+				uint32_t coverage[4];
+				XMStoreInt4(coverage, mask);
+				if (!(coverage[0] | coverage[1] | coverage[2] | coverage[3])) {
+					continue;
+				}
+
+				XMVECTOR attr[8];
+				for (int i = 0; i < 8; ++i) {
+					attr[i] = XMVectorMultiplyAdd(attrA[i], px, XMVectorMultiplyAdd(attrB[i], py, attrC[i]));
+				}
+				const XMVECTOR w = XMVectorReciprocal(attr[1]);
+				XMFLOAT4 z, u, v, r, g, b, a;
+				XMStoreFloat4(&z, attr[0]);
+				XMStoreFloat4(&u, XMVectorMultiply(attr[2], w));
+				XMStoreFloat4(&v, XMVectorMultiply(attr[3], w));
+				XMStoreFloat4(&r, XMVectorMultiply(attr[4], w));
+				XMStoreFloat4(&g, XMVectorMultiply(attr[5], w));
+				XMStoreFloat4(&b, XMVectorMultiply(attr[6], w));
+				XMStoreFloat4(&a, XMVectorMultiply(attr[7], w));
+				const float* const zLane = &z.x;
+				const float* const uLane = &u.x;
+				const float* const vLane = &v.x;
+				const float* const rLane = &r.x;
+				const float* const gLane = &g.x;
+				const float* const bLane = &b.x;
+				const float* const aLane = &a.x;
+
+				for (int lane = 0; lane < 4; ++lane) {
+					if (!coverage[lane]) {
+						continue;
+					}
+					// [xeXgLESS_EQUAL. [x͈̔͊OGPUƓlɃNbv.
+					const float depth = zLane[lane];
+					if (depth < 0.0f || depth > 1.0f || depth > depthLine[x + lane]) {
+						continue;
+					}
+					const XMVECTOR color = XMVectorSet(rLane[lane], gLane[lane], bLane[lane], aLane[lane]);
+					const XMVECTOR src = XMVectorMultiply(Sample(*t.texture, uLane[lane], vLane[lane]), color);
+					const XMVECTOR dst = LoadColor(colorLine[x + lane]);
+					// RGBSRC_ALPHA/INV_SRC_ALPHAōAAt@̓\[X̒l̂܂܏.
+					const float srcAlpha = XMVectorGetW(src);
+					colorLine[x + lane] = StoreColor(XMVectorSetW(XMVectorLerp(dst, src, srcAlpha), srcAlpha));
+					depthLine[x + lane] = depth;
+				}
+			}
+		}
+	}
+}
+
+#ifdef SPRITE_ENABLE_SOFTWARE_RENDERER_TEST
+/**
+* SoftwareRenderer̕`挋ʂ摜Ɣr.
+*
+* ]AgAA[xقȂXvCg`悵A3_mF.
+* - 1XbhDraw()ʂƁAXbhSubmit()ʂSɈv邱.
+* - Draw()ʂƊ摜̍toleranceȓł邱.
+* 摜݂Ȃꍇ͕`挋ʂ摜Ƃĕۑ.
+* 摜ƈvȂꍇ́A`挋ʂ"摜̃t@C.actual.tga"ɕۑ.
+*
+* @param goldenFilename 摜̃t@C.
+* @param tolerance      FƂ݂Ȃe`l̍̍ől.
+*
+* @retval true  `挋ʂ摜ƈvA܂͊摜쐬.
+* @retval false `挋ʂvȂ.
+*/
+bool TestSoftwareRenderer(const char* goldenFilename, int tolerance)
+{
+	const uint32_t width = 320;
+	const uint32_t height = 240;
+
+	// l̐FقȂ16x16̃eNX`ƁA̎l؂o4̃Zpӂ.
+	Image texture;
+	texture.width = 16;
+	texture.height = 16;
+	texture.data.resize(16 * 16);
+	static const uint32_t quarterColor[4] = { 0xffff4040, 0xff40ff40, 0x804040ff, 0xffffffff };
+	for (uint32_t y = 0; y < 16; ++y) {
+		for (uint32_t x = 0; x < 16; ++x) {
+			const uint32_t c = quarterColor[(y / 8) * 2 + (x / 8)];
+			texture.data[y * 16 + x] = ((x ^ y) & 1) ? c : (c & 0xff7f7f7f);
+		}
+	}
+	std::vector<Cell> cellList;
+	for (int i = 0; i < 4; ++i) {
+		cellList.push_back(Cell{ XMFLOAT2((i % 2) * 0.5f, (i / 2) * 0.5f), XMFLOAT2(0.5f, 0.5f), XMFLOAT2(24, 24) });
+	}
+
+	AnimationList animationList;
+	animationList.list.resize(4);
+	for (uint32_t i = 0; i < 4; ++i) {
+		animationList.list[i].push_back(AnimationData{ i, 1.0f, 0.0f, XMFLOAT2(1, 1), XMFLOAT4(1, 1, 1, 1) });
+	}
+	std::vector<Sprite> spriteList;
+	for (int i = 0; i < 48; ++i) {
+		const XMFLOAT3 pos(static_cast<float>(24 + (i % 8) * 38), static_cast<float>(24 + (i / 8) * 38), 100.0f + static_cast<float>((i * 37) % 200));
+		const XMFLOAT4 color(1.0f, 1.0f - (i % 3) * 0.25f, 1.0f, 1.0f - (i % 4) * 0.2f);
+		spriteList.push_back(Sprite(animationList, pos, i * 0.3f, XMFLOAT2(1.0f + (i % 5) * 0.25f, 1.0f + (i % 2) * 0.5f), color));
+		spriteList.back().SetSeqIndex(i % 4);
+	}
+
+	XMFLOAT4X4 matViewProjection;
+	XMStoreFloat4x4(&matViewProjection, XMMatrixOrthographicLH(static_cast<float>(width), static_cast<float>(height), 1.0f, 1000.0f));
+	const XMFLOAT4 clearColor(0.1f, 0.2f, 0.3f, 1.0f);
+	char text[256];
+
+	SoftwareRenderer single;
+	if (!single.Init(width, height, 1024, 1)) {
+		return false;
+	}
+	single.Begin(clearColor);
+	single.Draw(spriteList, cellList.data(), texture, matViewProjection);
+	single.End();
+
+	const BundleId bundleId = std::make_shared<size_t>(0);
+	CommandStream stream;
+	stream.SetState(StreamState{ matViewProjection, XMFLOAT4(0, 0, static_cast<float>(width), static_cast<float>(height)) });
+	stream.BindBundle(bundleId);
+	stream.Draw(spriteList, cellList.data());
+	SoftwareRenderer multi;
+	if (!multi.Init(width, height, 1024, 4)) {
+		return false;
+	}
+	multi.SetTexture(bundleId, &texture);
+	multi.Begin(clearColor);
+	RendererBase& renderer = multi;
+	renderer.Submit(stream);
+	renderer.End();
+
+	const size_t threadDiff = CompareImage(single.GetImage(), multi.GetImage(), 0);
+	snprintf(text, _countof(text), "TestSoftwareRenderer: Draw(1 thread) vs Submit(4 threads) diff=%u\n", static_cast<uint32_t>(threadDiff));
+	Platform::DebugOutput(text);
+	if (threadDiff != 0) {
+		return false;
+	}
+
+	Image golden;
+	if (!LoadImageFromTgaFile(golden, goldenFilename)) {
+		if (!SaveImageToTgaFile(single.GetImage(), goldenFilename)) {
+			return false;
+		}
+		snprintf(text, _countof(text), "TestSoftwareRenderer: %s not found. Created.\n", goldenFilename);
+		Platform::DebugOutput(text);
+		return true;
+	}
+	const size_t goldenDiff = CompareImage(single.GetImage(), golden, tolerance);
+	snprintf(text, _countof(text), "TestSoftwareRenderer: %s diff=%u\n", goldenFilename, static_cast<uint32_t>(goldenDiff));
+	Platform::DebugOutput(text);
+	if (goldenDiff != 0) {
+		snprintf(text, _countof(text), "%s.actual.tga", goldenFilename);
+		SaveImageToTgaFile(single.GetImage(), text);
+		return false;
+	}
+	return true;
+}
+#endif // SPRITE_ENABLE_SOFTWARE_RENDERER_TEST
+
+} // namespace Sprite
+
+#if defined(SPRITE_ENABLE_SOFTWARE_RENDERER_TEST) && !defined(_WIN32)
+/**
+* wbhXSoftwareRenderer̃eXgs.
+*
+* WindowsȊO̊ł́AD3D12ɈˑȂ̃t@CŃeXgvO쐬ł.
+* DirectXMathGitHubŌJĂwb_(sal.h܂)gp.
+* <pre>
+* g++ -std=c++14 -pthread -DSPRITE_ENABLE_SOFTWARE_RENDERER_TEST -I(DirectXMath̃pX) \
+*   SoftwareRenderer.cpp SpriteCore.cpp CommandStream.cpp CellMesh.cpp \
+*   Animation.cpp Action.cpp Json.cpp File.cpp Platform.cpp -o SoftwareRendererTest
+* ./SoftwareRendererTest (摜̃t@C)
+* </pre>
+* Windowsł́AAvP[VTestSoftwareRenderer()Ăяo.
+*
+* @retval 0 eXg.
+* @retval 1 eXgs.
+*/
+int main(int argc, char** argv)
+{
+	const char* goldenFilename = (argc > 1) ? argv[1] : "SoftwareRendererGolden.tga";
+	return Sprite::TestSoftwareRenderer(goldenFilename, 2) ? 0 : 1;
+}
+#endif // SPRITE_ENABLE_SOFTWARE_RENDERER_TEST
@@ -0,0 +1,125 @@
+/**
+* @file SoftwareRenderer.h
+*/
+#ifndef DX12TUTORIAL_SRC_SOFTWARERENDERER_H_
+#define DX12TUTORIAL_SRC_SOFTWARERENDERER_H_
+#include "SpriteCore.h"
+#include <DirectXMath.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <stdint.h>
+
+namespace Sprite {
+
+bool SaveImageToTgaFile(const Image& image, const char* filename);
+bool LoadImageFromTgaFile(Image& image, const char* filename);
+size_t CompareImage(const Image& lhs, const Image& rhs, int tolerance);
+
+// `TestSoftwareRenderer()LɂȂ. WindowsȊOł̓eXgpmain()LɂȂ.
+//#define SPRITE_ENABLE_SOFTWARE_RENDERER_TEST
+#ifdef SPRITE_ENABLE_SOFTWARE_RENDERER_TEST
+bool TestSoftwareRenderer(const char* goldenFilename, int tolerance);
+#endif // SPRITE_ENABLE_SOFTWARE_RENDERER_TEST
+
+/**
+* CPUŃXvCg`悷NX.
+*
+* RendererƓ菇(Begin, Draw, End)ŃXvCg`悵AʂImageɏ.
+* GPUgȂ߁AXN[Vbg̎擾`挋ʂ̔rwbhXōsƂł.
+*
+* - Drawł̓XvCgRendererƓ_f[^ɕϊAXN[W̎Op`ƂĒ~ς.
+* - Submitł́ACommandStreamɋL^ꂽ_f[^̂܂܎Op`ɕϊ.
+*   ohɑΉeNX`SetTexture()œo^Ă.
+* - EndŎOp`^CɐU蕪Ae^C𕡐̃XbhŕɃX^CY.
+*   X^CYp̃XbhInitō쐬AfXgN^ŏI܂Ŏg.
+* - 1^Cł͎Op`o^ɏ邽߁A`揇GPUƈv.
+* - `Xe[g̓XvCgpPSOɍ킹Ă(At@uhALESS_EQUAL̐[xeXgAwʃJO).
+*/
+class SoftwareRenderer : public RendererBase
+{
+public:
+	SoftwareRenderer();
+	virtual ~SoftwareRenderer();
+
+	bool Init(uint32_t width, uint32_t height, int maxSprite, int numThread = 0);
+	void SetTexture(const BundleId& bundleId, const Image* texture);
+	bool Begin(const DirectX::XMFLOAT4& clearColor);
+	bool Draw(const std::vector<Sprite>& spriteList, const Cell* cellList, const Image& texture, const DirectX::XMFLOAT4X4& matViewProjection);
+	bool Draw(const Sprite* first, const Sprite* last, const Cell* cellList, const Image& texture, const DirectX::XMFLOAT4X4& matViewProjection);
+	virtual bool Submit(const CommandStream& stream);
+	virtual bool End();
+	const Image& GetImage() const { return image; }
+
+	template<typename Iterator>
+	bool Draw(Iterator first, Iterator last, const Cell* cellList, const Image& texture, const DirectX::XMFLOAT4X4& matViewProjection)
+	{
+		if (!isDrawing) {
+			return false;
+		}
+		const DrawParameters param = SetupDraw(cellList, texture, matViewProjection);
+		for (Iterator sprite = first; sprite != last; ++sprite) {
+			if (!Draw(param, *sprite)) {
+				break;
+			}
+		}
+		return true;
+	}
+
+private:
+	static const int tileSize = 64; ///< ^C̕ƍ(sNZP).
+
+	/// `p[^.
+	struct DrawParameters {
+		const Cell* cellList;
+		const Image* texture;
+		DirectX::XMFLOAT4X4 matViewProjection;
+		DirectX::XMFLOAT4 viewport; ///< `͈̔(X, Y, , ).
+		DirectX::XMFLOAT2 offset;
+	};
+
+	/// X^CYpɕʕ(A * x + B * y + C)֕ϊOp`.
+	struct Triangle {
+		DirectX::XMFLOAT3 edge[3]; ///< 3ӂ̃GbW֐.
+		float edgeBias[3]; ///< gbvtgE[𖞂߂̃GbW֐臒l.
+		DirectX::XMFLOAT3 attr[8]; ///< z, 1/w, u/w, v/w, r/w, g/w, b/w, a/w ̕ʕ.
+		int32_t minX, minY, maxX, maxY; ///< sNZPʂ̊Oڋ`(maxX, maxY܂܂Ȃ).
+		const Image* texture;
+	};
+
+	DrawParameters SetupDraw(const Cell* cellList, const Image& texture, const DirectX::XMFLOAT4X4& matViewProjection) const;
+	bool Draw(const DrawParameters& param, const Sprite& sprite);
+	bool AddQuad(const DrawParameters& param, const Vertex* v);
+	void AddTriangle(const DirectX::XMVECTOR* pos, const Vertex* v, int i0, int i1, int i2, const Image* texture);
+	void RasterizeTiles();
+	void RasterizeTile(size_t tileIndex);
+	void WorkerMain(uint64_t startGeneration);
+	void StopWorkers();
+
+	Image image;
+	std::vector<float> depthBuffer;
+	std::vector<Triangle> triangleList;
+	std::vector<std::vector<uint32_t>> binList;
+	std::vector<const Image*> textureList; ///< ohIDCfbNXƂeNX`̔z.
+	uint32_t tileCountX;
+	uint32_t tileCountY;
+	size_t maxSpriteCount;
+	size_t spriteCount;
+	int threadCount;
+	bool isDrawing;
+
+	std::vector<std::thread> workerList; ///< X^CYp̃Xbh. ĂяõXbh͊܂܂Ȃ.
+	std::mutex workerMutex;
+	std::condition_variable startCondition; ///< X^CYJn̒ʒmp.
+	std::condition_variable doneCondition; ///< X^CYI̒ʒmp.
+	uint64_t workerGeneration; ///< End()ĂԂтɑ. Xbh͂̕ωŏJn.
+	size_t busyWorkerCount; ///< X^CỸXbh.
+	bool isWorkerQuit; ///< trueȂXbhI.
+	std::atomic<size_t> nextTile; ///< ɃX^CY^C̃CfbNX.
+};
+
+} // namespace Sprite
+
+#endif // DX12TUTORIAL_SRC_SOFTWARERENDERER_H_
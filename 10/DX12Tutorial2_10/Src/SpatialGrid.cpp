@@ -24,6 +24,8 @@ Entity::Entity(uint16_t gid, const AnimationList& al, const XMFLOAT3& p, const C
 	Sprite::Sprite(al, p),
 	groupId(gid),
 	hasRemoveRequest(false),
+	useSweep(false),
+	prevPos(p.x, p.y),
 	shape(s)
 {
 }
@@ -35,6 +37,7 @@ Entity::Entity(uint16_t gid, const AnimationList& al, const XMFLOAT3& p, const C
 */
 void Entity::Update(double delta)
 {
+	ResetPrevPos();
 	Sprite::Update(delta);
 	actControllerB.Update(*this, delta);
 	if (updateFunc) {
@@ -69,6 +72,7 @@ void World::SetWorldSize(const XMFLOAT2& world, const XMUINT2& grid, size_t enti
 	gridCount = grid;
 	reciprocalGridSize = XMVectorSwizzle<0, 1, 0, 1>(XMVectorReciprocal(worldSize) * XMLoadUInt2(&gridCount));
 	entityBuffer.reserve(entityCount);
+	animationSystem.Reserve(entityCount);
 	activeList.reserve(entityCount);
 	freeList.reserve(entityCount);
 }
@@ -126,6 +130,7 @@ Entity* World::AddEntity(uint16_t groupId, const AnimationList& al, const XMFLOA
 		freeList.pop_back();
 		*p = Entity(groupId, al, pos, s);
 	}
+	animationSystem.Attach(static_cast<uint32_t>(p - entityBuffer.data()), p->animeController);
 	activeList.push_back(p);
 	return p;
 }
@@ -137,6 +142,7 @@ void World::RemoveEntity()
 {
 	for (Entity* e : activeList) {
 		if (e->HasRemoveRequest()) {
+			animationSystem.Detach(static_cast<uint32_t>(e - entityBuffer.data()), e->animeController);
 			freeList.push_back(e);
 		}
 	}
@@ -158,6 +164,7 @@ void World::Update(double delta)
 	PopulateGrid(gridList);
 	QueryCollision(gridList);
 	RemoveEntity();
+	animationSystem.Update(delta);
 	for (Entity* e : activeList) {
 		e->Update(delta);
 	}
@@ -166,6 +173,8 @@ void World::Update(double delta)
 /**
 * iqԂɃGeBeB֘At.
 *
+* UseSweep(true)ݒ肵GeBeB́AO̍XVsO̍W猻݂̍W܂ł̈ړ͈͂܂AABBŊ֘At.
+*
 * @param gridList GeBeB֘Atiq.
 */
 void World::PopulateGrid(GridList& gridList)
@@ -175,7 +184,11 @@ void World::PopulateGrid(GridList& gridList)
 		if (!e || e->HasRemoveRequest()) {
 			continue;
 		}
-		const XMVECTOR aabb = e->Shape().Aabb(e->pos.x, e->pos.y);
+		XMVECTOR aabb = e->Shape().Aabb(e->pos.x, e->pos.y);
+		if (e->IsSweepEnabled()) {
+			const XMVECTOR prevAabb = e->Shape().Aabb(e->PrevPos().x, e->PrevPos().y);
+			aabb = XMVectorSelect(XMVectorMin(aabb, prevAabb), XMVectorMax(aabb, prevAabb), XMVectorSelectControl(0, 0, 1, 1));
+		}
 		const XMVECTOR ltlt = XMVectorPermute<0, 1, 4, 5>(worldSize, aabb);
 		const XMVECTOR rbrb = XMVectorPermute<6, 7, 2, 3>(worldSize, aabb);
 		uint32_t result = 0;
@@ -196,6 +209,9 @@ void World::PopulateGrid(GridList& gridList)
 /**
 * Փ˂Ɖ.
 *
+* ǂ炩̃GeBeBUseSweep(true)ݒ肵ĂꍇA
+* ̃GeBeBO̍XVœɈړ̂ƂāAړ̏Փ˂𔻒肷.
+*
 * @param gridList Ɖiq.
 */
 void World::QueryCollision(GridList& gridList)
@@ -228,7 +244,15 @@ void World::QueryCollision(GridList& gridList)
 				if (itrHandler == handlerList.end()) {
 					continue;
 				}
-				if (Collision::IsCollision(entityL.Shape(), posL, entityR.Shape(), { entityR.pos.x, entityR.pos.y })) {
+				const XMFLOAT2 posR = { entityR.pos.x, entityR.pos.y };
+				bool isHit;
+				if (entityL.IsSweepEnabled() || entityR.IsSweepEnabled()) {
+					float toi;
+					isHit = Collision::SweepCollision(entityL.Shape(), entityL.PrevPos(), posL, entityR.Shape(), entityR.PrevPos(), posR, toi);
+				} else {
+					isHit = Collision::IsCollision(entityL.Shape(), posL, entityR.Shape(), posR);
+				}
+				if (isHit) {
 					itrHandler->second(**itrL, **itrR);
 				}
 			}
@@ -3,7 +3,7 @@
 */
 #ifndef DX12TUTORIAL_SRC_SPATIALGRID_H_
 #define DX12TUTORIAL_SRC_SPATIALGRID_H_
-#include "Sprite.h"
+#include "SpriteCore.h"
 #include "Collision.h"
 #include <DirectXMath.h>
 #include <unordered_map>
@@ -34,11 +34,17 @@ public:
 	void SetShape(const Collision::Shape& s) { shape = s; }
 	void RequestRemove() { hasRemoveRequest = true; }
 	UpdateFuncType SetUpdateFunc(UpdateFuncType func);
+	void UseSweep(bool b) { useSweep = b; }
+	bool IsSweepEnabled() const { return useSweep; }
+	const DirectX::XMFLOAT2& PrevPos() const { return prevPos; }
+	void ResetPrevPos() { prevPos = DirectX::XMFLOAT2(pos.x, pos.y); }
 
 	int actId = -1;
 private:
 	uint16_t groupId;
 	bool hasRemoveRequest;
+	bool useSweep; ///< trueȂAO̍XVł̈ړ͈͑ŜŏՓ˔s.
+	DirectX::XMFLOAT2 prevPos; ///< O̍XVsO̍W.
 	Collision::Shape shape;
 	UpdateFuncType updateFunc;
 };
@@ -113,6 +119,7 @@ private:
 	DirectX::XMVECTOR worldSize;
 	DirectX::XMVECTOR reciprocalGridSize;
 	DirectX::XMUINT2 gridCount;
+	AnimationSystem animationSystem; ///< entityBufferƓтŃAj[VǗ. entityBufferɔj邽߁Aɐ錾.
 	std::vector<Entity> entityBuffer;
 	EntityPtrVector freeList;
 	EntityPtrVector activeList;
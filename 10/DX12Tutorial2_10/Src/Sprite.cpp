@@ -9,117 +9,114 @@
 #include "d3dx12.h"
 #include <d3dcommon.h>
 #include <algorithm>
+#include <string.h>
+#include <stdio.h>
 
 using Microsoft::WRL::ComPtr;
 using namespace DirectX;
 
 namespace Sprite {
 
-/**
-* XvCg`p_f[^^.
-*/
-struct Vertex {
-	XMFLOAT3 position;
-	XMFLOAT4 color;
-	XMFLOAT2 texcoord;
-};
-
 namespace /* unnamed */ {
 
-XMFLOAT3 RotateZ(XMVECTOR c, float x, float y, float r)
-{
-	float fs, fc;
-	XMScalarSinCos(&fs, &fc, r);
-	const float rx = fc * x + fs * y;
-	const float ry = -fs * x + fc * y;
-	const XMVECTORF32 tmp{ rx, ry, 0.0f, 0.0f };
-	XMFLOAT3 ret;
-	XMStoreFloat3(&ret, XMVectorAdd(c, tmp));
-	return ret;
-}
-
 /**
-* ЂƂ̃XvCgf[^𒸓_obt@ɐݒ.
+* [xlȌɕ24bit̐ɕϊ.
 *
-* @param sprite XvCgf[^.
-* @param v      _f[^`ރAhX.
-* @param offset XN[W.
+* _̃rbg\A召֌WۂȂɕϊĂ甽].
+*
+* @param z [xl.
+*
+* @return \[gp̐[xL[.
 */
-void AddVertex(const Sprite& sprite, const Cell* cell, const AnimationData& anm, Vertex* v, XMFLOAT2 offset)
+uint64_t ToDepthKey(float z)
 {
-	const XMVECTORF32 center{ offset.x + sprite.pos.x, offset.y - sprite.pos.y, sprite.pos.z, 0.0f };
-	const XMFLOAT2 halfSize{ cell->ssize.x * 0.5f * sprite.scale.x * anm.scale.x, cell->ssize.y * 0.5f * sprite.scale.y * anm.scale.y };
-
-	const XMVECTOR vcolor = XMVectorMultiply(XMLoadFloat4(&sprite.color), XMLoadFloat4(&anm.color));
-	for (int i = 0; i < 4; ++i) {
-		XMStoreFloat4(&v[i].color, vcolor);
-	}
-	const float rot = sprite.rotation + anm.rotation;
-	v[0].position = RotateZ(center, -halfSize.x, halfSize.y, rot);
-	v[0].texcoord.x = cell->uv.x;
-	v[0].texcoord.y = cell->uv.y;
-
-	v[1].position = RotateZ(center, halfSize.x, halfSize.y, rot);
-	v[1].texcoord.x = cell->uv.x + cell->tsize.x;
-	v[1].texcoord.y = cell->uv.y;
-
-	v[2].position = RotateZ(center, halfSize.x, -halfSize.y, rot);
-	v[2].texcoord.x = cell->uv.x + cell->tsize.x;
-	v[2].texcoord.y = cell->uv.y + cell->tsize.y;
-
-	v[3].position = RotateZ(center, -halfSize.x, -halfSize.y, rot);
-	v[3].texcoord.x = cell->uv.x;
-	v[3].texcoord.y = cell->uv.y + cell->tsize.y;
+	uint32_t bits;
+	memcpy(&bits, &z, sizeof(bits));
+	bits = (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+	return (~bits >> 8) & 0xffffff;
 }
 
-} // unnamed namedpace
-
 /**
-* RXgN^.
+* L[̏Ɋ\[g.
+*
+* 8bit8̈ȕzs. ׂĂ̗vfŒl͔΂.
+* בւʂlistɊi[.
 *
-* @param p  XvCg̍W.
-* @param rot ](WA).
-* @param s   g嗦.
-* @param col \F.
+* @param list    \[gz. keyo.
+* @param scratch Ɨpz. Ăяo܂Ŏg񂷂ƂŁAmۂ.
 */
-Sprite::Sprite(XMFLOAT3 p, float rot, XMFLOAT2 s, XMFLOAT4 col) :
-	animeController(),
-	actController(),
-	collisionId(-1),
-	pos(p),
-	rotation(rot),
-	scale(s),
-	color(col)
+template<typename T>
+void RadixSort(std::vector<T>& list, std::vector<T>& scratch)
 {
+	const size_t n = list.size();
+	if (n < 2) {
+		return;
+	}
+	scratch.resize(n);
+	size_t histogram[8][256] = {};
+	for (const T& e : list) {
+		for (int digit = 0; digit < 8; ++digit) {
+			++histogram[digit][(e.key >> (digit * 8)) & 0xff];
+		}
+	}
+	T* src = list.data();
+	T* dst = scratch.data();
+	for (int digit = 0; digit < 8; ++digit) {
+		const int shift = digit * 8;
+		size_t* count = histogram[digit];
+		if (count[(src[0].key >> shift) & 0xff] == n) {
+			continue;
+		}
+		size_t offset = 0;
+		for (int i = 0; i < 256; ++i) {
+			const size_t tmp = count[i];
+			count[i] = offset;
+			offset += tmp;
+		}
+		for (const T* e = src; e != src + n; ++e) {
+			dst[count[(e->key >> shift) & 0xff]++] = *e;
+		}
+		std::swap(src, dst);
+	}
+	if (src != list.data()) {
+		list.swap(scratch);
+	}
 }
 
 /**
-* RXgN^.
+* R}hXg[ɋL^ꂽ`Ԃ`ɔf.
+*
+* VUO`̓r[|[gƓ͈͂ɐݒ肷.
 *
-* @param al Aj[VXg.
-* @param p  XvCg̍W.
-* @param rot ](WA).
-* @param s   g嗦.
-* @param col \F.
+* @param info  f̕`.
+* @param state L^ꂽ`.
 */
-Sprite::Sprite(const AnimationList& al, DirectX::XMFLOAT3 p, float rot, DirectX::XMFLOAT2 s, DirectX::XMFLOAT4 col) :
-	animeController(&al),
-	actController(),
-	collisionId(-1),
-	pos(p),
-	rotation(rot),
-	scale(s),
-	color(col)
+void ApplyStreamState(RenderingInfo& info, const StreamState& state)
 {
+	info.matViewProjection = state.matViewProjection;
+	info.viewport.TopLeftX = state.viewport.x;
+	info.viewport.TopLeftY = state.viewport.y;
+	info.viewport.Width = state.viewport.z;
+	info.viewport.Height = state.viewport.w;
+	info.scissorRect.left = static_cast<LONG>(state.viewport.x);
+	info.scissorRect.top = static_cast<LONG>(state.viewport.y);
+	info.scissorRect.right = static_cast<LONG>(state.viewport.x + state.viewport.z);
+	info.scissorRect.bottom = static_cast<LONG>(state.viewport.y + state.viewport.w);
 }
 
+} // unnamed namedpace
+
 /**
 * RXgN^.
 */
 Renderer::Renderer() :
 	maxSpriteCount(0),
 	frameBufferCount(0),
-	currentFrameIndex(-1)
+	currentFrameIndex(-1),
+	captureStream(nullptr),
+	hasDefaultInfo(false),
+	isSortEnabled(false),
+	sortLayer(0)
 {
 }
 
@@ -310,6 +307,8 @@ bool Renderer::Begin(int frameIndex)
 
 	currentFrameIndex = frameIndex;
 	spriteCount = 0;
+	sortStateList.clear();
+	sortEntryList.clear();
 	return true;
 }
 
@@ -333,7 +332,13 @@ bool Renderer::Draw(const std::vector<Sprite>& spriteList, const Cell* cellList,
 }
 
 /**
+* `\ȏԂׂ.
 *
+* @param bundleId `ɎgpohID.
+*
+* @retval true  `\.
+* @retval false bundleIdABegin()Ă΂ĂȂA܂
+*               \[gp̕`񂪃L[Ɋi[ł鐔(16bit)𒴂.
 */
 bool Renderer::IsValidDrawStatus(const BundleId& bundleId)
 {
@@ -343,6 +348,9 @@ bool Renderer::IsValidDrawStatus(const BundleId& bundleId)
 	if (currentFrameIndex < 0) {
 		return false;
 	}
+	if (isSortEnabled && sortStateList.size() > 0xffff) {
+		return false;
+	}
 	return true;
 }
 
@@ -356,6 +364,61 @@ bool Renderer::IsValidDrawStatus(const BundleId& bundleId)
 * @return `惋[vpp[^.
 */
 Renderer::DrawParamters Renderer::SetupDraw(const Cell* cellList, const BundleId& bundleId, RenderingInfo& info)
+{
+	FrameResource& fr = frameResourceList[currentFrameIndex];
+	uint32_t sortStateIndex = 0;
+	if (isSortEnabled) {
+		sortStateIndex = FindSortState(bundleId, info);
+	} else {
+		BindDrawState(bundleId, info);
+	}
+
+	return DrawParamters{
+		info,
+		bundleId,
+		cellList,
+		nullptr,
+		nullptr,
+		{ -(info.viewport.Width * 0.5f), info.viewport.Height * 0.5f },
+		(fr.vertexBufferView.SizeInBytes / fr.vertexBufferView.StrideInBytes / 4) - spriteCount,
+		0,
+		GetVertexPointer(spriteCount),
+		sortStateIndex
+	};
+}
+
+/**
+* \[gp̕`.
+*
+* ohƕ`̓êo^ς݂Ȃ炻̃CfbNXԂAȂΒǉ.
+* Draw()̌ĂяoƂɕʂ̃CfbNX蓖ĂƁAeł`܂Ƃ߂Ȃ.
+*
+* @param bundleId `ɎgpohID.
+* @param info     `.
+*
+* @return sortStateList̃CfbNX.
+*/
+uint32_t Renderer::FindSortState(const BundleId& bundleId, const RenderingInfo& info)
+{
+	// 1t[̕`̎ނ͏Ȃ̂ŁA`T.
+	// RenderingInfo̓pfBOȂ߁AmemcmpŔrł.
+	for (size_t i = sortStateList.size(); i > 0; --i) {
+		const SortState& e = sortStateList[i - 1];
+		if (*e.bundleId == *bundleId && memcmp(&e.info, &info, sizeof(RenderingInfo)) == 0) {
+			return static_cast<uint32_t>(i - 1);
+		}
+	}
+	sortStateList.push_back({ info, bundleId });
+	return static_cast<uint32_t>(sortStateList.size() - 1);
+}
+
+/**
+* `ɕKvȃXe[gR}hXgɐݒ肷.
+*
+* @param bundleId `ɎgpohID.
+* @param info     `.
+*/
+void Renderer::BindDrawState(const BundleId& bundleId, const RenderingInfo& info)
 {
 	FrameResource& fr = frameResourceList[currentFrameIndex];
 	ID3D12DescriptorHeap* heapList[] = { info.texDescHeap };
@@ -366,15 +429,28 @@ Renderer::DrawParamters Renderer::SetupDraw(const Cell* cellList, const BundleId
 	commandList->OMSetRenderTargets(1, &info.rtvHandle, FALSE, &info.dsvHandle);
 	commandList->RSSetViewports(1, &info.viewport);
 	commandList->RSSetScissorRects(1, &info.scissorRect);
+}
 
-	return DrawParamters{
-		info,
-		cellList,
-		{ -(info.viewport.Width * 0.5f), info.viewport.Height * 0.5f },
-		(fr.vertexBufferView.SizeInBytes / fr.vertexBufferView.StrideInBytes / 4) - spriteCount,
-		0,
-		static_cast<Vertex*>(fr.vertexBufferGPUAddress) + (spriteCount * 4)
-	};
+/**
+* _f[^̏ݐ擾.
+*
+* \[gLȏꍇ̓\[gO̒_f[^AL^͋L^p̒_f[^A
+* ǂłȂΕ`pobt@w.
+* `pobt@CPU̓ǂݏox߁AœǂݕԂꍇCPŨɏ.
+*
+* @param spriteIndex ̃t[ŉԖڂ̃XvCg.
+*
+* @return spriteIndexԖڂ̃XvCg̍ŏ̒_ւ̃|C^.
+*/
+Vertex* Renderer::GetVertexPointer(size_t spriteIndex)
+{
+	if (isSortEnabled) {
+		return sortVertexList.data() + (spriteIndex * 4);
+	}
+	if (captureStream) {
+		return captureVertexList.data() + (spriteIndex * 4);
+	}
+	return static_cast<Vertex*>(frameResourceList[currentFrameIndex].vertexBufferGPUAddress) + (spriteIndex * 4);
 }
 
 /**
@@ -391,8 +467,22 @@ bool Renderer::Draw(DrawParamters& param, const Sprite& sprite)
 	if (sprite.scale.x == 0 || sprite.scale.y == 0) {
 		return true;
 	}
-	const Cell* cell = param.cellList + sprite.GetCellIndex();
-	AddVertex(sprite, cell, sprite.animeController.GetData(), param.v, param.offset);
+	const uint32_t cellIndex = sprite.GetCellIndex();
+	if (param.meshList && !param.meshList[cellIndex].isRect) {
+		// ؂l߂`́AXvCg3̎lp`Ƃĕ`悷.
+		if (param.numSprite + CellMesh::quadCount > param.remainingSprite) {
+			return false;
+		}
+		AddVertex(sprite, param.cellList + cellIndex, param.meshList[cellIndex], sprite.animeController.GetData(), param.v, param.offset);
+		param.numSprite += CellMesh::quadCount;
+		param.v += CellMesh::quadCount * 4;
+		return true;
+	}
+	if (param.quadList) {
+		AddVertex(sprite, param.quadList[cellIndex], sprite.animeController.GetData(), param.v, param.offset);
+	} else {
+		AddVertex(sprite, param.cellList + cellIndex, sprite.animeController.GetData(), param.v, param.offset);
+	}
 	++param.numSprite;
 	if (param.numSprite >= param.remainingSprite) {
 		return false;
@@ -408,12 +498,45 @@ bool Renderer::Draw(DrawParamters& param, const Sprite& sprite)
 */
 void Renderer::TeardownDraw(const DrawParamters& param)
 {
-	commandList->DrawIndexedInstanced(param.numSprite * 6, 1, 0, spriteCount * 4, 0);
+	if (isSortEnabled) {
+		// `End()Ń\[gĂ܂Ƃ߂čs.
+		const uint64_t state = (static_cast<uint64_t>(*param.bundleId & 0xffff) << 16) | (param.sortStateIndex & 0xffff);
+		const uint64_t layer = static_cast<uint64_t>(sortLayer) << 56;
+		const Vertex* v = GetVertexPointer(spriteCount);
+		for (size_t i = 0; i < param.numSprite; ++i, v += 4) {
+			const uint64_t depth = ToDepthKey(v->position.z) << 32;
+			sortEntryList.push_back({ layer | depth | state, static_cast<uint32_t>(spriteCount + i) });
+		}
+	} else {
+		if (captureStream) {
+			// L^͒_f[^CPŨɏł̂ŁA`pobt@ɓ].
+			const Vertex* v = GetVertexPointer(spriteCount);
+			std::copy(v, v + param.numSprite * 4, static_cast<Vertex*>(frameResourceList[currentFrameIndex].vertexBufferGPUAddress) + (spriteCount * 4));
+		}
+		commandList->DrawIndexedInstanced(param.numSprite * 6, 1, 0, spriteCount * 4, 0);
+	}
+	if (captureStream && param.numSprite) {
+		// _f[^CPŨ(\[gp܂͋L^p)ɂ̂ŁA`pobt@ǂݖ߂ɋL^ł.
+		const Vertex* v = GetVertexPointer(spriteCount);
+		const D3D12_VIEWPORT& vp = param.info.viewport;
+		captureStream->SetState({ param.info.matViewProjection, DirectX::XMFLOAT4(vp.TopLeftX, vp.TopLeftY, vp.Width, vp.Height) });
+		captureStream->BindBundle(param.bundleId);
+		captureStream->Draw(v, v + param.numSprite * 4);
+	}
 	spriteCount += param.numSprite;
 }
 
 /**
+* XvCg`.
 *
+* @param first    `悷XvCg̐擪.
+* @param last     `悷XvCg̏I[.
+* @param cellList `ɎgpZXg.
+* @param bundleId `ɎgpohID.
+* @param info     `.
+*
+* @retval true  R}hXg쐬.
+* @retval false R}hXg쐬s.
 */
 bool Renderer::Draw(const Sprite* first, const Sprite* last, const Cell* cellList, const BundleId& bundleId, RenderingInfo& info)
 {
@@ -433,6 +556,253 @@ bool Renderer::Draw(const Sprite* first, const Sprite* last, const Cell* cellLis
 	return true;
 }
 
+/**
+* 쐬ς݂̒_f[^`悷.
+*
+* _f[^̓XvCg1ɂ4_ŁAAddVertex()Ɠтł邱.
+* _f[^͕`pobt@ɂ̂܂܃Rs[.
+*
+* @param first    `悷钸_f[^̐擪.
+* @param last     `悷钸_f[^̏I[.
+* @param bundleId `ɎgpohID.
+* @param info     `.
+*
+* @retval true  R}hXg쐬.
+* @retval false R}hXg쐬s.
+*/
+bool Renderer::Draw(const Vertex* first, const Vertex* last, const BundleId& bundleId, RenderingInfo& info)
+{
+	if (!IsValidDrawStatus(bundleId)) {
+		return false;
+	}
+	const size_t numSprite = static_cast<size_t>(last - first) / 4;
+	if (numSprite == 0) {
+		return true;
+	}
+	DrawParamters param = SetupDraw(nullptr, bundleId, info);
+	param.numSprite = std::min(numSprite, param.remainingSprite);
+	std::copy(first, first + param.numSprite * 4, param.v);
+	TeardownDraw(param);
+	return true;
+}
+
+/**
+* R}hXg[̋L^eR}hXgɕϊ.
+*
+* _f[^̓Xg[Ŝ܂Ƃ߂1x`pobt@ɃRs[A
+* `R}hƂɂ͈̔͂`悷.
+* `pobt@ɓ肫Ȃ_f[^͕`悳Ȃ.
+*
+* ̃Xg[`悷ꍇ́A`悵Ԃɂ̊֐Ăяo.
+*
+* @param stream ϊR}hXg[.
+* @param info   `. WϊsAr[|[gAVUO`̓Xg[ɋL^ꂽlŏ㏑.
+*
+* @retval true  R}hXg쐬.
+* @retval false R}hXg쐬s.
+*/
+bool Renderer::Submit(const CommandStream& stream, RenderingInfo& info)
+{
+	if (currentFrameIndex < 0) {
+		return false;
+	}
+	if (isSortEnabled || captureStream) {
+		// \[gLȏꍇ͂ق̕`ƍĕבւ邽߁AL^͋L^Ɏc߂Draw()oR.
+		RenderingInfo current = info;
+		const BundleId* bundleId = nullptr;
+		const Vertex* v = stream.GetVertexList().data();
+		for (const Command& cmd : stream.GetCommandList()) {
+			switch (cmd.type) {
+			case CommandType::SetState: {
+				const StreamState& state = stream.GetStateList()[cmd.index];
+				ApplyStreamState(current, state);
+				break;
+			}
+			case CommandType::BindBundle:
+				bundleId = &stream.GetBundleList()[cmd.index];
+				break;
+			case CommandType::Draw:
+				if (!bundleId || !Draw(v + cmd.first, v + cmd.first + cmd.count, *bundleId, current)) {
+					return false;
+				}
+				break;
+			}
+		}
+		return true;
+	}
+	const std::vector<Vertex>& vertexList = stream.GetVertexList();
+	FrameResource& fr = frameResourceList[currentFrameIndex];
+	const size_t remainingSprite = (fr.vertexBufferView.SizeInBytes / fr.vertexBufferView.StrideInBytes / 4) - spriteCount;
+	const size_t numSprite = std::min(vertexList.size() / 4, remainingSprite);
+	if (numSprite == 0) {
+		return true;
+	}
+	const size_t baseSprite = spriteCount;
+	std::copy(vertexList.begin(), vertexList.begin() + numSprite * 4, static_cast<Vertex*>(fr.vertexBufferGPUAddress) + (baseSprite * 4));
+	spriteCount += static_cast<int>(numSprite);
+
+	RenderingInfo current = info;
+	const BundleId* bundleId = nullptr;
+	bool isDirty = true;
+	for (const Command& cmd : stream.GetCommandList()) {
+		switch (cmd.type) {
+		case CommandType::SetState: {
+			const StreamState& state = stream.GetStateList()[cmd.index];
+			ApplyStreamState(current, state);
+			isDirty = true;
+			break;
+		}
+		case CommandType::BindBundle:
+			bundleId = &stream.GetBundleList()[cmd.index];
+			if (!IsValidDrawStatus(*bundleId)) {
+				return false;
+			}
+			isDirty = true;
+			break;
+		case CommandType::Draw: {
+			if (!bundleId) {
+				return false;
+			}
+			const size_t first = cmd.first / 4;
+			if (first >= numSprite) {
+				return true;
+			}
+			const size_t count = std::min<size_t>(cmd.count / 4, numSprite - first);
+			if (isDirty) {
+				SetupDraw(nullptr, *bundleId, current);
+				isDirty = false;
+			}
+			commandList->DrawIndexedInstanced(static_cast<UINT>(count * 6), 1, 0, static_cast<INT>((baseSprite + first) * 4), 0);
+			break;
+		}
+		}
+	}
+	return true;
+}
+
+/**
+* R}hXg[̋L^eASetRenderingInfo()Őݒ肵`ɕ`悷.
+*
+* @param stream ϊR}hXg[.
+*
+* @retval true  R}hXg쐬.
+* @retval false `񂪐ݒ肳ĂȂA܂̓R}hXg쐬s.
+*/
+bool Renderer::Submit(const CommandStream& stream)
+{
+	if (!hasDefaultInfo) {
+		return false;
+	}
+	RenderingInfo info = defaultInfo;
+	return Submit(stream, info);
+}
+
+/**
+* `w肵ȂSubmit()Ŏg`ݒ肷.
+*
+* @param info `.
+*/
+void Renderer::SetRenderingInfo(const RenderingInfo& info)
+{
+	defaultInfo = info;
+	hasDefaultInfo = true;
+}
+
+/**
+* `e̋L^Jn.
+*
+* L^Draw()ŕ`悵éA_f[^streamɂL^.
+* L^eSubmit()ōĕ`ł̂ŁAωȂʂ𖈃t[蒼ɍς.
+* Submit()ŕ`悵Xg[̓eL^.
+*
+* @param stream L^̃R}hXg[.
+*/
+void Renderer::BeginCapture(CommandStream* stream)
+{
+	captureStream = stream;
+	if (captureStream) {
+		captureVertexList.resize(maxSpriteCount);
+	}
+}
+
+/**
+* `e̋L^I.
+*/
+void Renderer::EndCapture()
+{
+	captureStream = nullptr;
+}
+
+/**
+* XvCg̃\[gL܂͖ɂ.
+*
+* \[gLȏꍇADraw()̓XvCg𑦍ɕ`悹ɋL^sA
+* End()Ńt[̑SXvCg܂Ƃ߂ă\[gĂ`悷.
+* \[g̓C[A[x(O)AohA`̏ŁA
+* ̃XvCg`Ăяo܂ŐdȂAeNX`̃XvCg܂Ƃ߂ĕ`悳.
+* L[ׂēXvCg͕`悵Ԃێ.
+*
+* Begin()End()̊Ԃ͕ύXłȂ.
+*
+* @param enable true=\[gLɂ. false=ɂ.
+*
+* @retval true  ύX.
+* @retval false `撆̂ߕύXłȂ.
+*/
+bool Renderer::EnableSort(bool enable)
+{
+	if (currentFrameIndex >= 0) {
+		return false;
+	}
+	isSortEnabled = enable;
+	if (enable) {
+		sortVertexList.resize(maxSpriteCount);
+	} else {
+		sortVertexList.clear();
+		sortVertexList.shrink_to_fit();
+	}
+	return true;
+}
+
+/**
+* L^XvCg\[gĕ`悷.
+*
+* C[A[x(O)AohA`̏ɃL[\[gA
+* בւ_f[^`pobt@ɃRs[.
+* ̌A`񂪓XvCgA͈͂Ƃ1񂸂`R}h𔭍s.
+* `FindSortState()œeƂɂ܂Ƃ߂Ă邽߁A
+* ʂDraw()œo^XvCgłeȂ1̕`R}hŕ`悳.
+*/
+void Renderer::FlushSortedSprites()
+{
+	if (sortEntryList.empty()) {
+		return;
+	}
+	RadixSort(sortEntryList, sortScratch);
+
+	Vertex* dst = static_cast<Vertex*>(frameResourceList[currentFrameIndex].vertexBufferGPUAddress);
+	for (const SortEntry& e : sortEntryList) {
+		const Vertex* src = sortVertexList.data() + (e.index * 4);
+		std::copy(src, src + 4, dst);
+		dst += 4;
+	}
+
+	const size_t n = sortEntryList.size();
+	size_t first = 0;
+	while (first < n) {
+		const uint64_t state = sortEntryList[first].key & 0xffff;
+		size_t last = first + 1;
+		while (last < n && (sortEntryList[last].key & 0xffff) == state) {
+			++last;
+		}
+		const SortState& s = sortStateList[static_cast<size_t>(state)];
+		BindDrawState(s.bundleId, s.info);
+		commandList->DrawIndexedInstanced(static_cast<UINT>((last - first) * 6), 1, 0, static_cast<INT>(first * 4), 0);
+		first = last;
+	}
+	sortEntryList.clear();
+}
+
 /**
 * XvCg̕`I.
 *
@@ -444,6 +814,9 @@ bool Renderer::End()
 	if (currentFrameIndex < 0) {
 		return false;
 	}
+	if (isSortEnabled) {
+		FlushSortedSprites();
+	}
 	currentFrameIndex = -1;
 	if (FAILED(commandList->Close())) {
 		return false;
@@ -461,6 +834,71 @@ ID3D12GraphicsCommandList* Renderer::GetCommandList()
 	return commandList.Get();
 }
 
+#ifdef SPRITE_ENABLE_SORT_BENCHMARK
+/**
+* XvCg̃\[gɂ鎞ԂƁA\[g̕`R}hv.
+*
+* Renderer::TeardownDraw()Ɠ`̃L[vf𗐐ō쐬A
+* \[gstd::stable_sortłꂼrepeat񂸂בւ.
+*
+* @param spriteCount XvCg̐. 10000`100000xz.
+* @param stateCount  `̎. 1`65536.
+* @param repeat      JԂ.
+* @param radixTime   \[g1񂠂̏(~b)i[ϐ.
+* @param stdTime     std::stable_sort1񂠂̏(~b)i[ϐ.
+* @param drawCount   \[g̕`R}hi[ϐ.
+*/
+void BenchmarkSort(size_t spriteCount, size_t stateCount, int repeat, double& radixTime, double& stdTime, size_t& drawCount)
+{
+	struct Entry {
+		uint64_t key;
+		uint32_t index;
+	};
+	std::vector<Entry> source(spriteCount);
+	uint32_t seed = 2463534242;
+	for (size_t i = 0; i < spriteCount; ++i) {
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		const uint64_t layer = static_cast<uint64_t>(seed & 3) << 56;
+		const uint64_t depth = ToDepthKey(static_cast<float>(seed % 1000)) << 32;
+		const uint64_t state = ((seed >> 10) % stateCount) & 0xffff;
+		source[i] = { layer | depth | (state << 16) | state, static_cast<uint32_t>(i) };
+	}
+	std::vector<Entry> list;
+	std::vector<Entry> scratch;
+
+	LARGE_INTEGER freq, t0, t1, t2;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&t0);
+	for (int n = 0; n < repeat; ++n) {
+		list = source;
+		RadixSort(list, scratch);
+	}
+	QueryPerformanceCounter(&t1);
+	for (int n = 0; n < repeat; ++n) {
+		list = source;
+		std::stable_sort(list.begin(), list.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.key < rhs.key; });
+	}
+	QueryPerformanceCounter(&t2);
+	const double toMs = 1000.0 / static_cast<double>(freq.QuadPart) / repeat;
+	radixTime = static_cast<double>(t1.QuadPart - t0.QuadPart) * toMs;
+	stdTime = static_cast<double>(t2.QuadPart - t1.QuadPart) * toMs;
+
+	// FlushSortedSprites()ƓA`񂪕ς邽тɕ`R}h𔭍sƂ݂Ȃ.
+	drawCount = 0;
+	for (size_t i = 0; i < list.size(); ++i) {
+		if (i == 0 || (list[i].key & 0xffff) != (list[i - 1].key & 0xffff)) {
+			++drawCount;
+		}
+	}
+
+	char buf[128];
+	sprintf_s(buf, "Sort(%u sprites, %u states): radix=%.3fms stable_sort=%.3fms draw=%u\n", static_cast<uint32_t>(spriteCount), static_cast<uint32_t>(stateCount), radixTime, stdTime, static_cast<uint32_t>(drawCount));
+	OutputDebugStringA(buf);
+}
+#endif // SPRITE_ENABLE_SORT_BENCHMARK
+
 /**
 * FileC^[tFCX̎NX.
 */
@@ -579,6 +1017,7 @@ FilePtr LoadFromJsonFile(const wchar_t* filename)
 			cell.ssize.y = ssize.size() > 1 ? static_cast<float>(ssize[1].AsNumber()) : 0.0f;
 			al.list.push_back(cell);
 		}
+		BuildQuadTemplate(al);
 		af->clList.push_back(al);
 	}
 
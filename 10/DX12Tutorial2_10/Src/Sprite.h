@@ -3,8 +3,7 @@
 */
 #ifndef DX12TUTORIAL_SRC_SPRITE_H_
 #define DX12TUTORIAL_SRC_SPRITE_H_
-#include "Animation.h"
-#include "Action.h"
+#include "SpriteCore.h"
 #include <d3d12.h>
 #include <DirectXMath.h>
 #include <wrl/client.h>
@@ -19,48 +18,6 @@ struct PSO;
 
 namespace Sprite {
 
-struct Vertex;
-
-/**
-* Zf[^^.
-*/
-struct Cell {
-	DirectX::XMFLOAT2 uv; ///< eNX`̍W.
-	DirectX::XMFLOAT2 tsize; ///< eNX`̏cTCY.
-	DirectX::XMFLOAT2 ssize; ///< XN[W̏cTCY.
-};
-
-/**
-* XvCg.
-*/
-struct Sprite
-{
-	Sprite() = delete;
-	Sprite(DirectX::XMFLOAT3 p, float rot = 0, DirectX::XMFLOAT2 s = DirectX::XMFLOAT2(1, 1), DirectX::XMFLOAT4 col = DirectX::XMFLOAT4(1, 1, 1, 1));
-	Sprite(const AnimationList& al, DirectX::XMFLOAT3 p, float rot = 0, DirectX::XMFLOAT2 s = DirectX::XMFLOAT2(1, 1), DirectX::XMFLOAT4 col = DirectX::XMFLOAT4(1, 1, 1, 1));
-	void SetSeqIndex(uint32_t no) { animeController.SetSeqIndex(no); }
-	void SetActionList(const Action::List* al) { actController.SetList(al); }
-	void SetAction(uint32_t no) { actController.SetSeqIndex(no); }
-	void SetCollisionId(int32_t id) { collisionId = id; }
-	int32_t GetCollisionId() const { return collisionId; }
-	void Update(double delta) {
-		animeController.Update(delta);
-		actController.Update(static_cast<float>(delta), this);
-	}
-	uint32_t GetCellIndex() const { return animeController.GetData().cellIndex; }
-	size_t GetSeqCount() const { return animeController.GetSeqCount(); }
-
-	AnimationController animeController;
-	Action::Controller actController;
-	Action::B::Controller actControllerB;
-	int32_t hp;
-	int32_t collisionId;
-	DirectX::XMFLOAT3 pos; ///< XN[W̃XvCg̈ʒu.
-	float rotation; ///< 摜̉]p(WA).
-	DirectX::XMFLOAT2 scale; ///< 摜̊g嗦.
-	DirectX::XMFLOAT4 color; ///< 摜̐F.
-};
-
 /**
 * XvCg`.
 */
@@ -74,25 +31,28 @@ struct RenderingInfo
 	DirectX::XMFLOAT4X4 matViewProjection; ///< `ɎgpWϊs.
 };
 
-/**
-* ohID.
-*/
-typedef std::shared_ptr<size_t> BundleId;
-
 /**
 * XvCg`NX.
 */
-class Renderer
+class Renderer : public RendererBase
 {
 public:
 	Renderer();
-	~Renderer() = default;
+	virtual ~Renderer() = default;
 	bool Init(Microsoft::WRL::ComPtr<ID3D12Device> device, int numFrameBuffer, int maxSprite, Resource::ResourceLoader& resourceLoader);
 	BundleId CreateBundle(const PSO& pso, ID3D12DescriptorHeap* texDescHeap, const Resource::Texture& texture);
 	bool Begin(int frameIndex);
 	bool Draw(const std::vector<Sprite>& spriteList, const Cell* cellList, const BundleId& bundleId, RenderingInfo& info);
 	bool Draw(const Sprite* first, const Sprite* last, const Cell* cellList, const BundleId& bundleId, RenderingInfo& info);
-	bool End();
+	bool Draw(const Vertex* first, const Vertex* last, const BundleId& bundleId, RenderingInfo& info);
+	bool Submit(const CommandStream& stream, RenderingInfo& info);
+	virtual bool Submit(const CommandStream& stream);
+	void SetRenderingInfo(const RenderingInfo& info);
+	void BeginCapture(CommandStream* stream);
+	void EndCapture();
+	bool EnableSort(bool enable);
+	void SetSortLayer(uint8_t layer) { sortLayer = layer; }
+	virtual bool End();
 	ID3D12GraphicsCommandList* GetCommandList();
 
 	template<typename Iterator>
@@ -114,6 +74,38 @@ public:
 		return true;
 	}
 
+	/**
+	* ZXgw肵ăXvCg`悷.
+	*
+	* ZXg`ĂꍇAZ̓؂l߂`ŕ`悷.
+	* `Ȃꍇ͋`ŕ`悷.
+	* lp`̐`ĂꍇA`̒_f[^͐`쐬.
+	*/
+	template<typename Iterator>
+	bool Draw(Iterator first, Iterator last, const CellList& cellList, const BundleId& bundleId, RenderingInfo& info)
+	{
+		if (!IsValidDrawStatus(bundleId)) {
+			return false;
+		}
+		if (first == last || cellList.list.empty()) {
+			return true;
+		}
+		DrawParamters param = SetupDraw(cellList.list.data(), bundleId, info);
+		if (cellList.meshList.size() >= cellList.list.size()) {
+			param.meshList = cellList.meshList.data();
+		}
+		if (cellList.quadList.size() >= cellList.list.size()) {
+			param.quadList = cellList.quadList.data();
+		}
+		for (Iterator sprite = first; sprite != last; ++sprite) {
+			if (!Draw(param, *sprite)) {
+				break;
+			}
+		}
+		TeardownDraw(param);
+		return true;
+	}
+
 private:
 	void DestroyBundle(size_t bundleId);
 	bool IsValidDrawStatus(const BundleId& bundleId);
@@ -121,15 +113,23 @@ private:
 	/// `p[^.
 	struct DrawParamters {
 		RenderingInfo& info;
+		const BundleId& bundleId;
 		const Cell* cellList;
+		const CellMesh* meshList; ///< nullptrȂ`ŕ`悷. isRecttruě``ŕ`悷.
+		const QuadTemplate* quadList; ///< nullptrȂcellList`쐬.
 		DirectX::XMFLOAT2 offset;
 		size_t remainingSprite;
 		size_t numSprite;
 		Vertex* v;
+		uint32_t sortStateIndex; ///< sortStateList̕`̃CfbNX. \[gLȏꍇg.
 	};
 	DrawParamters SetupDraw(const Cell* cellList, const BundleId& bundleId, RenderingInfo& info);
 	bool Draw(DrawParamters& param, const Sprite& sprite);
 	void TeardownDraw(const DrawParamters& param);
+	void BindDrawState(const BundleId& bundleId, const RenderingInfo& info);
+	Vertex* GetVertexPointer(size_t spriteIndex);
+	uint32_t FindSortState(const BundleId& bundleId, const RenderingInfo& info);
+	void FlushSortedSprites();
 
 	size_t maxSpriteCount;
 	int frameBufferCount;
@@ -144,6 +144,27 @@ private:
 	std::vector<FrameResource> frameResourceList;
 	int currentFrameIndex;
 	int spriteCount;
+	CommandStream* captureStream; ///< `e̋L^. nullptrȂL^Ȃ.
+	RenderingInfo defaultInfo; ///< Submit(stream)Ŏg`.
+	bool hasDefaultInfo; ///< defaultInfoݒ肳Ătrue.
+
+	/// \[gp̕`.
+	struct SortState {
+		RenderingInfo info;
+		BundleId bundleId;
+	};
+	/// \[gp̃L[ƃXvCg̃CfbNX.
+	struct SortEntry {
+		uint64_t key; ///< ʂ烌C[(8bit), [x(24bit), oh(16bit), `(16bit).
+		uint32_t index;
+	};
+	bool isSortEnabled;
+	uint8_t sortLayer;
+	std::vector<SortState> sortStateList;
+	std::vector<SortEntry> sortEntryList;
+	std::vector<SortEntry> sortScratch; ///< \[gƗp. t[g.
+	std::vector<Vertex> sortVertexList; ///< \[gO̒_f[^.
+	std::vector<Vertex> captureVertexList; ///< L^ɏޒ_f[^. TeardownDraw()ŕ`pobt@ɓ].
 
 	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList;
 	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer;
@@ -153,14 +174,10 @@ private:
 	std::vector<Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>> bundleList;
 };
 
-/**
-* Zf[^̔z.
-*/
-struct CellList
-{
-	std::string name; ///< Xg.
-	std::vector<Cell> list; ///< Zf[^̔z.
-};
+//#define SPRITE_ENABLE_SORT_BENCHMARK
+#ifdef SPRITE_ENABLE_SORT_BENCHMARK
+void BenchmarkSort(size_t spriteCount, size_t stateCount, int repeat, double& radixTime, double& stdTime, size_t& drawCount);
+#endif // SPRITE_ENABLE_SORT_BENCHMARK
 
 /**
 * CellList܂Ƃ߂IuWFNg𑀍삷邽߂̃C^[tFCXNX.
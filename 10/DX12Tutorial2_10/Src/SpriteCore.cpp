@@ -0,0 +1,265 @@
+/**
+* @file SpriteCore.cpp
+*
+* XvCg̒_f[^쐬ȂǁAOtBbNXAPIɈˑȂ.
+*/
+#include "SpriteCore.h"
+#ifdef SPRITE_ENABLE_ADDVERTEX_BENCHMARK
+#include "Platform.h"
+#include <stdio.h>
+#endif // SPRITE_ENABLE_ADDVERTEX_BENCHMARK
+
+using namespace DirectX;
+
+namespace Sprite {
+
+namespace /* unnamed */ {
+
+XMFLOAT3 RotateZ(XMVECTOR c, float x, float y, float r)
+{
+	float fs, fc;
+	XMScalarSinCos(&fs, &fc, r);
+	const float rx = fc * x + fs * y;
+	const float ry = -fs * x + fc * y;
+	const XMVECTORF32 tmp{ rx, ry, 0.0f, 0.0f };
+	XMFLOAT3 ret;
+	XMStoreFloat3(&ret, XMVectorAdd(c, tmp));
+	return ret;
+}
+
+} // unnamed namespace
+
+/**
+* ЂƂ̃XvCgf[^𒸓_obt@ɐݒ.
+*
+* @param sprite XvCgf[^.
+* @param cell   XvCgɑΉZf[^.
+* @param anm    XvCg̃Aj[Vf[^.
+* @param v      _f[^`ރAhX.
+* @param offset XN[W.
+*/
+void AddVertex(const Sprite& sprite, const Cell* cell, const AnimationData& anm, Vertex* v, XMFLOAT2 offset)
+{
+	const XMVECTORF32 center{ offset.x + sprite.pos.x, offset.y - sprite.pos.y, sprite.pos.z, 0.0f };
+	const XMFLOAT2 halfSize{ cell->ssize.x * 0.5f * sprite.scale.x * anm.scale.x, cell->ssize.y * 0.5f * sprite.scale.y * anm.scale.y };
+
+	const XMVECTOR vcolor = XMVectorMultiply(XMLoadFloat4(&sprite.color), XMLoadFloat4(&anm.color));
+	for (int i = 0; i < 4; ++i) {
+		XMStoreFloat4(&v[i].color, vcolor);
+	}
+	const float u0 = EncodePaletteTexcoord(cell->uv.x, sprite.paletteIndex);
+	const float u1 = u0 + cell->tsize.x;
+	const float rot = sprite.rotation + anm.rotation;
+	v[0].position = RotateZ(center, -halfSize.x, halfSize.y, rot);
+	v[0].texcoord.x = u0;
+	v[0].texcoord.y = cell->uv.y;
+
+	v[1].position = RotateZ(center, halfSize.x, halfSize.y, rot);
+	v[1].texcoord.x = u1;
+	v[1].texcoord.y = cell->uv.y;
+
+	v[2].position = RotateZ(center, halfSize.x, -halfSize.y, rot);
+	v[2].texcoord.x = u1;
+	v[2].texcoord.y = cell->uv.y + cell->tsize.y;
+
+	v[3].position = RotateZ(center, -halfSize.x, -halfSize.y, rot);
+	v[3].texcoord.x = u0;
+	v[3].texcoord.y = cell->uv.y + cell->tsize.y;
+}
+
+/**
+* lp`̐`găXvCgf[^𒸓_obt@ɐݒ.
+*
+* ŽvZȂA_ƂɊgE]Esړs.
+* ]̎Op֐1񂾂vZ.
+*
+* @param sprite XvCgf[^.
+* @param quad   XvCgɑΉlp`̐`.
+* @param anm    XvCg̃Aj[Vf[^.
+* @param v      _f[^`ރAhX.
+* @param offset XN[W.
+*/
+void AddVertex(const Sprite& sprite, const QuadTemplate& quad, const AnimationData& anm, Vertex* v, XMFLOAT2 offset)
+{
+	const float cx = offset.x + sprite.pos.x;
+	const float cy = offset.y - sprite.pos.y;
+	const float sx = sprite.scale.x * anm.scale.x;
+	const float sy = sprite.scale.y * anm.scale.y;
+	float fs, fc;
+	XMScalarSinCos(&fs, &fc, sprite.rotation + anm.rotation);
+
+	XMFLOAT4 color;
+	XMStoreFloat4(&color, XMVectorMultiply(XMLoadFloat4(&sprite.color), XMLoadFloat4(&anm.color)));
+	for (int i = 0; i < 4; ++i) {
+		const float x = quad.offset[i].x * sx;
+		const float y = quad.offset[i].y * sy;
+		v[i].position = XMFLOAT3(cx + fc * x + fs * y, cy - fs * x + fc * y, sprite.pos.z);
+		v[i].color = color;
+		v[i].texcoord.x = EncodePaletteTexcoord(quad.texcoord[i].x, sprite.paletteIndex);
+		v[i].texcoord.y = quad.texcoord[i].y;
+	}
+}
+
+/**
+* ؂l߂`ŃXvCgf[^𒸓_obt@ɐݒ.
+*
+* _f[^̓XvCg3(CellMesh::quadCount * 4_)܂.
+*
+* @param sprite XvCgf[^.
+* @param cell   XvCgɑΉZf[^.
+* @param mesh   Ž`.
+* @param anm    XvCg̃Aj[Vf[^.
+* @param v      _f[^`ރAhX.
+* @param offset XN[W.
+*/
+void AddVertex(const Sprite& sprite, const Cell* cell, const CellMesh& mesh, const AnimationData& anm, Vertex* v, XMFLOAT2 offset)
+{
+	const XMVECTORF32 center{ offset.x + sprite.pos.x, offset.y - sprite.pos.y, sprite.pos.z, 0.0f };
+	const XMFLOAT2 size{ cell->ssize.x * sprite.scale.x * anm.scale.x, cell->ssize.y * sprite.scale.y * anm.scale.y };
+	const float rot = sprite.rotation + anm.rotation;
+	const float u0 = EncodePaletteTexcoord(cell->uv.x, sprite.paletteIndex);
+
+	Vertex tmp[CellMesh::vertexCount];
+	for (int i = 0; i < CellMesh::vertexCount; ++i) {
+		const XMFLOAT2& p = mesh.vertex[i];
+		tmp[i].position = RotateZ(center, (p.x - 0.5f) * size.x, (0.5f - p.y) * size.y, rot);
+		tmp[i].texcoord.x = u0 + cell->tsize.x * p.x;
+		tmp[i].texcoord.y = cell->uv.y + cell->tsize.y * p.y;
+	}
+	XMStoreFloat4(&tmp[0].color, XMVectorMultiply(XMLoadFloat4(&sprite.color), XMLoadFloat4(&anm.color)));
+	for (int i = 1; i < CellMesh::vertexCount; ++i) {
+		tmp[i].color = tmp[0].color;
+	}
+	for (int quad = 0; quad < CellMesh::quadCount; ++quad) {
+		for (int i = 0; i < 4; ++i) {
+			*v++ = tmp[CellMesh::quadIndex[quad][i]];
+		}
+	}
+}
+
+/**
+* RXgN^.
+*
+* @param p  XvCg̍W.
+* @param rot ](WA).
+* @param s   g嗦.
+* @param col \F.
+*/
+Sprite::Sprite(XMFLOAT3 p, float rot, XMFLOAT2 s, XMFLOAT4 col) :
+	animeController(),
+	actController(),
+	collisionId(-1),
+	pos(p),
+	rotation(rot),
+	scale(s),
+	color(col),
+	paletteIndex(0)
+{
+}
+
+/**
+* RXgN^.
+*
+* @param al Aj[VXg.
+* @param p  XvCg̍W.
+* @param rot ](WA).
+* @param s   g嗦.
+* @param col \F.
+*/
+Sprite::Sprite(const AnimationList& al, DirectX::XMFLOAT3 p, float rot, DirectX::XMFLOAT2 s, DirectX::XMFLOAT4 col) :
+	animeController(&al),
+	actController(),
+	collisionId(-1),
+	pos(p),
+	rotation(rot),
+	scale(s),
+	color(col),
+	paletteIndex(0)
+{
+}
+
+/**
+* ZXg̑SẴZɂĎlp`̐`쐬.
+*
+* LoadFromJsonFile()œǂݍ񂾃ZXgɂ͍쐬ς.
+* Z̓eύXꍇ́Å֐ō蒼.
+*
+* @param cellList `쐬ZXg.
+*/
+void BuildQuadTemplate(CellList& cellList)
+{
+	cellList.quadList.resize(cellList.list.size());
+	for (size_t i = 0; i < cellList.list.size(); ++i) {
+		const Cell& cell = cellList.list[i];
+		QuadTemplate& quad = cellList.quadList[i];
+		const float hx = cell.ssize.x * 0.5f;
+		const float hy = cell.ssize.y * 0.5f;
+		quad.offset[0] = XMFLOAT2(-hx, hy);
+		quad.offset[1] = XMFLOAT2(hx, hy);
+		quad.offset[2] = XMFLOAT2(hx, -hy);
+		quad.offset[3] = XMFLOAT2(-hx, -hy);
+		quad.texcoord[0] = XMFLOAT2(cell.uv.x, cell.uv.y);
+		quad.texcoord[1] = XMFLOAT2(cell.uv.x + cell.tsize.x, cell.uv.y);
+		quad.texcoord[2] = XMFLOAT2(cell.uv.x + cell.tsize.x, cell.uv.y + cell.tsize.y);
+		quad.texcoord[3] = XMFLOAT2(cell.uv.x, cell.uv.y + cell.tsize.y);
+	}
+}
+
+#ifdef SPRITE_ENABLE_ADDVERTEX_BENCHMARK
+/**
+* Z璸_f[^@ƁAlp`̐`@̏Ԃr.
+*
+* ]Ɗg嗦΂΂̃XvCgpӂAꂼ̕@repeat񂸂_f[^쐬.
+*
+* @param spriteCount  XvCg̐.
+* @param repeat       JԂ.
+* @param cellTime     Z쐬ꍇ́A1񂠂̏(~b)i[ϐ.
+* @param templateTime `쐬ꍇ́A1񂠂̏(~b)i[ϐ.
+*/
+void BenchmarkAddVertex(size_t spriteCount, int repeat, double& cellTime, double& templateTime)
+{
+	CellList cellList;
+	for (int i = 0; i < 16; ++i) {
+		cellList.list.push_back(Cell{ XMFLOAT2(i / 16.0f, 0), XMFLOAT2(1 / 16.0f, 1 / 16.0f), XMFLOAT2(32.0f + i, 32.0f) });
+	}
+	BuildQuadTemplate(cellList);
+
+	std::vector<Sprite> spriteList;
+	spriteList.reserve(spriteCount);
+	for (size_t i = 0; i < spriteCount; ++i) {
+		spriteList.push_back(Sprite(XMFLOAT3(static_cast<float>(i % 800), static_cast<float>(i % 600), 0.5f), i * 0.1f, XMFLOAT2(1.0f + (i % 3) * 0.5f, 1.0f)));
+	}
+	std::vector<uint32_t> cellIndexList(spriteCount);
+	for (size_t i = 0; i < spriteCount; ++i) {
+		cellIndexList[i] = static_cast<uint32_t>(i % cellList.list.size());
+	}
+	std::vector<Vertex> vertexList(spriteCount * 4);
+	const AnimationData anm = { 0, 0, 0, XMFLOAT2(1, 1), XMFLOAT4(1, 1, 1, 1) };
+	const XMFLOAT2 offset(-400, 300);
+
+	const int64_t freq = Platform::GetPerformanceFrequency();
+	int64_t t0, t1, t2;
+	t0 = Platform::GetPerformanceCounter();
+	for (int n = 0; n < repeat; ++n) {
+		for (size_t i = 0; i < spriteCount; ++i) {
+			AddVertex(spriteList[i], &cellList.list[cellIndexList[i]], anm, &vertexList[i * 4], offset);
+		}
+	}
+	t1 = Platform::GetPerformanceCounter();
+	for (int n = 0; n < repeat; ++n) {
+		for (size_t i = 0; i < spriteCount; ++i) {
+			AddVertex(spriteList[i], cellList.quadList[cellIndexList[i]], anm, &vertexList[i * 4], offset);
+		}
+	}
+	t2 = Platform::GetPerformanceCounter();
+	const double toMs = 1000.0 / static_cast<double>(freq) / repeat;
+	cellTime = static_cast<double>(t1 - t0) * toMs;
+	templateTime = static_cast<double>(t2 - t1) * toMs;
+
+	char buf[128];
+	snprintf(buf, _countof(buf), "AddVertex(%u sprites): cell=%.3fms template=%.3fms\n", static_cast<uint32_t>(spriteCount), cellTime, templateTime);
+	Platform::DebugOutput(buf);
+}
+#endif // SPRITE_ENABLE_ADDVERTEX_BENCHMARK
+
+} // namespace Sprite
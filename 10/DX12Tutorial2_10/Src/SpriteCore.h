@@ -0,0 +1,98 @@
+/**
+* @file SpriteCore.h
+*
+* XvCgƒ_f[^̍쐬A`NX̋ʃC^[tFCX.
+* OtBbNXAPIɈˑȂ߁AD3D12gȂłrhł.
+* ˑAnimation, Action܂߁AOS̋@\Platform.hoRĎĝŁAwindows.hKvȂ.
+*/
+#ifndef DX12TUTORIAL_SRC_SPRITECORE_H_
+#define DX12TUTORIAL_SRC_SPRITECORE_H_
+#include "SpriteTypes.h"
+#include "CommandStream.h"
+#include "CellMesh.h"
+#include "Animation.h"
+#include "Action.h"
+#include <DirectXMath.h>
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+namespace Sprite {
+
+/**
+* XvCg.
+*/
+struct Sprite
+{
+	Sprite() = delete;
+	Sprite(DirectX::XMFLOAT3 p, float rot = 0, DirectX::XMFLOAT2 s = DirectX::XMFLOAT2(1, 1), DirectX::XMFLOAT4 col = DirectX::XMFLOAT4(1, 1, 1, 1));
+	Sprite(const AnimationList& al, DirectX::XMFLOAT3 p, float rot = 0, DirectX::XMFLOAT2 s = DirectX::XMFLOAT2(1, 1), DirectX::XMFLOAT4 col = DirectX::XMFLOAT4(1, 1, 1, 1));
+	void SetSeqIndex(uint32_t no) { animeController.SetSeqIndex(no); }
+	void SetActionList(const Action::List* al) { actController.SetList(al); }
+	void SetAction(uint32_t no) { actController.SetSeqIndex(no); }
+	void SetCollisionId(int32_t id) { collisionId = id; }
+	void SetPaletteIndex(uint32_t no) { paletteIndex = no; }
+	int32_t GetCollisionId() const { return collisionId; }
+	void Update(double delta) {
+		animeController.Update(delta);
+		actController.Update(static_cast<float>(delta), this);
+	}
+	uint32_t GetCellIndex() const { return animeController.GetData().cellIndex; }
+	size_t GetSeqCount() const { return animeController.GetSeqCount(); }
+
+	AnimationController animeController;
+	Action::Controller actController;
+	Action::B::Controller actControllerB;
+	int32_t hp;
+	int32_t collisionId;
+	DirectX::XMFLOAT3 pos; ///< XN[W̃XvCg̈ʒu.
+	float rotation; ///< 摜̉]p(WA).
+	DirectX::XMFLOAT2 scale; ///< 摜̊g嗦.
+	DirectX::XMFLOAT4 color; ///< 摜̐F.
+	uint32_t paletteIndex; ///< pbgteNX`Ŏgppbg̔ԍ. ȊÕeNX`ł0ɂĂ.
+};
+
+void AddVertex(const Sprite& sprite, const Cell* cell, const AnimationData& anm, Vertex* v, DirectX::XMFLOAT2 offset);
+void AddVertex(const Sprite& sprite, const Cell* cell, const CellMesh& mesh, const AnimationData& anm, Vertex* v, DirectX::XMFLOAT2 offset);
+void AddVertex(const Sprite& sprite, const QuadTemplate& quad, const AnimationData& anm, Vertex* v, DirectX::XMFLOAT2 offset);
+
+/**
+* Zf[^̔z.
+*/
+struct CellList
+{
+	std::string name; ///< Xg.
+	std::vector<Cell> list; ///< Zf[^̔z.
+	std::vector<CellMesh> meshList; ///< ؂l߂Ž`. ̏ꍇ͋`ŕ`悷.
+	std::vector<QuadTemplate> quadList; ///< ZƂ̎lp`̐`. BuildQuadTemplate()ō쐬.
+};
+
+void BuildQuadTemplate(CellList& cellList);
+
+//#define SPRITE_ENABLE_ADDVERTEX_BENCHMARK
+#ifdef SPRITE_ENABLE_ADDVERTEX_BENCHMARK
+void BenchmarkAddVertex(size_t spriteCount, int repeat, double& cellTime, double& templateTime);
+#endif // SPRITE_ENABLE_ADDVERTEX_BENCHMARK
+
+/**
+* XvCg`NX̃C^[tFCX.
+*
+* Renderer(D3D12)SoftwareRenderer(CPU)̗.
+* CommandStreamɋL^`éAǂ̕`NXɂ菇œnƂł.
+* `̊Jn@͕`ɂĈقȂ邽߁ABegin()͊eNXŒ`.
+*/
+class RendererBase
+{
+public:
+	RendererBase() = default;
+	RendererBase(const RendererBase&) = delete;
+	RendererBase& operator=(const RendererBase&) = delete;
+	virtual ~RendererBase() {}
+
+	virtual bool Submit(const CommandStream& stream) = 0;
+	virtual bool End() = 0;
+};
+
+} // namespace Sprite
+
+#endif // DX12TUTORIAL_SRC_SPRITECORE_H_
@@ -0,0 +1,99 @@
+/**
+* @file SpriteTypes.h
+*
+* XvCg`Ɏgf[^^̂AOtBbNXAPIɈˑȂ.
+*/
+#ifndef DX12TUTORIAL_SRC_SPRITETYPES_H_
+#define DX12TUTORIAL_SRC_SPRITETYPES_H_
+#include <DirectXMath.h>
+#include <vector>
+#include <memory>
+#include <stdint.h>
+
+namespace Sprite {
+
+/**
+* XvCg`p_f[^^.
+*/
+struct Vertex {
+	DirectX::XMFLOAT3 position;
+	DirectX::XMFLOAT4 color;
+	DirectX::XMFLOAT2 texcoord;
+};
+
+/**
+* pbgԍeNX`WXɖߍ.
+*
+* CfbNXeNX`̃eNX`W0`1͈̔͂Ȃ̂ŁA͎gĂȂ.
+* Ƀpbgԍ2{ZAPaletteSpriteVS.hlslfloor(u / 2)ƂĎo.
+* 2{ɂ̂́AE[̒_u=1.0̃pbgԍƋʂłȂȂ̂h.
+* pbgԍ0Ȃu͕ωȂ̂ŁAʏ̃XvCgɂ͉eȂ.
+*
+* @param u            eNX`WX.
+* @param paletteIndex pbgԍ.
+*
+* @return pbgԍ𖄂ߍ񂾃eNX`WX.
+*/
+inline float EncodePaletteTexcoord(float u, uint32_t paletteIndex)
+{
+	return u + static_cast<float>(paletteIndex * 2);
+}
+
+/**
+* Zf[^^.
+*/
+struct Cell {
+	DirectX::XMFLOAT2 uv; ///< eNX`̍W.
+	DirectX::XMFLOAT2 tsize; ///< eNX`̏cTCY.
+	DirectX::XMFLOAT2 ssize; ///< XN[W̏cTCY.
+};
+
+/**
+* Z玖OɌvZlp`̐`.
+*
+* _̕тAddVertex()ƓŁAAEAEȀ.
+*/
+struct QuadTemplate {
+	DirectX::XMFLOAT2 offset[4]; ///< g嗦1A]0̂Ƃ́ASe_ւ̑΍W.
+	DirectX::XMFLOAT2 texcoord[4]; ///< e_̃eNX`W.
+};
+
+/**
+* CPUňRGBA8`̉摜.
+*
+* 1sNZ32rbgŁAʃoCgR, G, B, ȀɊi[.
+*/
+struct Image
+{
+	uint32_t width;
+	uint32_t height;
+	std::vector<uint32_t> data;
+};
+
+/**
+* CPUň8rbgCfbNX`̉摜.
+*
+* 1sNZ8rbgŁApbg̃CfbNX\.
+*/
+struct IndexedImage
+{
+	uint32_t width;
+	uint32_t height;
+	std::vector<uint8_t> data;
+};
+
+/**
+* pbg.
+*
+* ő256FŁAeFImageƓRGBA8`.
+*/
+typedef std::vector<uint32_t> Palette;
+
+/**
+* ohID.
+*/
+typedef std::shared_ptr<size_t> BundleId;
+
+} // namespace Sprite
+
+#endif // DX12TUTORIAL_SRC_SPRITETYPES_H_
@@ -0,0 +1,213 @@
+/**
+* @file Text.cpp
+*/
+#include "Text.h"
+#include <algorithm>
+#include <string.h>
+
+using namespace DirectX;
+
+namespace Sprite {
+
+namespace /* unnamed */ {
+
+/**
+* ɑΉZ擾.
+*
+* @param cellList tHg̃ZXg.
+* @param c        .
+*
+* @return cɑΉZ.
+*/
+const Cell& GetGlyphCell(const CellList& cellList, char c)
+{
+	const size_t index = static_cast<unsigned char>(c);
+	return cellList.list[index < cellList.list.size() ? index : 0];
+}
+
+} // unnamed namespace
+
+/**
+* RXgN^.
+*/
+GlyphRun::GlyphRun() :
+	font(nullptr),
+	offset(0, 0),
+	pos(0, 0, 0),
+	color(1, 1, 1, 1),
+	gradient(1, 1, 1, 1),
+	scale(1, 1),
+	spacing(0)
+{
+}
+
+/**
+* .
+*
+* @param cellList   tHg̃ZXg.
+* @param screenSize XN[̕ƍ.
+*/
+void GlyphRun::Init(const CellList* cellList, const XMFLOAT2& screenSize)
+{
+	font = cellList;
+	offset = XMFLOAT2(-screenSize.x * 0.5f, screenSize.y * 0.5f);
+	Layout(0);
+}
+
+/**
+* \ʒuݒ肷.
+*
+* @param p 擪̒̕SW.
+*/
+void GlyphRun::SetPosition(const XMFLOAT3& p)
+{
+	pos = p;
+	Layout(0);
+}
+
+/**
+* \Fݒ肷.
+*
+* @param c 擪̐̕F.
+* @param g 1ƂɐFɊ|l. ƂɐFωꍇɎw肷.
+*/
+void GlyphRun::SetColor(const XMFLOAT4& c, const XMFLOAT4& g)
+{
+	color = c;
+	gradient = g;
+	Layout(0);
+}
+
+/**
+* ̊g嗦ݒ肷.
+*
+* @param s g嗦.
+*/
+void GlyphRun::SetScale(const XMFLOAT2& s)
+{
+	scale = s;
+	Layout(0);
+}
+
+/**
+* ƕ̊Ԋuݒ肷.
+*
+* @param s ̊Ԋu(sNZ).
+*/
+void GlyphRun::SetSpacing(float s)
+{
+	spacing = s;
+	Layout(0);
+}
+
+/**
+* \镶ݒ肷.
+*
+* OƓȂ牽Ȃ.
+* قȂꍇ́AŏɈقȂ镶̒_f[^蒼.
+*
+* @param str \镶.
+*/
+void GlyphRun::SetText(const char* str)
+{
+	const size_t length = strlen(str);
+	const size_t common = std::min(length, text.size());
+	size_t first = 0;
+	while (first < common && text[first] == str[first]) {
+		++first;
+	}
+	if (first == length && length == text.size()) {
+		return;
+	}
+	text.assign(str, length);
+	Layout(first);
+}
+
+/**
+* l0߂Ƃĕ\.
+*
+* Ɏ܂Ȃꍇ͉ʂ̌\.
+*
+* @param value  \鐔l.
+* @param digits \錅(1`10).
+*/
+void GlyphRun::SetNumber(uint32_t value, int digits)
+{
+	char buf[11];
+	digits = std::max(1, std::min(10, digits));
+	for (int i = digits - 1; i >= 0; --i) {
+		buf[i] = static_cast<char>('0' + (value % 10));
+		value /= 10;
+	}
+	buf[digits] = '\0';
+	SetText(buf);
+}
+
+/**
+* `悷.
+*
+* @param renderer `Ɏgp郌_[.
+* @param bundleId `ɎgpohID.
+* @param info     `.
+*
+* @retval true  R}hXg쐬.
+* @retval false R}hXg쐬s.
+*/
+bool GlyphRun::Draw(Renderer& renderer, const BundleId& bundleId, RenderingInfo& info) const
+{
+	if (vertices.empty()) {
+		return true;
+	}
+	return renderer.Draw(vertices.data(), vertices.data() + vertices.size(), bundleId, info);
+}
+
+/**
+* _f[^쐬.
+*
+* @param first 쐬Jn镶̃CfbNX. O̒̕_f[^͕ύXȂ.
+*/
+void GlyphRun::Layout(size_t first)
+{
+	if (!font || font->list.empty()) {
+		glyphX.clear();
+		vertices.clear();
+		return;
+	}
+	glyphX.resize(text.size());
+	vertices.resize(text.size() * 4);
+
+	const XMVECTOR vgradient = XMLoadFloat4(&gradient);
+	XMVECTOR vcolor = XMLoadFloat4(&color);
+	if (first > 0) {
+		vcolor = XMVectorMultiply(XMLoadFloat4(&vertices[(first - 1) * 4].color), vgradient);
+	}
+	for (size_t i = first; i < text.size(); ++i) {
+		const Cell& cell = GetGlyphCell(*font, text[i]);
+		const XMFLOAT2 halfSize(cell.ssize.x * 0.5f * scale.x, cell.ssize.y * 0.5f * scale.y);
+		if (i == 0) {
+			glyphX[i] = pos.x;
+		} else {
+			const Cell& prev = GetGlyphCell(*font, text[i - 1]);
+			glyphX[i] = glyphX[i - 1] + prev.ssize.x * 0.5f * scale.x + spacing + halfSize.x;
+		}
+		const float cx = offset.x + glyphX[i];
+		const float cy = offset.y - pos.y;
+
+		Vertex* v = &vertices[i * 4];
+		for (int n = 0; n < 4; ++n) {
+			XMStoreFloat4(&v[n].color, vcolor);
+		}
+		v[0].position = XMFLOAT3(cx - halfSize.x, cy + halfSize.y, pos.z);
+		v[0].texcoord = XMFLOAT2(cell.uv.x, cell.uv.y);
+		v[1].position = XMFLOAT3(cx + halfSize.x, cy + halfSize.y, pos.z);
+		v[1].texcoord = XMFLOAT2(cell.uv.x + cell.tsize.x, cell.uv.y);
+		v[2].position = XMFLOAT3(cx + halfSize.x, cy - halfSize.y, pos.z);
+		v[2].texcoord = XMFLOAT2(cell.uv.x + cell.tsize.x, cell.uv.y + cell.tsize.y);
+		v[3].position = XMFLOAT3(cx - halfSize.x, cy - halfSize.y, pos.z);
+		v[3].texcoord = XMFLOAT2(cell.uv.x, cell.uv.y + cell.tsize.y);
+
+		vcolor = XMVectorMultiply(vcolor, vgradient);
+	}
+}
+
+} // namespace Sprite
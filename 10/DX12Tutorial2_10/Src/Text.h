@@ -0,0 +1,57 @@
+/**
+* @file Text.h
+*/
+#ifndef DX12TUTORIAL_SRC_TEXT_H_
+#define DX12TUTORIAL_SRC_TEXT_H_
+#include "Sprite.h"
+#include <DirectXMath.h>
+#include <vector>
+#include <string>
+
+namespace Sprite {
+
+/**
+* 1s̕A܂Ƃ܂_f[^ƂĕێNX.
+*
+* ƂɃXvCgpӂɁAŜ̒_f[^1x쐬ăLbV.
+* _f[^蒼͕̂\ݒ肪ςƂŁA񂪕ςꍇ
+* ŏɈقȂ镶낾蒼.
+* `Renderer::Draw()ɒ_f[^̂܂ܓn̂ŁA1s1̕`ɂ܂Ƃ܂.
+*
+* R[ĥ܂܃ZXg̃CfbNXɂȂ.
+* ZXg͈̔͊O̓̕CfbNX0̃Zŕ\.
+*/
+class GlyphRun
+{
+public:
+	GlyphRun();
+	~GlyphRun() = default;
+
+	void Init(const CellList* cellList, const DirectX::XMFLOAT2& screenSize);
+	void SetPosition(const DirectX::XMFLOAT3& p);
+	void SetColor(const DirectX::XMFLOAT4& c, const DirectX::XMFLOAT4& g = DirectX::XMFLOAT4(1, 1, 1, 1));
+	void SetScale(const DirectX::XMFLOAT2& s);
+	void SetSpacing(float s);
+	void SetText(const char* str);
+	void SetNumber(uint32_t value, int digits);
+	const std::string& GetText() const { return text; }
+	bool Draw(Renderer& renderer, const BundleId& bundleId, RenderingInfo& info) const;
+
+private:
+	void Layout(size_t first);
+
+	const CellList* font;
+	DirectX::XMFLOAT2 offset; ///< XN[W.
+	DirectX::XMFLOAT3 pos; ///< 擪̒̕SW.
+	DirectX::XMFLOAT4 color; ///< 擪̐̕F.
+	DirectX::XMFLOAT4 gradient; ///< 1ƂɐFɊ|l.
+	DirectX::XMFLOAT2 scale; ///< ̊g嗦.
+	float spacing; ///< ƕ̊Ԋu.
+	std::string text;
+	std::vector<float> glyphX; ///< e̒SXW.
+	std::vector<Vertex> vertices;
+};
+
+} // namespace Sprite
+
+#endif // DX12TUTORIAL_SRC_TEXT_H_
@@ -2,7 +2,10 @@
 * @file Texture.cpp
 */
 #include "Texture.h"
+#include "Sprite.h"
+#include "Palette.h"
 #include "d3dx12.h"
+#include <algorithm>
 
 namespace Resource
 {
@@ -321,6 +324,196 @@ bool ResourceLoader::LoadFromFile(Texture& texture, int index, const wchar_t* fi
 	return true;
 }
 
+/**
+* CPỦ摜eNX`쐬.
+*
+* @param texture  쐬eNX`ǗIuWFNg.
+* @param index    쐬eNX`pRTVfXNv^̃CfbNX.
+* @param image    eNX`쐬Ɏgp摜.
+* @param name     eNX`\[Xɕt閼O(fobOp). nullptrnƖOtȂ.
+*
+* @retval true  쐬.
+* @retval false 쐬s.
+*/
+bool ResourceLoader::Create(Texture& texture, int index, const Sprite::Image& image, const wchar_t* name)
+{
+	if (image.data.empty()) {
+		return false;
+	}
+	const D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_R8G8B8A8_UNORM, image.width, image.height, 1, 1);
+	return Create(texture, index, desc, image.data.data(), name);
+}
+
+/**
+* t@C摜ǂݍ݁ACPỦ摜ƂĎ擾.
+*
+* eNX`AgX̍쐬ȂǁAGPUɓ]Oɉ摜HꍇɎg.
+* 摜͌̌`Ɋւ炸RGBA8`ɕϊ.
+*
+* @param image    ǂݍ񂾉摜i[IuWFNg.
+* @param filename 摜t@C.
+*
+* @retval true  ǂݍݐ.
+* @retval false ǂݍݎs.
+*/
+bool ResourceLoader::LoadFromFile(Sprite::Image& image, const wchar_t* filename)
+{
+	ComPtr<IWICBitmapDecoder> decoder;
+	if (FAILED(imagingFactory->CreateDecoderFromFilename(filename, nullptr, GENERIC_READ, WICDecodeMetadataCacheOnLoad, decoder.GetAddressOf()))) {
+		return false;
+	}
+	ComPtr<IWICBitmapFrameDecode> frame;
+	if (FAILED(decoder->GetFrame(0, frame.GetAddressOf()))) {
+		return false;
+	}
+	WICPixelFormatGUID wicFormat;
+	if (FAILED(frame->GetPixelFormat(&wicFormat))) {
+		return false;
+	}
+	UINT width, height;
+	if (FAILED(frame->GetSize(&width, &height))) {
+		return false;
+	}
+	ComPtr<IWICFormatConverter> converter;
+	if (FAILED(imagingFactory->CreateFormatConverter(converter.GetAddressOf()))) {
+		return false;
+	}
+	BOOL canConvert = FALSE;
+	if (FAILED(converter->CanConvert(wicFormat, GUID_WICPixelFormat32bppRGBA, &canConvert))) {
+		return false;
+	}
+	if (!canConvert) {
+		return false;
+	}
+	if (FAILED(converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0, WICBitmapPaletteTypeCustom))) {
+		return false;
+	}
+	image.width = width;
+	image.height = height;
+	image.data.resize(width * height);
+	const UINT bytesPerRow = width * 4;
+	if (FAILED(converter->CopyPixels(nullptr, bytesPerRow, bytesPerRow * height, reinterpret_cast<BYTE*>(image.data.data())))) {
+		return false;
+	}
+	return true;
+}
+
+/**
+* CPŨCfbNX摜eNX`쐬.
+*
+* eNX`1sNZ8rbgDXGI_FORMAT_R8_UNORM`ɂȂ.
+* pbgtXvCgƂĕ`悷ꍇ́Apbg摜Ƒgō쐬
+* Create(Texture&, Texture&, int, const Sprite::IndexedImage&, const Sprite::Image&, const wchar_t*)g.
+*
+* @param texture  쐬eNX`ǗIuWFNg.
+* @param index    쐬eNX`pRTVfXNv^̃CfbNX.
+* @param image    eNX`쐬ɎgpCfbNX摜.
+* @param name     eNX`\[Xɕt閼O(fobOp). nullptrnƖOtȂ.
+*
+* @retval true  쐬.
+* @retval false 쐬s.
+*/
+bool ResourceLoader::Create(Texture& texture, int index, const Sprite::IndexedImage& image, const wchar_t* name)
+{
+	if (image.data.empty()) {
+		return false;
+	}
+	const D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_R8_UNORM, image.width, image.height, 1, 1);
+	return Create(texture, index, desc, image.data.data(), name);
+}
+
+/**
+* t@C摜ǂݍ݁ACPŨCfbNX摜ƂĎ擾.
+*
+* 8rbg̃pbgt摜͂̂܂ܓǂݍ.
+* ȊỎ摜RGBA8`œǂݍ񂾂ƁAQuantizeImage()256FɌF.
+*
+* @param image    ǂݍ񂾃CfbNX摜i[IuWFNg.
+* @param palette  ǂݍ񂾃pbgi[IuWFNg.
+* @param filename 摜t@C.
+*
+* @retval true  ǂݍݐ.
+* @retval false ǂݍݎs.
+*/
+bool ResourceLoader::LoadFromFile(Sprite::IndexedImage& image, std::vector<uint32_t>& palette, const wchar_t* filename)
+{
+	ComPtr<IWICBitmapDecoder> decoder;
+	if (FAILED(imagingFactory->CreateDecoderFromFilename(filename, nullptr, GENERIC_READ, WICDecodeMetadataCacheOnLoad, decoder.GetAddressOf()))) {
+		return false;
+	}
+	ComPtr<IWICBitmapFrameDecode> frame;
+	if (FAILED(decoder->GetFrame(0, frame.GetAddressOf()))) {
+		return false;
+	}
+	WICPixelFormatGUID wicFormat;
+	if (FAILED(frame->GetPixelFormat(&wicFormat))) {
+		return false;
+	}
+	if (wicFormat != GUID_WICPixelFormat8bppIndexed) {
+		Sprite::Image rgba;
+		if (!LoadFromFile(rgba, filename)) {
+			return false;
+		}
+		return Sprite::QuantizeImage(rgba, image, palette);
+	}
+
+	UINT width, height;
+	if (FAILED(frame->GetSize(&width, &height))) {
+		return false;
+	}
+	image.width = width;
+	image.height = height;
+	image.data.resize(width * height);
+	if (FAILED(frame->CopyPixels(nullptr, width, width * height, image.data.data()))) {
+		return false;
+	}
+
+	// WIC̐F0xAARRGGBB`Ȃ̂ŁARGBA8`ɕבւ.
+	ComPtr<IWICPalette> wicPalette;
+	if (FAILED(imagingFactory->CreatePalette(wicPalette.GetAddressOf()))) {
+		return false;
+	}
+	if (FAILED(frame->CopyPalette(wicPalette.Get()))) {
+		return false;
+	}
+	WICColor colors[256];
+	UINT colorCount = 0;
+	if (FAILED(wicPalette->GetColors(_countof(colors), colors, &colorCount))) {
+		return false;
+	}
+	palette.assign(256, 0);
+	for (UINT i = 0; i < colorCount; ++i) {
+		const uint32_t c = colors[i];
+		palette[i] = (c & 0xff00ff00) | ((c >> 16) & 0xff) | ((c & 0xff) << 16);
+	}
+	return true;
+}
+
+/**
+* CfbNX摜ƃpbg摜ApbgtXvCgp̃eNX`̑g쐬.
+*
+* PSOType_PaletteSpritẽfXNv^e[úACfbNXeNX`̎ɃpbgeNX`ł邱ƂOƂ.
+* ̂߁ACfbNXeNX`indexɁApbgeNX`index + 1ɍ쐬.
+* `掞texture.handlefXNv^e[u̐擪ƂĎg.
+*
+* @param texture        쐬CfbNXeNX`ǗIuWFNg.
+* @param paletteTexture 쐬pbgeNX`ǗIuWFNg.
+* @param index          CfbNXeNX`p̃fXNv^̃CfbNX. index + 1gp.
+* @param image          eNX`쐬ɎgpCfbNX摜.
+* @param palette        eNX`쐬Ɏgppbg摜. PackPalette()ō쐬.
+* @param name           eNX`\[Xɕt閼O(fobOp). nullptrnƖOtȂ.
+*
+* @retval true  쐬.
+* @retval false 쐬s.
+*/
+bool ResourceLoader::Create(Texture& texture, Texture& paletteTexture, int index, const Sprite::IndexedImage& image, const Sprite::Image& palette, const wchar_t* name)
+{
+	if (!Create(texture, index, image, name)) {
+		return false;
+	}
+	return Create(paletteTexture, index + 1, palette, name);
+}
+
 /**
 * .
 *
@@ -442,6 +635,64 @@ bool TextureMap::LoadFromFile(Texture& texture, const wchar_t* filename)
 	return false;
 }
 
+/**
+* t@C摜ǂݍ݁ACPŨCfbNX摜ƂĎ擾.
+*
+* ǂݍ񂾉摜́ApbgHĂCreate(Texture&, Texture&, const wchar_t*, ...)ŃeNX`ɂ.
+*
+* @param image    ǂݍ񂾃CfbNX摜i[IuWFNg.
+* @param palette  ǂݍ񂾃pbgi[IuWFNg.
+* @param filename 摜t@C.
+*
+* @retval true  ǂݍݐ.
+* @retval false ǂݍݎs.
+*/
+bool TextureMap::LoadFromFile(Sprite::IndexedImage& image, std::vector<uint32_t>& palette, const wchar_t* filename)
+{
+	return loader->LoadFromFile(image, palette, filename);
+}
+
+/**
+* pbgtXvCgp̃eNX`̑g쐬.
+*
+* CfbNXeNX`ƃpbgeNX`ɂ́AA2̃fXNv^蓖Ă.
+* pbgeNX`́Aname̖"#Palette"tOœo^.
+*
+* @param texture        쐬CfbNXeNX`ǗIuWFNg.
+* @param paletteTexture 쐬pbgeNX`ǗIuWFNg.
+* @param name           eNX`\[Xɕt閼O.
+* @param image          eNX`쐬ɎgpCfbNX摜.
+* @param palette        eNX`쐬Ɏgppbg摜.
+*
+* @retval true  쐬.
+* @retval false 쐬s.
+*/
+bool TextureMap::Create(Texture& texture, Texture& paletteTexture, const wchar_t* name, const Sprite::IndexedImage& image, const Sprite::Image& palette)
+{
+	const std::wstring paletteName = std::wstring(name) + L"#Palette";
+	if (Find(texture, name) && Find(paletteTexture, paletteName.c_str())) {
+		return true;
+	}
+
+	// A2̋IDT.
+	// freeIDList͖ôŁA~ɕׂĂΏIDg.
+	std::sort(freeIDList.begin(), freeIDList.end(), [](uint16_t lhs, uint16_t rhs) { return lhs > rhs; });
+	for (size_t i = freeIDList.size(); i >= 2; --i) {
+		const int index = freeIDList[i - 1];
+		if (freeIDList[i - 2] != index + 1) {
+			continue;
+		}
+		if (!loader->Create(texture, paletteTexture, index, image, palette, name)) {
+			return false;
+		}
+		freeIDList.erase(freeIDList.begin() + (i - 2), freeIDList.begin() + i);
+		map.insert(std::make_pair(name, texture));
+		map.insert(std::make_pair(paletteName, paletteTexture));
+		return true;
+	}
+	return false;
+}
+
 /**
 * QƂȂȂeNX`j.
 */
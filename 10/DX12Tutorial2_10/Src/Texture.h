@@ -12,6 +12,11 @@
 #include <map>
 #include <memory>
 
+namespace Sprite {
+struct Image;
+struct IndexedImage;
+}
+
 /**
 * \[XǗpO.
 */
@@ -49,6 +54,11 @@ public:
 	bool Upload(Microsoft::WRL::ComPtr<ID3D12Resource>& defaultHeap, const D3D12_RESOURCE_DESC& desc, D3D12_SUBRESOURCE_DATA data, D3D12_RESOURCE_STATES stateAfter, const wchar_t* name = nullptr);
 	bool Create(Texture& texture, int index, const D3D12_RESOURCE_DESC& desc, const void* data, const wchar_t* name = nullptr);
 	bool LoadFromFile(Texture& texture, int index, const wchar_t* filename);
+	bool Create(Texture& texture, int index, const Sprite::Image& image, const wchar_t* name = nullptr);
+	bool LoadFromFile(Sprite::Image& image, const wchar_t* filename);
+	bool Create(Texture& texture, int index, const Sprite::IndexedImage& image, const wchar_t* name = nullptr);
+	bool LoadFromFile(Sprite::IndexedImage& image, std::vector<uint32_t>& palette, const wchar_t* filename);
+	bool Create(Texture& texture, Texture& paletteTexture, int index, const Sprite::IndexedImage& image, const Sprite::Image& palette, const wchar_t* name = nullptr);
 
 private:
 	Microsoft::WRL::ComPtr<ID3D12Device> device;
@@ -80,6 +90,8 @@ public:
 	ID3D12GraphicsCommandList* End();
 	bool Create(Texture& texture, const wchar_t* name, const D3D12_RESOURCE_DESC& desc, const void* data);
 	bool LoadFromFile(Texture& texture, const wchar_t* filename);
+	bool LoadFromFile(Sprite::IndexedImage& image, std::vector<uint32_t>& palette, const wchar_t* filename);
+	bool Create(Texture& texture, Texture& paletteTexture, const wchar_t* name, const Sprite::IndexedImage& image, const Sprite::Image& palette);
 	void ResetLoader() { loader.reset(); }
 	bool Find(Texture& texture, const wchar_t* filename);
 	void GC();
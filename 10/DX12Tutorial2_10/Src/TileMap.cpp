@@ -0,0 +1,366 @@
+/**
+* @file TileMap.cpp
+*/
+#include "TileMap.h"
+#include <algorithm>
+#include <math.h>
+
+using namespace DirectX;
+
+namespace Sprite {
+
+namespace /* unnamed */ {
+
+/**
+* `N͈̔.
+*/
+struct ChunkRange
+{
+	int32_t x0, y0; ///< ̃`NW.
+	int32_t x1, y1; ///< Ẽ`NW(̒l܂).
+
+	bool Contains(int32_t x, int32_t y) const { return x >= x0 && x <= x1 && y >= y0 && y <= y1; }
+};
+
+/**
+* ʂɉf`N͈̔͂߂.
+*
+* @param scroll      ʍɕ\}bv̍W.
+* @param screenSize  XN[̕ƍ.
+* @param chunkPixel  `N1̕ƍ(sNZ).
+* @param chunkCountX ̃`N.
+* @param chunkCountY c̃`N.
+* @param margin      ͈͂L`N.
+*
+* @return ʂɉf`N͈̔. 1fȂꍇx0 > x1܂y0 > y1ɂȂ.
+*/
+ChunkRange CalcVisibleRange(const XMFLOAT2& scroll, const XMFLOAT2& screenSize, const XMFLOAT2& chunkPixel, uint32_t chunkCountX, uint32_t chunkCountY, int32_t margin)
+{
+	ChunkRange r;
+	r.x0 = static_cast<int32_t>(floor(scroll.x / chunkPixel.x)) - margin;
+	r.y0 = static_cast<int32_t>(floor(scroll.y / chunkPixel.y)) - margin;
+	r.x1 = static_cast<int32_t>(floor((scroll.x + screenSize.x) / chunkPixel.x)) + margin;
+	r.y1 = static_cast<int32_t>(floor((scroll.y + screenSize.y) / chunkPixel.y)) + margin;
+	r.x0 = std::max(r.x0, 0);
+	r.y0 = std::max(r.y0, 0);
+	r.x1 = std::min(r.x1, static_cast<int32_t>(chunkCountX) - 1);
+	r.y1 = std::min(r.y1, static_cast<int32_t>(chunkCountY) - 1);
+	return r;
+}
+
+} // unnamed namespace
+
+/**
+* RXgN^.
+*/
+TileMap::TileMap() :
+	tileset(nullptr),
+	tileSize(32, 32),
+	screenSize(0, 0),
+	scroll(0, 0),
+	depth(0.5f),
+	chunkSize(16),
+	mapWidth(0),
+	mapHeight(0),
+	chunkCountX(0),
+	chunkCountY(0),
+	buildCount(0)
+{
+}
+
+/**
+* .
+*
+* 쐬ς݂̒_f[^͑SĔj.
+*
+* @param tileset    ^C̉摜\ZXg. ^C̒lZ̃CfbNXɂȂ.
+* @param ts         ^C1̕\TCY(sNZ).
+* @param ss         XN[̕ƍ.
+* @param chunkTiles `N1ӂ̃^C.
+*/
+void TileMap::Init(const CellList* tileset, const XMFLOAT2& ts, const XMFLOAT2& ss, uint32_t chunkTiles)
+{
+	this->tileset = tileset;
+	tileSize = ts;
+	screenSize = ss;
+	chunkSize = std::max(1u, chunkTiles);
+	Load(0, 0, std::vector<uint32_t>());
+}
+
+/**
+* }bvf[^ݒ肷.
+*
+* 쐬ς݂̒_f[^͑SĔjAUpdate()ŉʂɉf`N쐬.
+*
+* @param width  ̃^C.
+* @param height c̃^C.
+* @param tiles  ^C̔z. ォEցAォ牺̏ɕׂ. vfwidth * heightȏł邱.
+*
+* @retval true  ݒ萬.
+* @retval false tiles̗vfȂ.
+*/
+bool TileMap::Load(uint32_t width, uint32_t height, const std::vector<uint32_t>& tiles)
+{
+	if (tiles.size() < static_cast<size_t>(width) * height) {
+		return false;
+	}
+	// EvictChunk()͌Â}bṽ`NԍchunkToSlotXV̂ŁAe[u蒼OɑSĔj.
+	while (!residentList.empty()) {
+		EvictChunk(residentList.back());
+	}
+	mapWidth = width;
+	mapHeight = height;
+	tileList.assign(tiles.begin(), tiles.begin() + static_cast<size_t>(width) * height);
+	chunkCountX = (width + chunkSize - 1) / chunkSize;
+	chunkCountY = (height + chunkSize - 1) / chunkSize;
+	chunkToSlot.assign(static_cast<size_t>(chunkCountX) * chunkCountY, -1);
+	return true;
+}
+
+/**
+* ^CύX.
+*
+* ^C܂ރ`N̒_f[^͔jAUpdate()ō蒼.
+*
+* @param x         ^CXW.
+* @param y         ^CYW.
+* @param cellIndex ^Cɕ\Z̃CfbNX. emptyTileȂ牽\Ȃ.
+*/
+void TileMap::SetTile(uint32_t x, uint32_t y, uint32_t cellIndex)
+{
+	if (x >= mapWidth || y >= mapHeight) {
+		return;
+	}
+	tileList[y * mapWidth + x] = cellIndex;
+	const int32_t slot = chunkToSlot[(y / chunkSize) * chunkCountX + (x / chunkSize)];
+	if (slot >= 0) {
+		EvictChunk(slot);
+	}
+}
+
+/**
+* ^C擾.
+*
+* @param x ^CXW.
+* @param y ^CYW.
+*
+* @return (x, y)ɕ\Z̃CfbNX. ͈͊ȌꍇemptyTile.
+*/
+uint32_t TileMap::GetTile(uint32_t x, uint32_t y) const
+{
+	if (x >= mapWidth || y >= mapHeight) {
+		return emptyTile;
+	}
+	return tileList[y * mapWidth + x];
+}
+
+/**
+* \鉜sݒ肷.
+*
+* 쐬ς݂̒_f[^͑SĔj.
+*
+* @param z s.
+*/
+void TileMap::SetDepth(float z)
+{
+	depth = z;
+	while (!residentList.empty()) {
+		EvictChunk(residentList.back());
+	}
+}
+
+/**
+* _f[^XV.
+*
+* ʊOɏo`N̒_f[^jAʓɓ`N̒_f[^쐬.
+* XN[ׂ̌ςƂɍ쐬ƔjJԂȂ悤A
+* ʂ1`Nȏ㗣܂ł͔jȂ.
+*/
+void TileMap::Update()
+{
+	if (!tileset || chunkToSlot.empty()) {
+		return;
+	}
+	const XMFLOAT2 chunkPixel(tileSize.x * chunkSize, tileSize.y * chunkSize);
+	const ChunkRange keepRange = CalcVisibleRange(scroll, screenSize, chunkPixel, chunkCountX, chunkCountY, 1);
+	for (size_t i = 0; i < residentList.size();) {
+		const uint32_t id = slotList[residentList[i]].id;
+		if (keepRange.Contains(id % chunkCountX, id / chunkCountX)) {
+			++i;
+		} else {
+			EvictChunk(residentList[i]);
+		}
+	}
+
+	const ChunkRange viewRange = CalcVisibleRange(scroll, screenSize, chunkPixel, chunkCountX, chunkCountY, 0);
+	for (int32_t cy = viewRange.y0; cy <= viewRange.y1; ++cy) {
+		for (int32_t cx = viewRange.x0; cx <= viewRange.x1; ++cx) {
+			const uint32_t id = cy * chunkCountX + cx;
+			if (chunkToSlot[id] >= 0) {
+				continue;
+			}
+			size_t slot;
+			if (!freeSlotList.empty()) {
+				slot = freeSlotList.back();
+				freeSlotList.pop_back();
+			} else {
+				slot = slotList.size();
+				slotList.push_back(Chunk());
+			}
+			slotList[slot].id = id;
+			BuildChunk(slotList[slot]);
+			chunkToSlot[id] = static_cast<int32_t>(slot);
+			residentList.push_back(slot);
+			++buildCount;
+		}
+	}
+}
+
+/**
+* ^C}bv`悷.
+*
+* ʂɉf`NƂɁA쐬ς݂̒_f[^`悷.
+* _f[^̍쐬Update()ōs߁AUpdate()ĂԑOɕ`悷ƁAVf`N͕\Ȃ.
+*
+* @param renderer `Ɏgp郌_[.
+* @param bundleId `ɎgpohID.
+* @param info     `.
+*
+* @retval true  R}hXg쐬.
+* @retval false R}hXg쐬s.
+*/
+bool TileMap::Draw(Renderer& renderer, const BundleId& bundleId, RenderingInfo& info) const
+{
+	if (residentList.empty()) {
+		return true;
+	}
+
+	RenderingInfo tileInfo = info;
+	tileInfo.matViewProjection = GetMapMatrix(info.matViewProjection);
+
+	const XMFLOAT2 chunkPixel(tileSize.x * chunkSize, tileSize.y * chunkSize);
+	const ChunkRange viewRange = CalcVisibleRange(scroll, screenSize, chunkPixel, chunkCountX, chunkCountY, 0);
+	for (size_t slot : residentList) {
+		const Chunk& chunk = slotList[slot];
+		if (chunk.vertices.empty() || !viewRange.Contains(chunk.id % chunkCountX, chunk.id / chunkCountX)) {
+			continue;
+		}
+		const Vertex* first = chunk.vertices.data();
+		if (!renderer.Draw(first, first + chunk.vertices.size(), bundleId, tileInfo)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+* ^C}bvR}hXg[ɋL^.
+*
+* `Ɏgoh́AĂяoł炩stream.BindBundle()Őݒ肵Ă.
+* L^̓XN[܂߂`Xe[gɐ؂ւAL^state֖߂.
+*
+* @param stream L^̃R}hXg[.
+* @param state  ^C}bvȊO̕`Ɏg`Xe[g.
+*
+* @retval true  L^.
+* @retval false L^s.
+*/
+bool TileMap::Draw(CommandStream& stream, const StreamState& state) const
+{
+	if (residentList.empty()) {
+		return true;
+	}
+
+	StreamState tileState = state;
+	tileState.matViewProjection = GetMapMatrix(state.matViewProjection);
+	stream.SetState(tileState);
+
+	const XMFLOAT2 chunkPixel(tileSize.x * chunkSize, tileSize.y * chunkSize);
+	const ChunkRange viewRange = CalcVisibleRange(scroll, screenSize, chunkPixel, chunkCountX, chunkCountY, 0);
+	bool result = true;
+	for (size_t slot : residentList) {
+		const Chunk& chunk = slotList[slot];
+		if (chunk.vertices.empty() || !viewRange.Contains(chunk.id % chunkCountX, chunk.id / chunkCountX)) {
+			continue;
+		}
+		const Vertex* first = chunk.vertices.data();
+		if (!stream.Draw(first, first + chunk.vertices.size())) {
+			result = false;
+			break;
+		}
+	}
+	stream.SetState(state);
+	return result;
+}
+
+/**
+* }bv̍WXN[ɉf߂̍Wϊs擾.
+*
+* _f[^̓}bv̍W(Y͏)Ȃ̂ŁAXN[ƃXN[Wւ̕ϊsɊ܂߂.
+* VF[_͍s]uĈ߁Asړs]uĂEɊ|.
+*
+* @param matViewProjection XN[Wp̍Wϊs.
+*
+* @return }bv̍Wp̍Wϊs.
+*/
+XMFLOAT4X4 TileMap::GetMapMatrix(const XMFLOAT4X4& matViewProjection) const
+{
+	const XMMATRIX matTranslation = XMMatrixTranslation(-screenSize.x * 0.5f - scroll.x, screenSize.y * 0.5f + scroll.y, 0);
+	XMFLOAT4X4 m;
+	XMStoreFloat4x4(&m, XMMatrixMultiply(XMLoadFloat4x4(&matViewProjection), XMMatrixTranspose(matTranslation)));
+	return m;
+}
+
+/**
+* `N̒_f[^쐬.
+*
+* @param chunk _f[^쐬`N.
+*/
+void TileMap::BuildChunk(Chunk& chunk) const
+{
+	chunk.vertices.clear();
+	const uint32_t tx0 = (chunk.id % chunkCountX) * chunkSize;
+	const uint32_t ty0 = (chunk.id / chunkCountX) * chunkSize;
+	const uint32_t tx1 = std::min(tx0 + chunkSize, mapWidth);
+	const uint32_t ty1 = std::min(ty0 + chunkSize, mapHeight);
+	const XMFLOAT4 color(1, 1, 1, 1);
+	for (uint32_t ty = ty0; ty < ty1; ++ty) {
+		const uint32_t* row = tileList.data() + ty * mapWidth;
+		for (uint32_t tx = tx0; tx < tx1; ++tx) {
+			const uint32_t cellIndex = row[tx];
+			if (cellIndex >= tileset->list.size()) {
+				continue;
+			}
+			const Cell& cell = tileset->list[cellIndex];
+			const float left = tx * tileSize.x;
+			const float right = left + tileSize.x;
+			const float top = -(ty * tileSize.y);
+			const float bottom = top - tileSize.y;
+			const Vertex v[4] = {
+				{ XMFLOAT3(left, top, depth), color, XMFLOAT2(cell.uv.x, cell.uv.y) },
+				{ XMFLOAT3(right, top, depth), color, XMFLOAT2(cell.uv.x + cell.tsize.x, cell.uv.y) },
+				{ XMFLOAT3(right, bottom, depth), color, XMFLOAT2(cell.uv.x + cell.tsize.x, cell.uv.y + cell.tsize.y) },
+				{ XMFLOAT3(left, bottom, depth), color, XMFLOAT2(cell.uv.x, cell.uv.y + cell.tsize.y) },
+			};
+			chunk.vertices.insert(chunk.vertices.end(), v, v + 4);
+		}
+	}
+}
+
+/**
+* `N̒_f[^j.
+*
+* _f[^̗͉̈Aɍ쐬`Nōėp.
+*
+* @param slot j`ÑXbgԍ.
+*/
+void TileMap::EvictChunk(size_t slot)
+{
+	Chunk& chunk = slotList[slot];
+	chunkToSlot[chunk.id] = -1;
+	chunk.vertices.clear();
+	residentList.erase(std::find(residentList.begin(), residentList.end(), slot));
+	freeSlotList.push_back(slot);
+}
+
+} // namespace Sprite
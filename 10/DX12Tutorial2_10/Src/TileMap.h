@@ -0,0 +1,88 @@
+/**
+* @file TileMap.h
+*/
+#ifndef DX12TUTORIAL_SRC_TILEMAP_H_
+#define DX12TUTORIAL_SRC_TILEMAP_H_
+#include "Sprite.h"
+#include "CommandStream.h"
+#include <DirectXMath.h>
+#include <vector>
+#include <stdint.h>
+
+namespace Sprite {
+
+/**
+* `NPʂŒ_f[^쐬^C}bv.
+*
+* }bv̑傫̃`NɕAʓɓ`N̒_f[^쐬.
+* _f[^̓`NʓɓƂɏ߂č쐬AʊOɏoƔj.
+* j`N̒_f[^̗̈́Aɍ쐬`Nōėp.
+* ̂߁A1t[̏ʂ͉ʂɉf͈͂̍LŌ܂A}bv̒ɂ͈ˑȂ.
+*
+* _f[^̓}bv̍Wō쐬AXN[͕`掞ɍWϊsōs.
+* XN[邾Ȃ璸_f[^蒼Kv͂Ȃ.
+*
+* g:
+* -# Init()Ń^C̃ZXgA^C̑傫AXN[̑傫ݒ肷.
+* -# Load()Ń}bvf[^ݒ肷.
+* -# t[ASetScroll()ŕ\ʒuݒ肵ĂUpdate()Ă.
+* -# Draw()ŕ`悷. R}hXg[ɋL^ꍇ́Aohݒ肵ĂDraw(CommandStream&, const StreamState&)Ă.
+*/
+class TileMap
+{
+public:
+	static const uint32_t emptyTile = 0xffffffff; ///< \Ȃ^C.
+
+	TileMap();
+	~TileMap() = default;
+	TileMap(const TileMap&) = delete;
+	TileMap& operator=(const TileMap&) = delete;
+
+	void Init(const CellList* tileset, const DirectX::XMFLOAT2& tileSize, const DirectX::XMFLOAT2& screenSize, uint32_t chunkSize = 16);
+	bool Load(uint32_t width, uint32_t height, const std::vector<uint32_t>& tiles);
+	void SetTile(uint32_t x, uint32_t y, uint32_t cellIndex);
+	uint32_t GetTile(uint32_t x, uint32_t y) const;
+	void SetScroll(const DirectX::XMFLOAT2& s) { scroll = s; }
+	const DirectX::XMFLOAT2& GetScroll() const { return scroll; }
+	void SetDepth(float z);
+	void Update();
+	bool Draw(Renderer& renderer, const BundleId& bundleId, RenderingInfo& info) const;
+	bool Draw(CommandStream& stream, const StreamState& state) const;
+
+	size_t GetResidentChunkCount() const { return residentList.size(); }
+	size_t GetBuildCount() const { return buildCount; }
+
+private:
+	/// _f[^쐬`N.
+	struct Chunk {
+		uint32_t id; ///< `Nԍ(`NYW * ̃`N + XW).
+		std::vector<Vertex> vertices;
+	};
+
+	DirectX::XMFLOAT4X4 GetMapMatrix(const DirectX::XMFLOAT4X4& matViewProjection) const;
+	void BuildChunk(Chunk& chunk) const;
+	void EvictChunk(size_t slot);
+
+	const CellList* tileset;
+	DirectX::XMFLOAT2 tileSize; ///< ^C1̕\TCY(sNZ).
+	DirectX::XMFLOAT2 screenSize;
+	DirectX::XMFLOAT2 scroll; ///< ʍɕ\}bv̍W.
+	float depth;
+	uint32_t chunkSize; ///< `N1ӂ̃^C.
+
+	uint32_t mapWidth; ///< ̃^C.
+	uint32_t mapHeight; ///< c̃^C.
+	uint32_t chunkCountX; ///< ̃`N.
+	uint32_t chunkCountY; ///< c̃`N.
+	std::vector<uint32_t> tileList;
+
+	std::vector<int32_t> chunkToSlot; ///< `NԍXbgԍ\. _f[^Ȃ-1.
+	std::vector<Chunk> slotList;
+	std::vector<size_t> freeSlotList;
+	std::vector<size_t> residentList; ///< _f[^Xbg̔ԍ.
+	size_t buildCount; ///< ܂łɒ_f[^쐬`N̐.
+};
+
+} // namespace Sprite
+
+#endif // DX12TUTORIAL_SRC_TILEMAP_H_